@@ -0,0 +1,3 @@
+--
+DELETE FROM `command` WHERE `name` = 'debug objectpools';
+INSERT INTO `command` (`name`, `security`, `help`) VALUES ('debug objectpools', 3, 'Syntax: .debug objectpools\r\nShows the allocation counters and the fragmentation of the slab pools used for creatures, gameobjects, auras and spells.');
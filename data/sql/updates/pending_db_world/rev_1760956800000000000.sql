@@ -0,0 +1,2 @@
+--
+UPDATE `command` SET `help` = 'Syntax: .debug objectpools\r\nShows the allocation counters and the fragmentation of the slab pools used for creatures, gameobjects, auras and spells, and the allocation counters of the scratch arenas used for target lists.' WHERE `name` = 'debug objectpools';
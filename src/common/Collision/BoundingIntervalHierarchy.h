@@ -32,6 +32,7 @@
 #include <vector>
 
 #define MAX_STACK_SIZE 64
+#define RAY_PACKET_SIZE 8
 
 // https://stackoverflow.com/a/4328396
 
@@ -280,6 +281,20 @@ public:
         }
     }
 
+    /** Intersects a bundle of rays sharing the same origin with the tree.
+        Rays are processed in packets of RAY_PACKET_SIZE which walk the hierarchy together,
+        slab tests of a node are done for all rays of the packet in one pass.
+        The callback receives the index of the ray in dirs/maxDists in addition to the
+        arguments of the single ray callback. */
+    template<typename RayPacketCallback>
+    void intersectRays(const G3D::Vector3& org, const G3D::Vector3* dirs, float* maxDists, uint32 count, RayPacketCallback& intersectCallback, bool stopAtFirstHit) const
+    {
+        for (uint32 first = 0; first < count; first += RAY_PACKET_SIZE)
+        {
+            intersectRayPacket(org, dirs + first, maxDists + first, first, std::min<uint32>(count - first, RAY_PACKET_SIZE), intersectCallback, stopAtFirstHit);
+        }
+    }
+
     template<typename IsectCallback>
     void intersectPoint(const G3D::Vector3& p, IsectCallback& intersectCallback) const
     {
@@ -429,6 +444,246 @@ protected:
         tempTree[nodeIndex + 1] = right - left + 1;
     }
 
+    template<typename RayPacketCallback>
+    void intersectRayPacket(const G3D::Vector3& org, const G3D::Vector3* dirs, float* maxDists, uint32 rayOffset, uint32 count, RayPacketCallback& intersectCallback, bool stopAtFirstHit) const
+    {
+        G3D::Ray rays[RAY_PACKET_SIZE];
+        float invDir[3][RAY_PACKET_SIZE];
+        bool negDir[3][RAY_PACKET_SIZE];
+        float intervalMin[RAY_PACKET_SIZE];
+        float intervalMax[RAY_PACKET_SIZE];
+        uint32 mask = 0;
+
+        for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+        {
+            // unused lanes get an empty interval and never become active
+            intervalMin[i] = 0.f;
+            intervalMax[i] = -1.f;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                invDir[axis][i] = 0.f;
+                negDir[axis][i] = false;
+            }
+
+            if (i >= count)
+            {
+                continue;
+            }
+
+            G3D::Vector3 const& dir = dirs[i];
+            rays[i] = G3D::Ray::fromOriginAndDirection(org, dir);
+
+            // same clipping against the tree bounds as intersectRay
+            float tMin = -1.f;
+            float tMax = -1.f;
+            bool miss = false;
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                invDir[axis][i] = 1.f / dir[axis];
+                negDir[axis][i] = (floatToRawIntBits(dir[axis]) >> 31) != 0;
+                if (G3D::fuzzyNe(dir[axis], 0.0f))
+                {
+                    float t1 = (bounds.low()[axis]  - org[axis]) * invDir[axis][i];
+                    float t2 = (bounds.high()[axis] - org[axis]) * invDir[axis][i];
+                    if (t1 > t2)
+                    {
+                        std::swap(t1, t2);
+                    }
+                    if (t1 > tMin)
+                    {
+                        tMin = t1;
+                    }
+                    if (t2 < tMax || tMax < 0.f)
+                    {
+                        tMax = t2;
+                    }
+                    if (tMax <= 0 || tMin >= maxDists[i])
+                    {
+                        miss = true;
+                    }
+                }
+            }
+
+            if (miss || tMin > tMax)
+            {
+                continue;
+            }
+
+            intervalMin[i] = std::max(tMin, 0.f);
+            intervalMax[i] = std::min(tMax, maxDists[i]);
+            mask |= 1u << i;
+        }
+
+        if (!mask)
+        {
+            return;
+        }
+
+        struct PacketStackNode
+        {
+            uint32 node;
+            uint32 mask;
+            float tnear[RAY_PACKET_SIZE];
+            float tfar[RAY_PACKET_SIZE];
+        };
+
+        PacketStackNode stack[MAX_STACK_SIZE];
+        int stackPos = 0;
+        int node = 0;
+        uint32 finished = 0;
+
+        while (true)
+        {
+            while (true)
+            {
+                uint32 tn = tree[node];
+                uint32 axis = (tn & (3 << 30)) >> 30; // cppcheck-suppress integerOverflow
+                bool BVH2 = tn & (1 << 29); // cppcheck-suppress integerOverflow
+                int offset = tn & ~(7 << 29); // cppcheck-suppress integerOverflow
+                if (!BVH2)
+                {
+                    if (axis < 3)
+                    {
+                        // "normal" interior node, left child ends at the first plane and right child starts at the second one
+                        float planeLeft = intBitsToFloat(tree[node + 1]) - org[axis];
+                        float planeRight = intBitsToFloat(tree[node + 2]) - org[axis];
+                        float leftMin[RAY_PACKET_SIZE];
+                        float leftMax[RAY_PACKET_SIZE];
+                        float rightMin[RAY_PACKET_SIZE];
+                        float rightMax[RAY_PACKET_SIZE];
+                        uint32 leftMask = 0;
+                        uint32 rightMask = 0;
+                        for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+                        {
+                            float tl = planeLeft * invDir[axis][i];
+                            float tr = planeRight * invDir[axis][i];
+                            bool neg = negDir[axis][i];
+                            leftMin[i] = neg ? std::max(intervalMin[i], tl) : intervalMin[i];
+                            leftMax[i] = neg ? intervalMax[i] : std::min(intervalMax[i], tl);
+                            rightMin[i] = neg ? intervalMin[i] : std::max(intervalMin[i], tr);
+                            rightMax[i] = neg ? std::min(intervalMax[i], tr) : intervalMax[i];
+                            leftMask |= uint32(leftMin[i] <= leftMax[i]) << i;
+                            rightMask |= uint32(rightMin[i] <= rightMax[i]) << i;
+                        }
+                        leftMask &= mask;
+                        rightMask &= mask;
+
+                        // no ray passes through any child
+                        if (!leftMask && !rightMask)
+                        {
+                            break;
+                        }
+
+                        if (leftMask && rightMask)
+                        {
+                            // push back right node
+                            PacketStackNode& entry = stack[stackPos];
+                            entry.node = offset + 3;
+                            entry.mask = rightMask;
+                            std::copy(rightMin, rightMin + RAY_PACKET_SIZE, entry.tnear);
+                            std::copy(rightMax, rightMax + RAY_PACKET_SIZE, entry.tfar);
+                            stackPos++;
+                        }
+
+                        if (leftMask)
+                        {
+                            node = offset;
+                            mask = leftMask;
+                            std::copy(leftMin, leftMin + RAY_PACKET_SIZE, intervalMin);
+                            std::copy(leftMax, leftMax + RAY_PACKET_SIZE, intervalMax);
+                        }
+                        else
+                        {
+                            node = offset + 3;
+                            mask = rightMask;
+                            std::copy(rightMin, rightMin + RAY_PACKET_SIZE, intervalMin);
+                            std::copy(rightMax, rightMax + RAY_PACKET_SIZE, intervalMax);
+                        }
+                        continue;
+                    }
+                    else
+                    {
+                        // leaf - test some objects with every ray still passing through it
+                        int n = tree[node + 1];
+                        while (n > 0 && mask)
+                        {
+                            for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+                            {
+                                if (!(mask & (1u << i)))
+                                {
+                                    continue;
+                                }
+
+                                bool hit = intersectCallback(rayOffset + i, rays[i], objects[offset], maxDists[i], stopAtFirstHit);
+                                if (stopAtFirstHit && hit)
+                                {
+                                    mask &= ~(1u << i);
+                                    finished |= 1u << i;
+                                }
+                            }
+                            --n;
+                            ++offset;
+                        }
+                        break;
+                    }
+                }
+                else
+                {
+                    if (axis > 2)
+                    {
+                        return;    // should not happen
+                    }
+                    float planeLow = intBitsToFloat(tree[node + 1]) - org[axis];
+                    float planeHigh = intBitsToFloat(tree[node + 2]) - org[axis];
+                    uint32 childMask = 0;
+                    for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+                    {
+                        float tl = planeLow * invDir[axis][i];
+                        float th = planeHigh * invDir[axis][i];
+                        bool neg = negDir[axis][i];
+                        intervalMin[i] = std::max(intervalMin[i], neg ? th : tl);
+                        intervalMax[i] = std::min(intervalMax[i], neg ? tl : th);
+                        childMask |= uint32(intervalMin[i] <= intervalMax[i]) << i;
+                    }
+                    node = offset;
+                    mask &= childMask;
+                    if (!mask)
+                    {
+                        break;
+                    }
+                    continue;
+                }
+            } // traversal loop
+            do
+            {
+                // stack is empty?
+                if (stackPos == 0)
+                {
+                    return;
+                }
+                // move back up the stack
+                stackPos--;
+                PacketStackNode const& entry = stack[stackPos];
+                mask = entry.mask & ~finished;
+                for (uint32 i = 0; i < RAY_PACKET_SIZE; ++i)
+                {
+                    if ((mask & (1u << i)) && maxDists[i] < entry.tnear[i])
+                    {
+                        mask &= ~(1u << i);
+                    }
+                }
+                if (!mask)
+                {
+                    continue;
+                }
+                node = entry.node;
+                std::copy(entry.tnear, entry.tnear + RAY_PACKET_SIZE, intervalMin);
+                std::copy(entry.tfar, entry.tfar + RAY_PACKET_SIZE, intervalMax);
+                break;
+            } while (true);
+        }
+    }
+
     void subdivide(int left, int right, std::vector<uint32>& tempTree, buildData& dat, AABound& gridBox, AABound& nodeBox, int nodeIndex, int depth, BuildStats& stats);
 };
 
@@ -22,6 +22,12 @@
 #include "ModelIgnoreFlags.h"
 #include "Optional.h"
 #include <string>
+#include <vector>
+
+namespace G3D
+{
+    class Vector3;
+}
 
 //===========================================================
 
@@ -93,6 +99,10 @@ namespace VMAP
         virtual void unloadMap(unsigned int pMapId) = 0;
 
         virtual bool isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, float x2, float y2, float z2, ModelIgnoreFlags ignoreFlags) = 0;
+        /**
+        test line of sight from one position to several targets at once, results[i] holds the result for targets[i]
+        */
+        virtual void isInLineOfSight(unsigned int pMapId, float x1, float y1, float z1, std::vector<G3D::Vector3> const& targets, std::vector<bool>& results, ModelIgnoreFlags ignoreFlags) = 0;
         virtual float getHeight(unsigned int pMapId, float x, float y, float z, float maxSearchDist) = 0;
         /**
         test if we hit an object. return true if we hit one. rx, ry, rz will hold the hit position or the dest position, if no intersection was found
@@ -194,6 +194,32 @@ namespace VMAP
         return true;
     }
 
+    void VMapMgr2::isInLineOfSight(unsigned int mapId, float x1, float y1, float z1, std::vector<Vector3> const& targets, std::vector<bool>& results, ModelIgnoreFlags ignoreFlags)
+    {
+        results.assign(targets.size(), true);
+
+#if defined(ENABLE_VMAP_CHECKS)
+        if (!isLineOfSightCalcEnabled() || IsVMAPDisabledForPtr(mapId, VMAP_DISABLE_LOS))
+        {
+            return;
+        }
+#endif
+
+        InstanceTreeMap::const_iterator instanceTree = GetMapTree(mapId);
+        if (instanceTree != iInstanceMapTrees.end())
+        {
+            Vector3 pos1 = convertPositionToInternalRep(x1, y1, z1);
+            std::vector<Vector3> internalTargets;
+            internalTargets.reserve(targets.size());
+            for (Vector3 const& target : targets)
+            {
+                internalTargets.push_back(convertPositionToInternalRep(target.x, target.y, target.z));
+            }
+
+            instanceTree->second->isInLineOfSight(pos1, internalTargets, results, ignoreFlags);
+        }
+    }
+
     /**
     get the hit position and return true if we hit something
     otherwise the result pos will be the dest pos
@@ -51,6 +51,27 @@ namespace VMAP
         bool hit;
     };
 
+    class MapRayPacketCallback
+    {
+    public:
+        MapRayPacketCallback(ModelInstance* val, ModelIgnoreFlags ignoreFlags, std::vector<uint32> const& targetIndices, std::vector<bool>& results):
+            prims(val), flags(ignoreFlags), indices(targetIndices), inSight(results) { }
+        bool operator()(uint32 rayIndex, const G3D::Ray& ray, uint32 entry, float& distance, bool StopAtFirstHit)
+        {
+            bool result = prims[entry].intersectRay(ray, distance, StopAtFirstHit, flags);
+            if (result)
+            {
+                inSight[indices[rayIndex]] = false;
+            }
+            return result;
+        }
+    protected:
+        ModelInstance* prims;
+        ModelIgnoreFlags flags;
+        std::vector<uint32> const& indices;
+        std::vector<bool>& inSight;
+    };
+
     class AreaInfoCallback
     {
     public:
@@ -179,6 +200,47 @@ namespace VMAP
         return !GetIntersectionTime(ray, maxDist, true, ignoreFlags);
     }
     //=========================================================
+
+    void StaticMapTree::isInLineOfSight(const Vector3& pos1, std::vector<Vector3> const& targets, std::vector<bool>& results, ModelIgnoreFlags ignoreFlags) const
+    {
+        results.assign(targets.size(), true);
+
+        std::vector<Vector3> directions;
+        std::vector<float> maxDists;
+        std::vector<uint32> indices;
+        directions.reserve(targets.size());
+        maxDists.reserve(targets.size());
+        indices.reserve(targets.size());
+
+        for (uint32 i = 0; i < targets.size(); ++i)
+        {
+            float maxDist = (targets[i] - pos1).magnitude();
+            // same rules as the single target check
+            if (maxDist == std::numeric_limits<float>::max() || !std::isfinite(maxDist))
+            {
+                results[i] = false;
+                continue;
+            }
+
+            if (maxDist < 1e-10f)
+            {
+                continue;
+            }
+
+            directions.push_back((targets[i] - pos1) / maxDist);
+            maxDists.push_back(maxDist);
+            indices.push_back(i);
+        }
+
+        if (directions.empty())
+        {
+            return;
+        }
+
+        MapRayPacketCallback intersectionCallBack(iTreeValues, ignoreFlags, indices, results);
+        iTree.intersectRays(pos1, directions.data(), maxDists.data(), directions.size(), intersectionCallBack, true);
+    }
+    //=========================================================
     /**
     When moving from pos1 to pos2 check if we hit an object. Return true and the position if we hit one
     Return the hit pos or the original dest pos
@@ -17,71 +17,70 @@
 
 #include "DBCFileLoader.h"
 #include "Errors.h"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
 #include <string.h>
 
-DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr) { }
+namespace bip = boost::interprocess;
+
+DBCFileLoader::DBCFileLoader() : recordSize(0), recordCount(0), fieldCount(0), stringSize(0), fieldsOffset(nullptr), data(nullptr), stringTable(nullptr), referenced(false) { }
 
 bool DBCFileLoader::Load(char const* filename, char const* fmt)
 {
-    uint32 header;
-    if (data)
-    {
-        delete [] data;
-        data = nullptr;
-    }
+    data = nullptr;
+    stringTable = nullptr;
+    referenced = false;
+    mapping.reset();
 
-    FILE* f = fopen(filename, "rb");
-    if (!f)
+    delete[] fieldsOffset;
+    fieldsOffset = nullptr;
+
+    // Private mapping, records used in place may still be patched by the core without touching the file
+    try
     {
-        return false;
+        bip::file_mapping file(filename, bip::read_only);
+        mapping = std::make_unique<bip::mapped_region>(file, bip::copy_on_write);
     }
-
-    if (fread(&header, 4, 1, f) != 1)                        // Number of records
+    catch (bip::interprocess_exception const&)
     {
-        fclose(f);
+        mapping.reset();
         return false;
     }
 
-    EndianConvert(header);
+    unsigned char* base = static_cast<unsigned char*>(mapping->get_address());
+    std::size_t const size = mapping->get_size();
 
-    if (header != 0x43424457)                                //'WDBC'
+    // Signature, number of records, number of fields, size of a record, string size
+    uint32 header[5];
+    if (size < sizeof(header))
     {
-        fclose(f);
+        mapping.reset();
         return false;
     }
 
-    if (fread(&recordCount, 4, 1, f) != 1)                   // Number of records
+    memcpy(header, base, sizeof(header));
+    for (uint32& value : header)
     {
-        fclose(f);
-        return false;
+        EndianConvert(value);
     }
 
-    EndianConvert(recordCount);
-
-    if (fread(&fieldCount, 4, 1, f) != 1)                    // Number of fields
+    if (header[0] != 0x43424457)                             //'WDBC'
     {
-        fclose(f);
+        mapping.reset();
         return false;
     }
 
-    EndianConvert(fieldCount);
+    recordCount = header[1];
+    fieldCount = header[2];
+    recordSize = header[3];
+    stringSize = header[4];
 
-    if (fread(&recordSize, 4, 1, f) != 1)                    // Size of a record
+    if (size - sizeof(header) < uint64(recordSize) * recordCount + stringSize)
     {
-        fclose(f);
+        mapping.reset();
         return false;
     }
 
-    EndianConvert(recordSize);
-
-    if (fread(&stringSize, 4, 1, f) != 1)                    // String size
-    {
-        fclose(f);
-        return false;
-    }
-
-    EndianConvert(stringSize);
-
     fieldsOffset = new uint32[fieldCount];
     fieldsOffset[0] = 0;
 
@@ -98,24 +97,14 @@ bool DBCFileLoader::Load(char const* filename, char const* fmt)
         }
     }
 
-    data = new unsigned char[recordSize * recordCount + stringSize];
+    data = base + sizeof(header);
     stringTable = data + recordSize * recordCount;
 
-    if (fread(data, recordSize * recordCount + stringSize, 1, f) != 1)
-    {
-        fclose(f);
-        return false;
-    }
-
-    fclose(f);
-
     return true;
 }
 
 DBCFileLoader::~DBCFileLoader()
 {
-    delete[] data;
-
     delete[] fieldsOffset;
 }
 
@@ -125,54 +114,6 @@ DBCFileLoader::Record DBCFileLoader::getRecord(std::size_t id)
     return Record(*this, data + id * recordSize);
 }
 
-uint32 DBCFileLoader::GetFormatRecordSize(char const* format, int32* index_pos)
-{
-    uint32 recordsize = 0;
-    int32 i = -1;
-
-    for (uint32 x = 0; format[x]; ++x)
-    {
-        switch (format[x])
-        {
-            case FT_FLOAT:
-                recordsize += sizeof(float);
-                break;
-            case FT_INT:
-                recordsize += sizeof(uint32);
-                break;
-            case FT_STRING:
-                recordsize += sizeof(char*);
-                break;
-            case FT_SORT:
-                i = x;
-                break;
-            case FT_IND:
-                i = x;
-                recordsize += sizeof(uint32);
-                break;
-            case FT_BYTE:
-                recordsize += sizeof(uint8);
-                break;
-            case FT_NA:
-            case FT_NA_BYTE:
-                break;
-            case FT_LOGIC:
-                ASSERT(false && "Attempted to load DBC files that do not have field types that match what is in the core. Check DBCfmt.h or your DBC files.");
-                break;
-            default:
-                ASSERT(false && "Unknown field format character in DBCfmt.h");
-                break;
-        }
-    }
-
-    if (index_pos)
-    {
-        *index_pos = i;
-    }
-
-    return recordsize;
-}
-
 char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**& indexTable)
 {
     /*
@@ -220,6 +161,26 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
         indexTable = new ptr[recordCount];
     }
 
+    // the structure matches the file record, point the index straight into the mapped records
+    if (IsInPlaceFormat(format) && recordsize == recordSize)
+    {
+        for (uint32 y = 0; y < recordCount; ++y)
+        {
+            char* record = reinterpret_cast<char*>(data + y * recordSize);
+            if (i >= 0)
+            {
+                indexTable[getRecord(y).getUInt(i)] = record;
+            }
+            else
+            {
+                indexTable[y] = record;
+            }
+        }
+
+        referenced = true;
+        return nullptr;
+    }
+
     char* dataTable = new char[recordCount * recordsize];
 
     uint32 offset = 0;
@@ -273,16 +234,13 @@ char* DBCFileLoader::AutoProduceData(char const* format, uint32& records, char**
     return dataTable;
 }
 
-char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
+bool DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
 {
-    if (strlen(format) != fieldCount)
+    if (strlen(format) != fieldCount || !strchr(format, FT_STRING) || !dataTable)
     {
-        return nullptr;
+        return false;
     }
 
-    char* stringPool = new char[stringSize];
-    memcpy(stringPool, stringTable, stringSize);
-
     uint32 offset = 0;
 
     for (uint32 y = 0; y < recordCount; ++y)
@@ -307,8 +265,8 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
                     char** slot = (char**)(&dataTable[offset]);
                     if (!*slot || !** slot)
                     {
-                        const char* st = getRecord(y).getString(x);
-                        *slot = stringPool + (st - (char const*)stringTable);
+                        // strings are used straight from the mapped string table
+                        *slot = const_cast<char*>(getRecord(y).getString(x));
                     }
                     offset += sizeof(char*);
                     break;
@@ -327,5 +285,6 @@ char* DBCFileLoader::AutoProduceStrings(char const* format, char* dataTable)
         }
     }
 
-    return stringPool;
+    referenced = true;
+    return true;
 }
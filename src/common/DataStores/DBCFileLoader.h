@@ -21,6 +21,12 @@
 #include "Define.h"
 #include "Errors.h"
 #include "Utilities/ByteConverter.h"
+#include <memory>
+
+namespace boost::interprocess
+{
+    class mapped_region;
+}
 
 enum DbcFieldFormat
 {
@@ -92,9 +98,77 @@ public:
     [[nodiscard]] uint32 GetCols() const { return fieldCount; }
     [[nodiscard]] uint32 GetOffset(std::size_t id) const { return (fieldsOffset != nullptr && id < fieldCount) ? fieldsOffset[id] : 0; }
     [[nodiscard]] bool IsLoaded() const { return data != nullptr; }
+    // True when produced records or strings point into the mapped file, the loader must then outlive them
+    [[nodiscard]] bool IsReferenced() const { return referenced; }
     char* AutoProduceData(char const* fmt, uint32& count, char**& indexTable);
-    char* AutoProduceStrings(char const* fmt, char* dataTable);
-    static uint32 GetFormatRecordSize(const char* format, int32* index_pos = nullptr);
+    bool AutoProduceStrings(char const* fmt, char* dataTable);
+
+    static constexpr uint32 GetFormatRecordSize(char const* format, int32* index_pos = nullptr)
+    {
+        uint32 recordsize = 0;
+        int32 i = -1;
+
+        for (uint32 x = 0; format[x]; ++x)
+        {
+            switch (format[x])
+            {
+                case FT_FLOAT:
+                    recordsize += sizeof(float);
+                    break;
+                case FT_INT:
+                    recordsize += sizeof(uint32);
+                    break;
+                case FT_STRING:
+                    recordsize += sizeof(char*);
+                    break;
+                case FT_SORT:
+                    i = x;
+                    break;
+                case FT_IND:
+                    i = x;
+                    recordsize += sizeof(uint32);
+                    break;
+                case FT_BYTE:
+                    recordsize += sizeof(uint8);
+                    break;
+                case FT_NA:
+                case FT_NA_BYTE:
+                    break;
+                case FT_LOGIC:
+                    ASSERT(false && "Attempted to load DBC files that do not have field types that match what is in the core. Check DBCfmt.h or your DBC files.");
+                    break;
+                default:
+                    ASSERT(false && "Unknown field format character in DBCfmt.h");
+                    break;
+            }
+        }
+
+        if (index_pos)
+        {
+            *index_pos = i;
+        }
+
+        return recordsize;
+    }
+
+    // Formats made only of kept 4 byte numeric fields describe structures with the same layout as the file records
+    static constexpr bool IsInPlaceFormat(char const* format)
+    {
+        if (ACORE_ENDIAN != ACORE_LITTLEENDIAN)
+        {
+            return false;
+        }
+
+        for (uint32 x = 0; format[x]; ++x)
+        {
+            if (format[x] != FT_IND && format[x] != FT_INT && format[x] != FT_FLOAT)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
 
 private:
     uint32 recordSize;
@@ -104,6 +178,8 @@ private:
     uint32* fieldsOffset;
     unsigned char* data;
     unsigned char* stringTable;
+    std::unique_ptr<boost::interprocess::mapped_region> mapping;
+    bool referenced;
 
     DBCFileLoader(DBCFileLoader const& right) = delete;
     DBCFileLoader& operator=(DBCFileLoader const& right) = delete;
@@ -51,8 +51,10 @@
 
 #if AC_COMPILER == AC_COMPILER_GNU
 #  define ATTR_PRINTF(F, V) __attribute__ ((format (printf, F, V)))
+#  define ACORE_PREFETCH(ADDR) __builtin_prefetch(ADDR)
 #else //AC_COMPILER != AC_COMPILER_GNU
 #  define ATTR_PRINTF(F, V)
+#  define ACORE_PREFETCH(ADDR)
 #endif //AC_COMPILER == AC_COMPILER_GNU
 
 #ifdef ACORE_API_USE_DYNAMIC_LINKING
@@ -140,6 +140,9 @@ void EventProcessor::AddEvent(BasicEvent* Event, uint64 e_time, bool set_addtime
     Event->m_execTime = e_time;
     Event->m_eventGroup = eventGroup;
     m_events.insert(std::pair<uint64, BasicEvent*>(e_time, Event));
+
+    if (m_eventAddedHandler)
+        m_eventAddedHandler();
 }
 
 void EventProcessor::ModifyEventTime(BasicEvent* event, Milliseconds newTime)
@@ -21,6 +21,7 @@
 #include "Define.h"
 #include "Duration.h"
 #include "Random.h"
+#include <functional>
 #include <map>
 
 class EventProcessor;
@@ -121,10 +122,16 @@ class EventProcessor
 
         void CancelEventGroup(uint8 group);
 
+        [[nodiscard]] bool Empty() const { return m_events.empty(); }
+
+        // Called for every added event, lets an owner that stopped updating the processor resume
+        void SetEventAddedHandler(std::function<void()> handler) { m_eventAddedHandler = std::move(handler); }
+
     protected:
         uint64 m_time{0};
         EventList m_events;
         bool m_aborting;
+        std::function<void()> m_eventAddedHandler;
 };
 
 #endif
@@ -0,0 +1,236 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ScratchArena.h"
+#include <algorithm>
+#include <atomic>
+
+#if defined(__SANITIZE_ADDRESS__)
+#  define ACORE_SCRATCH_ARENA_PASSTHROUGH
+#elif defined(__has_feature)
+#  if __has_feature(address_sanitizer)
+#    define ACORE_SCRATCH_ARENA_PASSTHROUGH
+#  endif
+#endif
+
+namespace
+{
+    std::atomic<uint64> Allocations{0};
+    std::atomic<uint64> AllocatedBytes{0};
+    std::atomic<uint64> BlockAllocations{0};
+    std::atomic<uint64> HeapAllocations{0};
+    std::atomic<uint64> SkippedRewinds{0};
+    std::atomic<uint64> RetainedBytes{0};
+
+    thread_local bool ThreadArenaDestroyed = false;
+
+    // Scratch containers created outside of a scope
+    class HeapResource final : public std::pmr::memory_resource
+    {
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override
+        {
+            HeapAllocations.fetch_add(1, std::memory_order_relaxed);
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        [[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+    };
+
+    HeapResource& GetHeapResource()
+    {
+        // never destroyed, scratch containers may still be freed during static destruction
+        static HeapResource* resource = new HeapResource();
+        return *resource;
+    }
+
+    // offset of the first suitably aligned address at or after data + offset
+    std::size_t AlignOffset(char const* data, std::size_t offset, std::size_t alignment)
+    {
+        uintptr_t const address = reinterpret_cast<uintptr_t>(data) + offset;
+        return offset + ((alignment - address % alignment) % alignment);
+    }
+}
+
+Acore::ScratchArena::~ScratchArena()
+{
+    FlushStats();
+    RetainedBytes.fetch_sub(_publishedSize, std::memory_order_relaxed);
+    ThreadArenaDestroyed = true;
+}
+
+std::pmr::memory_resource* Acore::ScratchArena::GetResource()
+{
+#ifndef ACORE_SCRATCH_ARENA_PASSTHROUGH
+    if (ScratchArena* arena = GetThreadArena())
+        if (arena->_depth)
+            return arena;
+#endif
+
+    return &GetHeapResource();
+}
+
+Acore::ScratchArenaStats Acore::ScratchArena::GetStats()
+{
+    ScratchArenaStats stats;
+    stats.Allocations = Allocations.load(std::memory_order_relaxed);
+    stats.AllocatedBytes = AllocatedBytes.load(std::memory_order_relaxed);
+    stats.BlockAllocations = BlockAllocations.load(std::memory_order_relaxed);
+    stats.HeapAllocations = HeapAllocations.load(std::memory_order_relaxed);
+    stats.SkippedRewinds = SkippedRewinds.load(std::memory_order_relaxed);
+    stats.RetainedBytes = RetainedBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+Acore::ScratchArena* Acore::ScratchArena::GetThreadArena()
+{
+    if (ThreadArenaDestroyed)
+        return nullptr;
+
+    thread_local ScratchArena arena;
+    return &arena;
+}
+
+void* Acore::ScratchArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    ++_allocations;
+    _allocatedBytes += bytes;
+    ++_live;
+
+    if (_current < _blocks.size())
+    {
+        Block& block = _blocks[_current];
+        std::size_t const offset = AlignOffset(block.Data.get(), _offset, alignment);
+        if (offset + bytes <= block.Size)
+        {
+            _offset = offset + bytes;
+            return block.Data.get() + offset;
+        }
+    }
+
+    return AllocateFromNextBlock(bytes, alignment);
+}
+
+void* Acore::ScratchArena::AllocateFromNextBlock(std::size_t bytes, std::size_t alignment)
+{
+    // block data comes from new[], so it only has to be padded for over-aligned types
+    std::size_t const needed = bytes + (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__ ? alignment : 0);
+
+    // move on to a kept block that is large enough, the blocks skipped on the way stay unused until the rewind
+    std::size_t next = _blocks.empty() ? 0 : _current + 1;
+    while (next < _blocks.size() && _blocks[next].Size < needed)
+        ++next;
+
+    if (next == _blocks.size())
+    {
+        std::size_t const size = std::max({ MIN_BLOCK_SIZE, _blocks.empty() ? std::size_t(0) : _blocks.back().Size * 2, needed });
+        _blocks.push_back({ std::unique_ptr<char[]>(new char[size]), size });
+        ++_blockAllocations;
+    }
+
+    Block& block = _blocks[next];
+    char* data = block.Data.get();
+    std::size_t const offset = AlignOffset(data, 0, alignment);
+
+    _current = next;
+    _offset = offset + bytes;
+    return data + offset;
+}
+
+void Acore::ScratchArena::do_deallocate(void* ptr, std::size_t bytes, std::size_t /*alignment*/)
+{
+    // nothing left in use, like after each search of an update, the next one starts over at the first block
+    if (!--_live)
+    {
+        _current = 0;
+        _offset = 0;
+        return;
+    }
+
+    // a freed last allocation, like the buffer a vector grew out of, is reused right away
+    if (_current < _blocks.size())
+    {
+        char* data = _blocks[_current].Data.get();
+        char* end = static_cast<char*>(ptr) + bytes;
+        if (static_cast<char*>(ptr) >= data && end == data + _offset)
+            _offset = static_cast<char*>(ptr) - data;
+    }
+}
+
+void Acore::ScratchArena::Rewind()
+{
+    if (_live)
+    {
+        // memory still in use stays where it is, the next scope tries again
+        SkippedRewinds.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // merge the blocks the scope needed, so the next one fits in a single block
+    if (_blocks.size() > 1)
+    {
+        std::size_t size = 0;
+        for (Block const& block : _blocks)
+            size += block.Size;
+
+        size = std::min(size, MAX_RETAINED_SIZE);
+        _blocks.clear();
+        _blocks.push_back({ std::unique_ptr<char[]>(new char[size]), size });
+        ++_blockAllocations;
+    }
+    else if (!_blocks.empty() && _blocks.front().Size > MAX_RETAINED_SIZE)
+        _blocks.clear();
+
+    _current = 0;
+    _offset = 0;
+}
+
+void Acore::ScratchArena::FlushStats()
+{
+    Allocations.fetch_add(_allocations, std::memory_order_relaxed);
+    AllocatedBytes.fetch_add(_allocatedBytes, std::memory_order_relaxed);
+    BlockAllocations.fetch_add(_blockAllocations, std::memory_order_relaxed);
+    _allocations = 0;
+    _allocatedBytes = 0;
+    _blockAllocations = 0;
+
+    std::size_t size = 0;
+    for (Block const& block : _blocks)
+        size += block.Size;
+
+    RetainedBytes.fetch_add(size - _publishedSize, std::memory_order_relaxed);
+    _publishedSize = size;
+}
+
+Acore::ScratchArenaScope::ScratchArenaScope() : _arena(ScratchArena::GetThreadArena())
+{
+    if (_arena)
+        ++_arena->_depth;
+}
+
+Acore::ScratchArenaScope::~ScratchArenaScope()
+{
+    if (!_arena || --_arena->_depth)
+        return;
+
+    _arena->Rewind();
+    _arena->FlushStats();
+}
@@ -0,0 +1,150 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SCRATCHARENA_H
+#define _SCRATCHARENA_H
+
+#include "Define.h"
+#include <list>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace Acore
+{
+    struct ScratchArenaStats
+    {
+        uint64 Allocations = 0;          // served by a thread arena
+        uint64 AllocatedBytes = 0;
+        uint64 BlockAllocations = 0;     // arena blocks taken from the heap
+        uint64 HeapAllocations = 0;      // scratch allocations made outside of a scope, served by the heap
+        uint64 SkippedRewinds = 0;       // scope exits that kept the arena because scratch memory was still in use
+        uint64 RetainedBytes = 0;        // memory kept by the arenas of all threads
+    };
+
+    /*
+     * Monotonic memory of one thread for short lived containers.
+     *
+     * While a ScratchArenaScope is open on a thread, scratch containers created
+     * on it bump allocate from blocks the thread keeps. Freeing only gives memory
+     * back when it was the last allocation or when no scratch allocation is left
+     * at all. When the outermost scope closes the blocks are kept and merged into
+     * one, so after a few scopes a thread serves all of its scratch containers
+     * without touching the heap.
+     *
+     * Outside of a scope scratch containers fall back to the heap, so they are
+     * always safe to use. Scratch containers must not outlive the scope they were
+     * created in and must not be handed to other threads.
+     */
+    class AC_COMMON_API ScratchArena final : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr std::size_t MIN_BLOCK_SIZE = 64 * 1024;
+        static constexpr std::size_t MAX_RETAINED_SIZE = 4 * 1024 * 1024;
+
+        // Memory resource for a scratch container created on the calling thread
+        static std::pmr::memory_resource* GetResource();
+        static ScratchArenaStats GetStats();
+
+        ScratchArena() = default;
+        ~ScratchArena() override;
+
+        ScratchArena(ScratchArena const&) = delete;
+        ScratchArena& operator=(ScratchArena const&) = delete;
+
+    private:
+        friend class ScratchArenaScope;
+
+        struct Block
+        {
+            std::unique_ptr<char[]> Data;
+            std::size_t Size;
+        };
+
+        // nullptr once the arena of the calling thread was destroyed at thread exit
+        static ScratchArena* GetThreadArena();
+
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+        [[nodiscard]] bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override { return this == &other; }
+
+        void* AllocateFromNextBlock(std::size_t bytes, std::size_t alignment);
+        void Rewind();
+        void FlushStats();
+
+        std::vector<Block> _blocks;
+        std::size_t _current = 0;        // block bump allocations are served from
+        std::size_t _offset = 0;
+        uint64 _live = 0;
+        uint32 _depth = 0;
+
+        // published once per outermost scope, map threads do not share counters while updating
+        uint64 _allocations = 0;
+        uint64 _allocatedBytes = 0;
+        uint64 _blockAllocations = 0;
+        std::size_t _publishedSize = 0;
+    };
+
+    // Serves the scratch containers of the calling thread from its arena until the scope closes
+    class AC_COMMON_API ScratchArenaScope
+    {
+    public:
+        ScratchArenaScope();
+        ~ScratchArenaScope();
+
+        ScratchArenaScope(ScratchArenaScope const&) = delete;
+        ScratchArenaScope& operator=(ScratchArenaScope const&) = delete;
+
+    private:
+        ScratchArena* _arena;
+    };
+
+    // Binds a container to the scratch memory of the thread it was created on
+    template<typename T>
+    class ScratchAllocator
+    {
+    public:
+        using value_type = T;
+
+        ScratchAllocator() : _resource(ScratchArena::GetResource()) { }
+
+        template<typename U>
+        ScratchAllocator(ScratchAllocator<U> const& other) noexcept : _resource(other.GetResource()) { }
+
+        T* allocate(std::size_t count) { return static_cast<T*>(_resource->allocate(count * sizeof(T), alignof(T))); }
+        void deallocate(T* ptr, std::size_t count) { _resource->deallocate(ptr, count * sizeof(T), alignof(T)); }
+
+        // copies of a scratch container use the scratch memory of the thread making the copy
+        ScratchAllocator select_on_container_copy_construction() const { return ScratchAllocator(); }
+
+        [[nodiscard]] std::pmr::memory_resource* GetResource() const { return _resource; }
+
+        template<typename U>
+        bool operator==(ScratchAllocator<U> const& other) const { return _resource == other.GetResource(); }
+
+    private:
+        std::pmr::memory_resource* _resource;
+    };
+
+    template<typename T>
+    using ScratchVector = std::vector<T, ScratchAllocator<T>>;
+
+    template<typename T>
+    using ScratchList = std::list<T, ScratchAllocator<T>>;
+}
+
+#endif
@@ -0,0 +1,303 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SlabPool.h"
+#include <algorithm>
+
+#if defined(__SANITIZE_ADDRESS__)
+#  define ACORE_SLAB_POOL_PASSTHROUGH
+#elif defined(__has_feature)
+#  if __has_feature(address_sanitizer)
+#    define ACORE_SLAB_POOL_PASSTHROUGH
+#  endif
+#endif
+
+namespace
+{
+    // Pools are never destroyed, objects may still be deleted during static destruction
+    std::mutex& GetRegistryLock()
+    {
+        static std::mutex* lock = new std::mutex();
+        return *lock;
+    }
+
+    std::vector<Acore::SlabPool*>& GetRegistry()
+    {
+        static std::vector<Acore::SlabPool*>* pools = new std::vector<Acore::SlabPool*>();
+        return *pools;
+    }
+
+    std::atomic<uint32> NextSizeClassId{0};
+
+    thread_local bool ThreadCacheDestroyed = false;
+}
+
+Acore::SlabPool::SizeClass::SizeClass(std::size_t blockSize, uint32 id) :
+    BlockSize(blockSize), SlabSize(std::max(MIN_SLAB_SIZE, blockSize * MIN_BLOCKS_PER_SLAB)), Id(id)
+{
+}
+
+Acore::SlabPool::SlabPool(std::string name) : _name(std::move(name)), _oversized(0)
+{
+    for (std::atomic<SizeClass*>& sizeClass : _classes)
+        sizeClass.store(nullptr, std::memory_order_relaxed);
+}
+
+Acore::SlabPool& Acore::SlabPool::Create(std::string name)
+{
+    SlabPool* pool = new SlabPool(std::move(name));
+
+    std::lock_guard<std::mutex> guard(GetRegistryLock());
+    GetRegistry().push_back(pool);
+    return *pool;
+}
+
+std::vector<Acore::SlabPool const*> Acore::SlabPool::GetPools()
+{
+    std::lock_guard<std::mutex> guard(GetRegistryLock());
+    return { GetRegistry().begin(), GetRegistry().end() };
+}
+
+void* Acore::SlabPool::Allocate(std::size_t size)
+{
+#ifdef ACORE_SLAB_POOL_PASSTHROUGH
+    constexpr bool passthrough = true;
+#else
+    constexpr bool passthrough = false;
+#endif
+
+    if (passthrough || size > MAX_BLOCK_SIZE)
+    {
+        _oversized.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(size);
+    }
+
+    SizeClass& sizeClass = GetSizeClass(size);
+    ThreadCacheList uncached;
+    uncached.Owner = &sizeClass;
+
+    ThreadCacheList* cached = GetThreadCacheList(sizeClass);
+    ThreadCacheList& list = cached ? *cached : uncached;
+    if (!list.Head)
+        Refill(list);
+
+    FreeBlock* block = list.Head;
+    list.Head = block->Next;
+    --list.Count;
+
+    if (!cached)
+        Flush(list, 0);
+
+    sizeClass.Allocations.fetch_add(1, std::memory_order_relaxed);
+    sizeClass.RequestedBytes.fetch_add(size, std::memory_order_relaxed);
+    return block;
+}
+
+void Acore::SlabPool::Deallocate(void* ptr, std::size_t size)
+{
+    if (!ptr)
+        return;
+
+#ifdef ACORE_SLAB_POOL_PASSTHROUGH
+    constexpr bool passthrough = true;
+#else
+    constexpr bool passthrough = false;
+#endif
+
+    if (passthrough || size > MAX_BLOCK_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    SizeClass& sizeClass = GetSizeClass(size);
+    ThreadCacheList uncached;
+    uncached.Owner = &sizeClass;
+
+    ThreadCacheList* cached = GetThreadCacheList(sizeClass);
+    ThreadCacheList& list = cached ? *cached : uncached;
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->Next = list.Head;
+    list.Head = block;
+    ++list.Count;
+
+    sizeClass.Deallocations.fetch_add(1, std::memory_order_relaxed);
+    sizeClass.RequestedBytes.fetch_sub(size, std::memory_order_relaxed);
+
+    if (!cached)
+        Flush(list, 0);
+    else if (list.Count >= 2 * THREAD_CACHE_BATCH)
+        Flush(list, THREAD_CACHE_BATCH);
+}
+
+void Acore::SlabPool::ReleaseThreadCaches()
+{
+    ThreadCache* cache = GetThreadCache();
+    if (!cache)
+        return;
+
+    for (ThreadCacheList& list : cache->Lists)
+        if (list.Owner && list.Count > THREAD_CACHE_BATCH)
+            Flush(list, THREAD_CACHE_BATCH);
+}
+
+std::vector<Acore::SlabPoolStats> Acore::SlabPool::GetStats() const
+{
+    std::vector<SlabPoolStats> result;
+    for (std::atomic<SizeClass*> const& entry : _classes)
+    {
+        SizeClass* sizeClass = entry.load(std::memory_order_acquire);
+        if (!sizeClass)
+            continue;
+
+        SlabPoolStats stats;
+        stats.BlockSize = sizeClass->BlockSize;
+        {
+            std::lock_guard<std::mutex> guard(sizeClass->Lock);
+            stats.Slabs = sizeClass->Slabs.size();
+        }
+
+        stats.ReservedBytes = stats.Slabs * sizeClass->SlabSize;
+        stats.TotalBlocks = stats.Slabs * (sizeClass->SlabSize / sizeClass->BlockSize);
+        stats.Allocations = sizeClass->Allocations.load(std::memory_order_relaxed);
+        stats.Deallocations = sizeClass->Deallocations.load(std::memory_order_relaxed);
+        stats.LiveBlocks = stats.Allocations >= stats.Deallocations ? stats.Allocations - stats.Deallocations : 0;
+        stats.RequestedBytes = sizeClass->RequestedBytes.load(std::memory_order_relaxed);
+        result.push_back(stats);
+    }
+
+    return result;
+}
+
+Acore::SlabPool::SizeClass& Acore::SlabPool::GetSizeClass(std::size_t size)
+{
+    std::size_t const index = size ? (size - 1) / BLOCK_GRANULARITY : 0;
+    if (SizeClass* sizeClass = _classes[index].load(std::memory_order_acquire))
+        return *sizeClass;
+
+    std::lock_guard<std::mutex> guard(_classesLock);
+    SizeClass* sizeClass = _classes[index].load(std::memory_order_relaxed);
+    if (!sizeClass)
+    {
+        sizeClass = new SizeClass((index + 1) * BLOCK_GRANULARITY, NextSizeClassId.fetch_add(1));
+        _classes[index].store(sizeClass, std::memory_order_release);
+    }
+
+    return *sizeClass;
+}
+
+Acore::SlabPool::ThreadCache* Acore::SlabPool::GetThreadCache()
+{
+    // The cache goes away with its thread and hands its blocks to the shared lists,
+    // objects deleted by the thread afterwards (static destruction) bypass it
+    struct Holder
+    {
+        ~Holder()
+        {
+            for (ThreadCacheList& list : Cache.Lists)
+                if (list.Owner)
+                    Flush(list, 0);
+
+            ThreadCacheDestroyed = true;
+        }
+
+        ThreadCache Cache;
+    };
+
+    if (ThreadCacheDestroyed)
+        return nullptr;
+
+    thread_local Holder holder;
+    return &holder.Cache;
+}
+
+Acore::SlabPool::ThreadCacheList* Acore::SlabPool::GetThreadCacheList(SizeClass& sizeClass)
+{
+    ThreadCache* cache = GetThreadCache();
+    if (!cache)
+        return nullptr;
+
+    if (sizeClass.Id >= cache->Lists.size())
+        cache->Lists.resize(sizeClass.Id + 1);
+
+    ThreadCacheList& list = cache->Lists[sizeClass.Id];
+    list.Owner = &sizeClass;
+    return &list;
+}
+
+void Acore::SlabPool::Refill(ThreadCacheList& list)
+{
+    SizeClass& sizeClass = *list.Owner;
+    std::lock_guard<std::mutex> guard(sizeClass.Lock);
+
+    if (sizeClass.Shared)
+    {
+        // take up to one batch from the shared list
+        FreeBlock* last = sizeClass.Shared;
+        uint32 count = 1;
+        while (count < THREAD_CACHE_BATCH && last->Next)
+        {
+            last = last->Next;
+            ++count;
+        }
+
+        list.Head = sizeClass.Shared;
+        list.Count = count;
+        sizeClass.Shared = last->Next;
+        sizeClass.SharedCount -= count;
+        last->Next = nullptr;
+        return;
+    }
+
+    // carve a new slab, the blocks go to the calling thread
+    sizeClass.Slabs.emplace_back(new char[sizeClass.SlabSize]);
+    char* slab = sizeClass.Slabs.back().get();
+    std::size_t const blocks = sizeClass.SlabSize / sizeClass.BlockSize;
+
+    FreeBlock* head = nullptr;
+    for (std::size_t i = blocks; i > 0; --i)
+    {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + (i - 1) * sizeClass.BlockSize);
+        block->Next = head;
+        head = block;
+    }
+
+    list.Head = head;
+    list.Count = uint32(blocks);
+}
+
+void Acore::SlabPool::Flush(ThreadCacheList& list, uint32 keep)
+{
+    if (list.Count <= keep)
+        return;
+
+    FreeBlock* first = list.Head;
+    FreeBlock* last = first;
+    uint32 const count = list.Count - keep;
+    for (uint32 i = 1; i < count; ++i)
+        last = last->Next;
+
+    list.Head = last->Next;
+    list.Count = keep;
+
+    SizeClass& sizeClass = *list.Owner;
+    std::lock_guard<std::mutex> guard(sizeClass.Lock);
+    last->Next = sizeClass.Shared;
+    sizeClass.Shared = first;
+    sizeClass.SharedCount += count;
+}
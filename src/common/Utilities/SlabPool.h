@@ -0,0 +1,148 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _SLABPOOL_H
+#define _SLABPOOL_H
+
+#include "Define.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Acore
+{
+    struct SlabPoolStats
+    {
+        std::size_t BlockSize = 0;
+        std::size_t Slabs = 0;
+        std::size_t ReservedBytes = 0;   // memory taken by the slabs of this block size
+        uint64 TotalBlocks = 0;
+        uint64 LiveBlocks = 0;
+        uint64 RequestedBytes = 0;       // memory asked for by the live objects
+        uint64 Allocations = 0;
+        uint64 Deallocations = 0;
+    };
+
+    /*
+     * Slab allocator for the objects of one class hierarchy.
+     *
+     * Requests are rounded up to BLOCK_GRANULARITY and served from slabs of
+     * equally sized blocks, so derived classes of different sizes never share a
+     * slab and freed blocks are reused by the next object of the same size.
+     * Every thread keeps a small cache of free blocks per block size and only
+     * takes the pool lock to exchange a batch of blocks with the shared lists.
+     * Blocks may be freed on another thread than the one that allocated them.
+     *
+     * Slabs are never returned to the system: a pool keeps the memory of its
+     * peak usage, which is what avoids the fragmentation of the general heap.
+     * Pools live until the process exits.
+     */
+    class AC_COMMON_API SlabPool
+    {
+    public:
+        static constexpr std::size_t BLOCK_GRANULARITY = 16;
+        static constexpr std::size_t MAX_BLOCK_SIZE = 16 * 1024;   // larger requests go to the general heap
+        static constexpr std::size_t MIN_SLAB_SIZE = 128 * 1024;
+        static constexpr std::size_t MIN_BLOCKS_PER_SLAB = 16;
+        static constexpr uint32 THREAD_CACHE_BATCH = 32;
+
+        // Creates a pool that is never destroyed and lists it in GetPools()
+        static SlabPool& Create(std::string name);
+        static std::vector<SlabPool const*> GetPools();
+
+        // Hands the free blocks the calling thread cached beyond one batch back to the shared lists of every pool
+        static void ReleaseThreadCaches();
+
+        void* Allocate(std::size_t size);
+        void Deallocate(void* ptr, std::size_t size);
+
+        [[nodiscard]] std::string const& GetName() const { return _name; }
+        [[nodiscard]] uint64 GetOversizedAllocations() const { return _oversized.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::vector<SlabPoolStats> GetStats() const;
+
+        SlabPool(SlabPool const&) = delete;
+        SlabPool& operator=(SlabPool const&) = delete;
+
+    private:
+        struct FreeBlock
+        {
+            FreeBlock* Next;
+        };
+
+        struct SizeClass
+        {
+            SizeClass(std::size_t blockSize, uint32 id);
+
+            std::size_t const BlockSize;
+            std::size_t const SlabSize;
+            uint32 const Id;                 // index of the thread cache slot
+
+            std::mutex Lock;
+            FreeBlock* Shared = nullptr;
+            uint32 SharedCount = 0;
+            std::vector<std::unique_ptr<char[]>> Slabs;
+
+            std::atomic<uint64> Allocations{0};
+            std::atomic<uint64> Deallocations{0};
+            std::atomic<uint64> RequestedBytes{0};
+        };
+
+        struct ThreadCacheList
+        {
+            SizeClass* Owner = nullptr;
+            FreeBlock* Head = nullptr;
+            uint32 Count = 0;
+        };
+
+        struct ThreadCache
+        {
+            std::vector<ThreadCacheList> Lists;
+        };
+
+        explicit SlabPool(std::string name);
+
+        SizeClass& GetSizeClass(std::size_t size);
+
+        // nullptr once the cache of the calling thread was destroyed at thread exit
+        static ThreadCache* GetThreadCache();
+        static ThreadCacheList* GetThreadCacheList(SizeClass& sizeClass);
+
+        static void Refill(ThreadCacheList& list);
+        static void Flush(ThreadCacheList& list, uint32 keep);
+
+        std::string const _name;
+        std::array<std::atomic<SizeClass*>, MAX_BLOCK_SIZE / BLOCK_GRANULARITY> _classes;
+        std::mutex _classesLock;
+        std::atomic<uint64> _oversized;
+    };
+}
+
+// Routes new and delete of a class and all classes derived from it through a slab pool,
+// ACORE_DEFINE_SLAB_POOLED_CLASS has to be used in the translation unit of the class
+#define ACORE_SLAB_POOLED_CLASS \
+    static void* operator new(std::size_t size); \
+    static void operator delete(void* ptr, std::size_t size)
+
+#define ACORE_DEFINE_SLAB_POOLED_CLASS(type) \
+    static Acore::SlabPool& Get##type##SlabPool() { static Acore::SlabPool& pool = Acore::SlabPool::Create(#type); return pool; } \
+    void* type::operator new(std::size_t size) { return Get##type##SlabPool().Allocate(size); } \
+    void type::operator delete(void* ptr, std::size_t size) { Get##type##SlabPool().Deallocate(ptr, size); }
+
+#endif
@@ -23,6 +23,7 @@
 #include "Log.h"
 #include <errmsg.h>
 #include <mysqld_error.h>
+#include <future>
 #include <thread>
 
 DatabaseLoader::DatabaseLoader(std::string const& logger, uint32 const defaultUpdateMask, std::string_view modulesList)
@@ -178,11 +179,18 @@ bool DatabaseLoader::OpenDatabases()
 
 bool DatabaseLoader::PopulateDatabases()
 {
+    // The databases are independent, only the MySQL CLI shares its temporary config file between them
+    if (DBUpdaterUtil::IsApplyInProcess())
+        return ProcessConcurrently(_populate);
+
     return Process(_populate);
 }
 
 bool DatabaseLoader::UpdateDatabases()
 {
+    if (DBUpdaterUtil::IsApplyInProcess())
+        return ProcessConcurrently(_update);
+
     return Process(_update);
 }
 
@@ -213,6 +221,33 @@ bool DatabaseLoader::Process(std::queue<Predicate>& queue)
     return true;
 }
 
+bool DatabaseLoader::ProcessConcurrently(std::queue<Predicate>& queue)
+{
+    std::vector<std::future<bool>> results;
+    while (!queue.empty())
+    {
+        results.push_back(std::async(std::launch::async, std::move(queue.front())));
+        queue.pop();
+    }
+
+    bool success = true;
+    for (std::future<bool>& result : results)
+        if (!result.get())
+            success = false;
+
+    if (!success)
+    {
+        // Close all open databases which have a registered close operation
+        while (!_close.empty())
+        {
+            _close.top()();
+            _close.pop();
+        }
+    }
+
+    return success;
+}
+
 template AC_DATABASE_API
 DatabaseLoader& DatabaseLoader::AddDatabase<LoginDatabaseConnection>(DatabaseWorkerPool<LoginDatabaseConnection>&, std::string const&);
 template AC_DATABASE_API
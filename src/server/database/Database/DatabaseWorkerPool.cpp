@@ -330,6 +330,31 @@ void DatabaseWorkerPool<T>::DirectCommitTransaction(SQLTransaction<T>& transacti
     connection->Unlock();
 }
 
+template <class T>
+bool DatabaseWorkerPool<T>::DirectExecuteScript(std::vector<std::string> const& statements)
+{
+    T* connection = GetFreeConnection();
+    connection->BeginTransaction();
+
+    for (std::string const& statement : statements)
+    {
+        if (!connection->ExecuteScriptStatement(statement))
+        {
+            connection->RollbackTransaction();
+            connection->ResetSession();
+            connection->Unlock();
+            return false;
+        }
+    }
+
+    bool const committed = connection->ExecuteScriptStatement("COMMIT");
+
+    // Scripts change session variables (sql_mode, foreign_key_checks...), later queries of the pool must not see them
+    connection->ResetSession();
+    connection->Unlock();
+    return committed;
+}
+
 template <class T>
 PreparedStatement<T>* DatabaseWorkerPool<T>::GetPreparedStatement(PreparedStatementIndex index)
 {
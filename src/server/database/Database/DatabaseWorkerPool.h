@@ -181,6 +181,11 @@ public:
     //! were appended to the transaction will be respected during execution.
     void DirectCommitTransaction(SQLTransaction<T>& transaction);
 
+    //! Directly executes the statements of an sql script on one connection inside a transaction, that will block the calling thread until finished.
+    //! Stops at the first failing statement and rolls back, returns false in that case. The session of the connection is reset afterwards.
+    //! This method should only be used during startup before the statements are prepared, e.g. by the database updater.
+    bool DirectExecuteScript(std::vector<std::string> const& statements);
+
     //! Method used to execute ad-hoc statements in a diverse context.
     //! Will be wrapped in a transaction if valid object is present, otherwise executed standalone.
     void ExecuteOrAppend(SQLTransaction<T>& trans, std::string_view sql);
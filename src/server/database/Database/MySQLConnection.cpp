@@ -199,6 +199,62 @@ bool MySQLConnection::Execute(std::string_view sql)
     return true;
 }
 
+bool MySQLConnection::ExecuteScriptStatement(std::string_view sql)
+{
+    if (!m_Mysql)
+        return false;
+
+    uint32 _s = getMSTime();
+
+    // Statements of update files may be huge inserts, only log their beginning
+    std::string_view const logged = sql.substr(0, 1000);
+
+    if (mysql_real_query(m_Mysql, sql.data(), static_cast<unsigned long>(sql.size())))
+    {
+        LOG_INFO("sql.sql", "SQL: {}", logged);
+        LOG_ERROR("sql.sql", "[{}] {}", mysql_errno(m_Mysql), mysql_error(m_Mysql));
+        return false;
+    }
+
+    // CALL may return several result sets
+    int status = 0;
+    do
+    {
+        if (MYSQL_RES* result = mysql_store_result(m_Mysql))
+            mysql_free_result(result);
+        else if (mysql_field_count(m_Mysql))
+        {
+            LOG_INFO("sql.sql", "SQL: {}", logged);
+            LOG_ERROR("sql.sql", "[{}] {}", mysql_errno(m_Mysql), mysql_error(m_Mysql));
+            return false;
+        }
+
+        status = mysql_next_result(m_Mysql);
+    } while (!status);
+
+    if (status > 0)
+    {
+        LOG_INFO("sql.sql", "SQL: {}", logged);
+        LOG_ERROR("sql.sql", "[{}] {}", mysql_errno(m_Mysql), mysql_error(m_Mysql));
+        return false;
+    }
+
+    LOG_DEBUG("sql.sql", "[{} ms] SQL: {}", getMSTimeDiff(_s, getMSTime()), logged);
+    return true;
+}
+
+void MySQLConnection::ResetSession()
+{
+    if (!m_Mysql)
+        return;
+
+    if (mysql_reset_connection(m_Mysql))
+        LOG_ERROR("sql.sql", "Could not reset the session: [{}] {}", mysql_errno(m_Mysql), mysql_error(m_Mysql));
+
+    // the reset restores the character set of the handshake
+    mysql_set_character_set(m_Mysql, "utf8mb4");
+}
+
 bool MySQLConnection::Execute(PreparedStatementBase* stmt)
 {
     if (!m_Mysql)
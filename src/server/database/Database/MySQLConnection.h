@@ -70,6 +70,14 @@ public:
 
     bool Execute(std::string_view sql);
     bool Execute(PreparedStatementBase* stmt);
+
+    /// Executes one statement of an sql script. Result sets are read and dropped,
+    /// a lost connection is not retried because the statement may be part of an open transaction.
+    bool ExecuteScriptStatement(std::string_view sql);
+
+    /// Drops the session state (variables, temporary tables, locks) left behind by an sql script.
+    /// Server side prepared statements are dropped too, so this must not be used after PrepareStatements().
+    void ResetSession();
     ResultSet* Query(std::string_view sql);
     PreparedResultSet* Query(PreparedStatementBase* stmt);
     bool _Query(std::string_view sql, MySQLResult** pResult, MySQLField** pFields, uint64* pRowCount, uint32* pFieldCount);
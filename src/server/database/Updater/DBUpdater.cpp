@@ -21,6 +21,7 @@
 #include "DatabaseEnv.h"
 #include "DatabaseLoader.h"
 #include "Log.h"
+#include "SQLScript.h"
 #include "StartProcess.h"
 #include "UpdateFetcher.h"
 #include "QueryResult.h"
@@ -28,6 +29,21 @@
 #include <fstream>
 #include <iostream>
 
+namespace
+{
+    [[noreturn]] void FailApplyFile(std::string const& file, std::string const& database)
+    {
+        LOG_FATAL("sql.updates", "Applying of file \'{}\' to database \'{}\' failed!" \
+            " If you are a user, please pull the latest revision from the repository. "
+            "Also make sure you have not applied any of the databases with your sql client. "
+            "You cannot use auto-update system and import sql files from AzerothCore repository with your sql client. "
+            "If you are a developer, please fix your sql query.",
+            file, database);
+
+        throw UpdateException("update failed");
+    }
+}
+
 std::string DBUpdaterUtil::GetCorrectedMySQLExecutable()
 {
     if (!corrected_path().empty())
@@ -57,6 +73,11 @@ bool DBUpdaterUtil::CheckExecutable()
     return true;
 }
 
+bool DBUpdaterUtil::IsApplyInProcess()
+{
+    return sConfigMgr->GetOption<bool>("Updates.InProcess", false);
+}
+
 std::string& DBUpdaterUtil::corrected_path()
 {
     static std::string path;
@@ -184,6 +205,24 @@ bool DBUpdater<T>::Create(DatabaseWorkerPool<T>& pool)
 
     LOG_INFO("sql.updates", "Creating database \"{}\"...", pool.GetConnectionInfo()->database);
 
+    if (DBUpdaterUtil::IsApplyInProcess())
+    {
+        // Connect without selecting the database, it does not exist yet
+        MySQLConnectionInfo connectionInfo = *pool.GetConnectionInfo();
+        connectionInfo.database.clear();
+
+        T connection(connectionInfo);
+        if (connection.Open() || !connection.Execute(Acore::StringFormat("CREATE DATABASE `{}` DEFAULT CHARACTER SET UTF8MB4 COLLATE utf8mb4_general_ci", pool.GetConnectionInfo()->database)))
+        {
+            LOG_FATAL("sql.updates", "Failed to create database {}! Does the user (named in *.conf) have `CREATE`, `ALTER`, `DROP`, `INSERT` and `DELETE` privileges on the MySQL server?", pool.GetConnectionInfo()->database);
+            return false;
+        }
+
+        LOG_INFO("sql.updates", "Done.");
+        LOG_INFO("sql.updates", " ");
+        return true;
+    }
+
     // Path of temp file
     static Path const temp("create_table.sql");
 
@@ -219,7 +258,7 @@ bool DBUpdater<T>::Create(DatabaseWorkerPool<T>& pool)
 template<class T>
 bool DBUpdater<T>::Update(DatabaseWorkerPool<T>& pool, std::string_view modulesList /*= {}*/)
 {
-    if (!DBUpdaterUtil::CheckExecutable())
+    if (!DBUpdaterUtil::IsApplyInProcess() && !DBUpdaterUtil::CheckExecutable())
         return false;
 
     LOG_INFO("sql.updates", "Updating {} database...", DBUpdater<T>::GetTableName());
@@ -294,7 +333,7 @@ bool DBUpdater<T>::Update(DatabaseWorkerPool<T>& pool, std::string_view modulesL
 template<class T>
 bool DBUpdater<T>::Update(DatabaseWorkerPool<T>& pool, std::vector<std::string> const* setDirectories)
 {
-    if (!DBUpdaterUtil::CheckExecutable())
+    if (!DBUpdaterUtil::IsApplyInProcess() && !DBUpdaterUtil::CheckExecutable())
     {
         return false;
     }
@@ -361,7 +400,7 @@ bool DBUpdater<T>::Populate(DatabaseWorkerPool<T>& pool)
             return true;
     }
 
-    if (!DBUpdaterUtil::CheckExecutable())
+    if (!DBUpdaterUtil::IsApplyInProcess() && !DBUpdaterUtil::CheckExecutable())
         return false;
 
     LOG_INFO("sql.updates", "Database {} is empty, auto populating it...", DBUpdater<T>::GetTableName());
@@ -433,10 +472,37 @@ void DBUpdater<T>::Apply(DatabaseWorkerPool<T>& pool, std::string const& query)
 template<class T>
 void DBUpdater<T>::ApplyFile(DatabaseWorkerPool<T>& pool, Path const& path)
 {
+    if (DBUpdaterUtil::IsApplyInProcess())
+    {
+        DBUpdater<T>::ApplyScript(pool, path);
+        return;
+    }
+
     DBUpdater<T>::ApplyFile(pool, pool.GetConnectionInfo()->host, pool.GetConnectionInfo()->user, pool.GetConnectionInfo()->password,
                             pool.GetConnectionInfo()->port_or_socket, pool.GetConnectionInfo()->database, pool.GetConnectionInfo()->ssl, path);
 }
 
+template<class T>
+void DBUpdater<T>::ApplyScript(DatabaseWorkerPool<T>& pool, Path const& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+    {
+        LOG_FATAL("sql.updates", "Failed to open the sql file \"{}\" for reading!", path.generic_string());
+        FailApplyFile(path.generic_string(), pool.GetConnectionInfo()->database);
+    }
+
+    std::string const script((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+
+    // The CLI path runs "BEGIN; SOURCE file; COMMIT;" and disconnects at the first error, which rolls the open
+    // transaction back. Here the statements run in one transaction that is rolled back explicitly on the first error.
+    // In both cases statements that commit implicitly (DDL) end the transaction early, so a failing file may
+    // leave the changes made before its last DDL statement. Of the client commands only DELIMITER is understood.
+    if (!pool.DirectExecuteScript(Acore::SQLScript::Split(script)))
+        FailApplyFile(path.generic_string(), pool.GetConnectionInfo()->database);
+}
+
 template<class T>
 void DBUpdater<T>::ApplyFile(DatabaseWorkerPool<T>& pool, std::string const& host, std::string const& user,
                              std::string const& password, std::string const& port_or_socket, std::string const& database, std::string const& ssl, Path const& path)
@@ -509,16 +575,7 @@ void DBUpdater<T>::ApplyFile(DatabaseWorkerPool<T>& pool, std::string const& hos
         "sql.updates", "", true);
 
     if (ret != EXIT_SUCCESS)
-    {
-        LOG_FATAL("sql.updates", "Applying of file \'{}\' to database \'{}\' failed!" \
-            " If you are a user, please pull the latest revision from the repository. "
-            "Also make sure you have not applied any of the databases with your sql client. "
-            "You cannot use auto-update system and import sql files from AzerothCore repository with your sql client. "
-            "If you are a developer, please fix your sql query.",
-            path.generic_string(), pool.GetConnectionInfo()->database);
-
-        throw UpdateException("update failed");
-    }
+        FailApplyFile(path.generic_string(), pool.GetConnectionInfo()->database);
 }
 
 template class AC_DATABASE_API DBUpdater<LoginDatabaseConnection>;
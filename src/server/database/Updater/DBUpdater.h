@@ -60,6 +60,9 @@ public:
 
     static bool CheckExecutable();
 
+    // Whether update files are applied through the database connection instead of the MySQL CLI
+    static bool IsApplyInProcess();
+
 private:
     static std::string& corrected_path();
 };
@@ -87,6 +90,7 @@ private:
     static QueryResult Retrieve(DatabaseWorkerPool<T>& pool, std::string const& query);
     static void Apply(DatabaseWorkerPool<T>& pool, std::string const& query);
     static void ApplyFile(DatabaseWorkerPool<T>& pool, Path const& path);
+    static void ApplyScript(DatabaseWorkerPool<T>& pool, Path const& path);
     static void ApplyFile(DatabaseWorkerPool<T>& pool, std::string const& host, std::string const& user,
                           std::string const& password, std::string const& port_or_socket, std::string const& database, std::string const& ssl, Path const& path);
 };
@@ -0,0 +1,175 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SQLScript.h"
+#include <algorithm>
+#include <cctype>
+
+namespace
+{
+    bool IsSpace(char c)
+    {
+        return std::isspace(static_cast<unsigned char>(c)) != 0;
+    }
+
+    bool IsBlank(std::string const& statement)
+    {
+        for (char c : statement)
+            if (!IsSpace(c))
+                return false;
+
+        return true;
+    }
+
+    std::string Trim(std::string const& statement)
+    {
+        std::size_t begin = 0;
+        std::size_t end = statement.size();
+        while (begin < end && IsSpace(statement[begin]))
+            ++begin;
+
+        while (end > begin && IsSpace(statement[end - 1]))
+            --end;
+
+        return statement.substr(begin, end - begin);
+    }
+
+    // "--" only starts a comment when followed by whitespace or the end of the script
+    bool IsLineComment(std::string_view script, std::size_t pos)
+    {
+        if (script[pos] == '#')
+            return true;
+
+        return script.compare(pos, 2, "--") == 0 && (pos + 2 >= script.size() || IsSpace(script[pos + 2]));
+    }
+
+    // A DELIMITER command at the start of a statement, returns the new delimiter and moves pos to the end of the line
+    bool ReadDelimiterCommand(std::string_view script, std::size_t& pos, std::string& delimiter)
+    {
+        constexpr std::string_view command = "DELIMITER";
+        if (script.size() - pos <= command.size())
+            return false;
+
+        for (std::size_t i = 0; i < command.size(); ++i)
+            if (std::toupper(static_cast<unsigned char>(script[pos + i])) != command[i])
+                return false;
+
+        if (!IsSpace(script[pos + command.size()]))
+            return false;
+
+        std::size_t end = script.find('\n', pos);
+        if (end == std::string_view::npos)
+            end = script.size();
+
+        std::string_view argument = script.substr(pos + command.size(), end - pos - command.size());
+        while (!argument.empty() && IsSpace(argument.front()))
+            argument.remove_prefix(1);
+
+        // the delimiter ends at the first whitespace, like in the mysql client
+        std::size_t length = 0;
+        while (length < argument.size() && !IsSpace(argument[length]))
+            ++length;
+
+        if (!length)
+            return false;
+
+        delimiter.assign(argument.substr(0, length));
+        pos = end;
+        return true;
+    }
+}
+
+std::vector<std::string> Acore::SQLScript::Split(std::string_view script)
+{
+    std::vector<std::string> statements;
+    std::string delimiter = ";";
+    std::string statement;
+
+    auto finishStatement = [&]()
+    {
+        if (!IsBlank(statement))
+            statements.push_back(Trim(statement));
+
+        statement.clear();
+    };
+
+    std::size_t pos = 0;
+    while (pos < script.size())
+    {
+        char const c = script[pos];
+
+        if (IsBlank(statement) && !IsSpace(c) && ReadDelimiterCommand(script, pos, delimiter))
+        {
+            statement.clear();
+            continue;
+        }
+
+        // quoted strings and identifiers, a backslash escapes the next character of a string
+        if (c == '\'' || c == '"' || c == '`')
+        {
+            std::size_t end = pos + 1;
+            while (end < script.size() && script[end] != c)
+            {
+                if (c != '`' && script[end] == '\\')
+                    ++end;
+
+                ++end;
+            }
+
+            end = std::min(end + 1, script.size());
+            statement.append(script.substr(pos, end - pos));
+            pos = end;
+            continue;
+        }
+
+        if (IsLineComment(script, pos))
+        {
+            pos = script.find('\n', pos);
+            if (pos == std::string_view::npos)
+                pos = script.size();
+
+            continue;
+        }
+
+        if (script.compare(pos, 2, "/*") == 0)
+        {
+            std::size_t end = script.find("*/", pos + 2);
+            end = end == std::string_view::npos ? script.size() : end + 2;
+
+            if (script.compare(pos, 3, "/*!") == 0)
+                statement.append(script.substr(pos, end - pos));
+            else
+                statement.push_back(' ');
+
+            pos = end;
+            continue;
+        }
+
+        if (script.compare(pos, delimiter.size(), delimiter) == 0)
+        {
+            finishStatement();
+            pos += delimiter.size();
+            continue;
+        }
+
+        statement.push_back(c);
+        ++pos;
+    }
+
+    finishStatement();
+    return statements;
+}
@@ -0,0 +1,36 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SQLScript_h__
+#define SQLScript_h__
+
+#include "Define.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Acore::SQLScript
+{
+    // Splits an sql script into the statements the mysql command line client would send to the server.
+    // Statements end at the current delimiter, which starts as ';' and is changed by DELIMITER lines.
+    // Delimiters inside quoted strings, quoted identifiers and comments do not end a statement.
+    // Line comments and plain block comments are dropped, version comments (/*!40101 ... */)
+    // are kept because the server executes them. Empty statements are skipped.
+    AC_DATABASE_API std::vector<std::string> Split(std::string_view script);
+}
+
+#endif // SQLScript_h__
@@ -22,8 +22,11 @@
 #include "Log.h"
 #include "Tokenize.h"
 #include "Util.h"
+#include <atomic>
 #include <fstream>
+#include <future>
 #include <sstream>
+#include <thread>
 
 #include "QueryResult.h"
 
@@ -225,6 +228,36 @@ std::string UpdateFetcher::ReadSQLUpdate(Path const& file) const
     return update;
 }
 
+UpdateFetcher::FileNameToHashStorage UpdateFetcher::HashFiles(std::vector<Path> const& files) const
+{
+    std::vector<std::string> hashes(files.size());
+    std::atomic<std::size_t> next = 0;
+
+    auto worker = [&]()
+    {
+        for (std::size_t i = next++; i < files.size(); i = next++)
+            hashes[i] = ByteArrayToHexStr(Acore::Crypto::SHA1::GetDigestOf(ReadSQLUpdate(files[i])));
+    };
+
+    std::size_t const threads = std::min<std::size_t>(std::max(std::thread::hardware_concurrency(), 1u), files.size());
+
+    // futures rethrow the UpdateException of a file that could not be read
+    std::vector<std::future<void>> workers;
+    for (std::size_t i = 1; i < threads; ++i)
+        workers.push_back(std::async(std::launch::async, worker));
+
+    worker();
+
+    for (std::future<void>& future : workers)
+        future.get();
+
+    FileNameToHashStorage storage;
+    for (std::size_t i = 0; i < files.size(); ++i)
+        storage.emplace(files[i].filename().string(), std::move(hashes[i]));
+
+    return storage;
+}
+
 UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
                                    bool const allowRehash,
                                    bool const archivedRedundancy,
@@ -253,6 +286,19 @@ UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
     for (auto& entry : applied)
         hashToName.insert(std::make_pair(entry.second.hash, entry.first));
 
+    // Hash every file that gets checked below up front, hashing them one by one is most of the startup time
+    std::vector<Path> filesToHash;
+    for (auto const& sqlFile : available)
+    {
+        AppliedFileStorage::const_iterator const iter = applied.find(sqlFile.first.filename().string());
+        if (iter != applied.end() && (!redundancyChecks || (!archivedRedundancy && (iter->second.state == ARCHIVED) && (sqlFile.second == ARCHIVED))))
+            continue;
+
+        filesToHash.push_back(sqlFile.first);
+    }
+
+    FileNameToHashStorage const hashes = HashFiles(filesToHash);
+
     std::size_t importedUpdates = 0;
 
     auto ApplyUpdateFile = [&](LocaleFileEntry const& sqlFile)
@@ -282,7 +328,8 @@ UpdateResult UpdateFetcher::Update(bool const redundancyChecks,
             }
         }
 
-        std::string const hash = ByteArrayToHexStr(Acore::Crypto::SHA1::GetDigestOf(ReadSQLUpdate(filePath)));
+        FileNameToHashStorage::const_iterator const hashItr = hashes.find(filePath.filename().string());
+        std::string const hash = hashItr != hashes.end() ? hashItr->second : ByteArrayToHexStr(Acore::Crypto::SHA1::GetDigestOf(ReadSQLUpdate(filePath)));
 
         UpdateMode mode = MODE_APPLY;
 
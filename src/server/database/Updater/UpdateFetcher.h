@@ -135,6 +135,7 @@ private:
 
     using LocaleFileStorage = std::set<LocaleFileEntry, PathCompare>;
     using HashToFileNameStorage = std::unordered_map<std::string, std::string>;
+    using FileNameToHashStorage = std::unordered_map<std::string, std::string>;
     using AppliedFileStorage = std::unordered_map<std::string, AppliedFileEntry>;
     using DirectoryStorage = std::vector<UpdateFetcher::DirectoryEntry>;
     LocaleFileStorage GetFileList() const;
@@ -146,6 +147,9 @@ private:
 
     std::string ReadSQLUpdate(Path const& file) const;
 
+    // Reads and hashes the files on all cores
+    FileNameToHashStorage HashFiles(std::vector<Path> const& files) const;
+
     uint32 Apply(Path const& path) const;
 
     void UpdateEntry(AppliedFileEntry const& entry, uint32 const speed = 0) const;
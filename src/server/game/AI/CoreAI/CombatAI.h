@@ -31,6 +31,7 @@ public:
     explicit AggressorAI(Creature* c) : CreatureAI(c) {}
 
     void UpdateAI(uint32) override;
+    bool CanSleep() const override { return true; }
     static int32 Permissible(Creature const* creature);
 };
 
@@ -29,6 +29,7 @@ public:
     void MoveInLineOfSight(Unit*) override {}
     void AttackStart(Unit*) override {}
     void UpdateAI(uint32) override;
+    bool CanSleep() const override { return true; }
 
     static int32 Permissible(Creature const* /*creature*/) { return PERMIT_BASE_NO; }
 };
@@ -59,6 +60,7 @@ public:
     void UpdateAI(uint32) override {}
     void EnterEvadeMode(EvadeReason /*why*/) override {}
     void OnCharmed(bool /*apply*/) override {}
+    bool CanSleep() const override { return true; }
 
     static int32 Permissible(Creature const* creature);
 };
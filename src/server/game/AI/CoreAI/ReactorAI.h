@@ -29,6 +29,7 @@ public:
 
     void MoveInLineOfSight(Unit*) override {}
     void UpdateAI(uint32 diff) override;
+    bool CanSleep() const override { return true; }
 
     static int32 Permissible(Creature const* creature);
 };
@@ -115,6 +115,9 @@ public:
     // Called in Creature::Update when deathstate = DEAD. Inherited classes may maniuplate the ability to respawn based on scripted events.
     virtual bool CanRespawn() { return true; }
 
+    // Core AIs doing nothing out of combat on their own let idle creatures sleep, see Creature::CanSleep
+    [[nodiscard]] virtual bool CanSleep() const { return false; }
+
     // Called for reaction at stopping attack at no attackers or targets
     virtual void EnterEvadeMode(EvadeReason why = EVADE_REASON_OTHER);
 
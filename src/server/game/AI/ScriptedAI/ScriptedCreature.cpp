@@ -877,7 +877,17 @@ void GetCreatureListWithEntryInGrid(std::list<Creature*>& list, WorldObject* sou
     source->GetCreatureListWithEntryInGrid(list, entry, maxSearchRange);
 }
 
+void GetCreatureListWithEntryInGrid(Acore::ScratchVector<Creature*>& list, WorldObject* source, uint32 entry, float maxSearchRange)
+{
+    source->GetCreatureListWithEntryInGrid(list, entry, maxSearchRange);
+}
+
 void GetGameObjectListWithEntryInGrid(std::list<GameObject*>& list, WorldObject* source, uint32 entry, float maxSearchRange)
+{
+    source->GetGameObjectListWithEntryInGrid(list, entry, maxSearchRange);
+}
+
+void GetGameObjectListWithEntryInGrid(Acore::ScratchVector<GameObject*>& list, WorldObject* source, uint32 entry, float maxSearchRange)
 {
     source->GetGameObjectListWithEntryInGrid(list, entry, maxSearchRange);
 }
@@ -59,6 +59,9 @@ SmartScript::SmartScript()
     isProcessingTimedActionList = false;
     mCurrentPriority = 0;
     mEventSortingRequired = false;
+    mEventIndexOffsets.fill(0);
+    mEventIndexDirty = true;
+    mEventIndexGeneration = 0;
     _allowPhaseReset = true;
 }
 
@@ -134,32 +137,58 @@ void SmartScript::OnReset()
 
 void SmartScript::ProcessEventsFor(SMART_EVENT e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
-    for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
+    if (e == SMART_EVENT_LINK || e >= SMART_EVENT_AC_END) // special handling
+        return;
+
+    if (mEventIndexDirty || mEventIndexGeneration != sConditionMgr->GetLoadGeneration())
+        BuildEventIndex();
+
+    for (uint32 i = mEventIndexOffsets[e]; i < mEventIndexOffsets[e + 1]; ++i)
     {
-        SMART_EVENT eventType = SMART_EVENT((*i).GetEventType());
-        if (eventType == SMART_EVENT_LINK)//special handling
-            continue;
+        EventIndexEntry const entry = mEventIndex[i];
+        SmartScriptHolder& holder = mEvents[entry.Position];
 
-        if (eventType == e)
+        ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
+        if (!entry.Conditions || sConditionMgr->IsObjectMeetToConditions(info, *entry.Conditions))
         {
-            ConditionList conds = sConditionMgr->GetConditionsForSmartEvent((*i).entryOrGuid, (*i).event_id, (*i).source_type);
-            ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
-
-            if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+            ASSERT(executionStack.empty());
+            executionStack.emplace_back(SmartScriptFrame{ holder, unit, var0, var1, bvar, spell, gob });
+            while (!executionStack.empty())
             {
-                ASSERT(executionStack.empty());
-                executionStack.emplace_back(SmartScriptFrame{ *i, unit, var0, var1, bvar, spell, gob });
-                while (!executionStack.empty())
-                {
-                    auto [stack_holder , stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob] = executionStack.back();
-                    executionStack.pop_back();
-                    ProcessEvent(stack_holder, stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob);
-                }
+                auto [stack_holder , stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob] = executionStack.back();
+                executionStack.pop_back();
+                ProcessEvent(stack_holder, stack_unit, stack_var0, stack_var1, stack_bvar, stack_spell, stack_gob);
             }
         }
     }
 }
 
+void SmartScript::BuildEventIndex()
+{
+    mEventIndexOffsets.fill(0);
+    for (SmartScriptHolder const& holder : mEvents)
+        if (holder.GetEventType() < SMART_EVENT_AC_END)
+            ++mEventIndexOffsets[holder.GetEventType() + 1];
+
+    for (std::size_t type = 1; type < mEventIndexOffsets.size(); ++type)
+        mEventIndexOffsets[type] += mEventIndexOffsets[type - 1];
+
+    // counting sort keeps the mEvents order (priority) inside every event type
+    std::array<uint32, SMART_EVENT_AC_END + 1> next = mEventIndexOffsets;
+    mEventIndex.resize(mEventIndexOffsets[SMART_EVENT_AC_END]);
+    for (uint32 position = 0; position < mEvents.size(); ++position)
+    {
+        SmartScriptHolder const& holder = mEvents[position];
+        if (holder.GetEventType() >= SMART_EVENT_AC_END)
+            continue;
+
+        mEventIndex[next[holder.GetEventType()]++] = { position, sConditionMgr->GetConditionsForSmartEvent(holder.entryOrGuid, holder.event_id, holder.source_type) };
+    }
+
+    mEventIndexDirty = false;
+    mEventIndexGeneration = sConditionMgr->GetLoadGeneration();
+}
+
 void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
     e.runOnce = true;//used for repeat check
@@ -2336,7 +2365,7 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
             if (!ref)
                 break;
 
-            ObjectVector const* storedTargets = GetStoredTargetVector(e.action.sendTargetToTarget.id, *ref);
+            StoredObjectVector const* storedTargets = GetStoredTargetVector(e.action.sendTargetToTarget.id, *ref);
             if (!storedTargets)
                 break;
 
@@ -2345,14 +2374,14 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
                 if (IsCreature(target))
                 {
                     if (SmartAI* ai = CAST_AI(SmartAI, target->ToCreature()->AI()))
-                        ai->GetScript()->StoreTargetList(ObjectVector(*storedTargets), e.action.sendTargetToTarget.id);   // store a copy of target list
+                        ai->GetScript()->StoreTargetList(*storedTargets, e.action.sendTargetToTarget.id);   // store a copy of target list
                     else
                         LOG_ERROR("sql.sql", "SmartScript: Action target for SMART_ACTION_SEND_TARGET_TO_TARGET is not using SmartAI, skipping");
                 }
                 else if (IsGameObject(target))
                 {
                     if (SmartGameObjectAI* ai = CAST_AI(SmartGameObjectAI, target->ToGameObject()->AI()))
-                        ai->GetScript()->StoreTargetList(ObjectVector(*storedTargets), e.action.sendTargetToTarget.id);   // store a copy of target list
+                        ai->GetScript()->StoreTargetList(*storedTargets, e.action.sendTargetToTarget.id);   // store a copy of target list
                     else
                         LOG_ERROR("sql.sql", "SmartScript: Action target for SMART_ACTION_SEND_TARGET_TO_TARGET is not using SmartGameObjectAI, skipping");
                 }
@@ -3320,10 +3349,10 @@ void SmartScript::ProcessAction(SmartScriptHolder& e, Unit* unit, uint32 var0, u
 void SmartScript::ProcessTimedAction(SmartScriptHolder& e, uint32 const& min, uint32 const& max, Unit* unit, uint32 var0, uint32 var1, bool bvar, SpellInfo const* spell, GameObject* gob)
 {
     // xinef: extended by selfs victim
-    ConditionList const conds = sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
+    ConditionList const* conds = sConditionMgr->GetConditionsForSmartEvent(e.entryOrGuid, e.event_id, e.source_type);
     ConditionSourceInfo info = ConditionSourceInfo(unit, GetBaseObject(), me ? me->GetVictim() : nullptr);
 
-    if (sConditionMgr->IsObjectMeetToConditions(info, conds))
+    if (!conds || sConditionMgr->IsObjectMeetToConditions(info, *conds))
     {
         ProcessAction(e, unit, var0, var1, bvar, spell, gob);
         RecalcTimer(e, min, max);
@@ -3739,7 +3768,7 @@ void SmartScript::GetTargets(ObjectVector& targets, SmartScriptHolder const& e,
                 break;
             }
 
-            if (ObjectVector const* stored = GetStoredTargetVector(e.target.stored.id, *ref))
+            if (StoredObjectVector const* stored = GetStoredTargetVector(e.target.stored.id, *ref))
                 targets.assign(stored->begin(), stored->end());
             break;
         }
@@ -4609,7 +4638,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 }
                 else if (e.event.distance.entry != 0)
                 {
-                    std::list<Creature*> list;
+                    Acore::ScratchVector<Creature*> list;
                     me->GetCreatureListWithEntryInGrid(list, e.event.distance.entry, (float)e.event.distance.dist);
 
                     if (!list.empty())
@@ -4640,7 +4669,7 @@ void SmartScript::ProcessEvent(SmartScriptHolder& e, Unit* unit, uint32 var0, ui
                 }
                 else if (e.event.distance.entry != 0)
                 {
-                    std::list<GameObject*> list;
+                    Acore::ScratchVector<GameObject*> list;
                     me->GetGameObjectListWithEntryInGrid(list, e.event.distance.entry, (float)e.event.distance.dist);
 
                     if (!list.empty())
@@ -4980,6 +5009,7 @@ void SmartScript::InstallEvents()
             mEvents.push_back(*i);//must be before UpdateTimers
 
         mInstallEvents.clear();
+        mEventIndexDirty = true;
     }
 }
 
@@ -4994,6 +5024,7 @@ void SmartScript::OnUpdate(uint32 const diff)
     {
         SortEvents(mEvents);
         mEventSortingRequired = false;
+        mEventIndexDirty = true;
     }
 
     for (SmartAIEventList::iterator i = mEvents.begin(); i != mEvents.end(); ++i)
@@ -5081,6 +5112,7 @@ void SmartScript::RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll)
 void SmartScript::FillScript(SmartAIEventList e, WorldObject* obj, AreaTrigger const* at)
 {
     (void)at; // ensure that the variable is referenced even if extra logs are disabled in order to pass compiler checks
+    mEventIndexDirty = true;
 
     if (e.empty())
     {
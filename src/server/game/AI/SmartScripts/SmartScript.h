@@ -23,6 +23,7 @@
 #include "SmartScriptMgr.h"
 #include "Spell.h"
 #include "Unit.h"
+#include <array>
 #include <deque>
 
 class SmartScript
@@ -90,14 +91,15 @@ public:
     bool IsSmart(GameObject* g, bool silent = false) const;
     bool IsSmart(bool silent = false) const;
 
-    void StoreTargetList(ObjectVector const& targets, uint32 id)
+    template<class Container>
+    void StoreTargetList(Container const& targets, uint32 id)
     {
         // insert or replace
         _storedTargets.erase(id);
         _storedTargets.emplace(id, ObjectGuidVector(targets));
     }
 
-    ObjectVector const* GetStoredTargetVector(uint32 id, WorldObject const& ref) const
+    StoredObjectVector const* GetStoredTargetVector(uint32 id, WorldObject const& ref) const
     {
         auto itr = _storedTargets.find(id);
         if (itr != _storedTargets.end())
@@ -214,10 +216,24 @@ private:
     bool IsInPhase(uint32 p) const;
 
     void SortEvents(SmartAIEventList& events);
+    void BuildEventIndex();
     void RaisePriority(SmartScriptHolder& e);
     void RetryLater(SmartScriptHolder& e, bool ignoreChanceRoll = false);
 
     SmartAIEventList mEvents;
+
+    // Positions in mEvents grouped by event type (in mEvents order) with their resolved conditions,
+    // rebuilt before dispatching once mEvents changed or conditions were reloaded
+    struct EventIndexEntry
+    {
+        uint32 Position;
+        ConditionList const* Conditions;
+    };
+    std::vector<EventIndexEntry> mEventIndex;
+    std::array<uint32, SMART_EVENT_AC_END + 1> mEventIndexOffsets;
+    bool mEventIndexDirty;
+    uint32 mEventIndexGeneration;
+
     SmartAIEventList mInstallEvents;
     SmartAIEventList mTimedActionList;
     bool isProcessingTimedActionList;
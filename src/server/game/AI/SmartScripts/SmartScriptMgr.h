@@ -24,6 +24,7 @@
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Optional.h"
+#include "ScratchArena.h"
 #include "SpellMgr.h"
 #include <limits>
 
@@ -1999,18 +2000,20 @@ public:
 };
 
 using WPPath = std::unordered_map<uint32, WayPoint*>;
-using ObjectVector = std::vector<WorldObject*>;
+using ObjectVector = Acore::ScratchVector<WorldObject*>;      // targets of one event, freed when the map update ends
+using StoredObjectVector = std::vector<WorldObject*>;          // targets kept between events
 class ObjectGuidVector
 {
 public:
-    explicit ObjectGuidVector(ObjectVector const& objectVector) : _objectVector(objectVector)
+    template<class Container>
+    explicit ObjectGuidVector(Container const& objectVector) : _objectVector(objectVector.begin(), objectVector.end())
     {
         _guidVector.reserve(_objectVector.size());
         for (WorldObject* obj : _objectVector)
             _guidVector.push_back(obj->GetGUID());
     }
 
-    ObjectVector const* GetObjectVector(WorldObject const& ref) const
+    StoredObjectVector const* GetObjectVector(WorldObject const& ref) const
     {
         UpdateObjects(ref);
         return &_objectVector;
@@ -2019,7 +2022,7 @@ public:
     ~ObjectGuidVector() { }
 
 private:
-    mutable ObjectVector _objectVector;
+    mutable StoredObjectVector _objectVector;
 
     GuidVector _guidVector;
 
@@ -430,9 +430,15 @@ void AuctionHouseMgr::Update(uint32 const diff)
     {
         sScriptMgr->OnBeforeAuctionHouseMgrUpdate();
 
-        _hordeAuctions.Update();
-        _allianceAuctions.Update();
-        _neutralAuctions.Update();
+        // the mails and deletions of all auction houses expired in this interval go in one transaction
+        CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+
+        _hordeAuctions.Update(trans);
+        _allianceAuctions.Update(trans);
+        _neutralAuctions.Update(trans);
+
+        if (trans->GetSize())
+            CharacterDatabase.CommitTransaction(trans);
 
         _updateIntervalTimer.Reset();
     }
@@ -481,6 +487,7 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
     ASSERT(auction);
 
     _auctionsMap[auction->Id] = auction;
+    _expiringAuctions.emplace(auction->expire_time, auction->Id);
     sAuctionMgr->GetAuctionHouseSearcher()->AddAuction(auction);
 
     sScriptMgr->OnAuctionAdd(this, auction);
@@ -489,6 +496,7 @@ void AuctionHouseObject::AddAuction(AuctionEntry* auction)
 bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
 {
     bool wasInMap = !!_auctionsMap.erase(auction->Id);
+    _expiringAuctions.erase(std::make_pair(auction->expire_time, auction->Id));
     sAuctionMgr->GetAuctionHouseSearcher()->RemoveAuction(auction);
 
     sScriptMgr->OnAuctionRemove(this, auction);
@@ -500,23 +508,17 @@ bool AuctionHouseObject::RemoveAuction(AuctionEntry* auction)
     return wasInMap;
 }
 
-void AuctionHouseObject::Update()
+void AuctionHouseObject::Update(CharacterDatabaseTransaction trans)
 {
     time_t checkTime = GameTime::GetGameTime().count() + 60;
     ///- Handle expired auctions
 
-    // If storage is empty, no need to update. next == nullptr in this case.
-    if (_auctionsMap.empty())
-        return;
-
-    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
-
-    for (AuctionEntryMap::iterator itr, iter = _auctionsMap.begin(); iter != _auctionsMap.end(); )
+    // Scripts may remove other auctions meanwhile, the first one is always the next to expire
+    while (!_expiringAuctions.empty() && _expiringAuctions.begin()->first <= checkTime)
     {
-        itr = iter++;
-        AuctionEntry* auction = (*itr).second;
-
-        if (auction->expire_time > checkTime)
+        AuctionEntry* auction = GetAuction(_expiringAuctions.begin()->second);
+        _expiringAuctions.erase(_expiringAuctions.begin());
+        if (!auction)
             continue;
 
         ///- Either cancel the auction if there was no bidder
@@ -542,7 +544,6 @@ void AuctionHouseObject::Update()
         sAuctionMgr->RemoveAItem(auction->item_guid);
         RemoveAuction(auction);
     }
-    CharacterDatabase.CommitTransaction(trans);
 }
 
 AuctionHouseFaction AuctionEntry::GetFactionId() const
@@ -25,6 +25,7 @@
 #include "ObjectGuid.h"
 #include "Timer.h"
 #include "WorldPacket.h"
+#include <set>
 #include <unordered_map>
 
 class Item;
@@ -151,11 +152,14 @@ public:
 
     bool RemoveAuction(AuctionEntry* auction);
 
-    void Update();
+    void Update(CharacterDatabaseTransaction trans);
 
 private:
     AuctionEntryMap _auctionsMap;
 
+    // auctions ordered by expire time, an update only visits the expired ones
+    std::set<std::pair<time_t, uint32>> _expiringAuctions;
+
     // storage for "next" auction item for next Update()
     AuctionEntryMap::const_iterator _next;
 };
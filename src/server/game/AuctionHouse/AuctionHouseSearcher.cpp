@@ -85,14 +85,12 @@ void AuctionHouseWorkerThread::ProcessSearchUpdates()
 
 void AuctionHouseWorkerThread::SearchUpdateAdd(AuctionSearchAdd const& auctionAdd)
 {
-    SearchableAuctionEntriesMap& searchableAuctionMap = GetSearchableAuctionMap(auctionAdd.listFaction);
-    searchableAuctionMap.insert(std::make_pair(auctionAdd.searchableAuctionEntry->Id, auctionAdd.searchableAuctionEntry));
+    GetSearchIndex(auctionAdd.listFaction).AddAuction(auctionAdd.searchableAuctionEntry);
 }
 
 void AuctionHouseWorkerThread::SearchUpdateRemove(AuctionSearchRemove const& auctionRemove)
 {
-    SearchableAuctionEntriesMap& searchableAuctionMap = GetSearchableAuctionMap(auctionRemove.listFaction);
-    searchableAuctionMap.erase(auctionRemove.auctionId);
+    GetSearchIndex(auctionRemove.listFaction).RemoveAuction(auctionRemove.auctionId);
 }
 
 void AuctionHouseWorkerThread::SearchUpdateBid(AuctionSearchUpdateBid const& auctionUpdateBid)
@@ -152,12 +150,15 @@ void AuctionHouseWorkerThread::SearchListRequest(AuctionSearchListRequest const&
     if (!searchListRequest.searchInfo.getAll)
     {
         SortableAuctionEntriesList auctionEntries;
-        BuildListAuctionItems(searchListRequest, auctionEntries, searchableAuctionMap);
+        BuildListAuctionItems(searchListRequest, auctionEntries);
 
-        if (!searchListRequest.searchInfo.sorting.empty() && auctionEntries.size() > MAX_AUCTIONS_PER_PAGE)
+        if (!searchListRequest.searchInfo.sorting.empty() && auctionEntries.size() > MAX_AUCTIONS_PER_PAGE
+            && searchListRequest.searchInfo.listfrom < auctionEntries.size())
         {
+            // Only the requested page is sent, the auctions after it do not need to be in order
+            std::size_t pageEnd = std::min<std::size_t>(searchListRequest.searchInfo.listfrom + MAX_AUCTIONS_PER_PAGE, auctionEntries.size());
             AuctionSorter sorter(&searchListRequest.searchInfo.sorting, searchListRequest.playerInfo.loc_idx);
-            std::sort(auctionEntries.begin(), auctionEntries.end(), sorter);
+            std::partial_sort(auctionEntries.begin(), auctionEntries.begin() + pageEnd, auctionEntries.end(), sorter);
         }
 
         SortableAuctionEntriesList::const_iterator itr = auctionEntries.begin();
@@ -274,64 +275,363 @@ void AuctionHouseWorkerThread::SearchBidderListRequest(AuctionSearchBidderListRe
     _responseQueue->Enqueue(searchResponse);
 }
 
-void AuctionHouseWorkerThread::BuildListAuctionItems(AuctionSearchListRequest const& searchRequest, SortableAuctionEntriesList& auctionEntries, SearchableAuctionEntriesMap const& auctionMap) const
+void AuctionHouseWorkerThread::BuildListAuctionItems(AuctionSearchListRequest const& searchRequest, SortableAuctionEntriesList& auctionEntries)
 {
+    AuctionHouseSearchIndex& searchIndex = GetSearchIndex(searchRequest.listFaction);
+
     // pussywizard: optimization, this is a simplified case for the default search state (no filters)
     if (searchRequest.searchInfo.itemClass == 0xffffffff && searchRequest.searchInfo.itemSubClass == 0xffffffff
         && searchRequest.searchInfo.inventoryType == 0xffffffff && searchRequest.searchInfo.quality == 0xffffffff
         && searchRequest.searchInfo.levelmin == 0x00 && searchRequest.searchInfo.levelmax == 0x00
         && searchRequest.searchInfo.usable == 0x00 && searchRequest.searchInfo.wsearchedname.empty())
     {
-        for (auto const& pair : auctionMap)
+        auctionEntries.reserve(searchIndex.GetAuctions().size());
+        for (auto const& pair : searchIndex.GetAuctions())
             auctionEntries.push_back(pair.second.get());
 
         return;
     }
 
-    for (auto const& pair : auctionMap)
+    searchIndex.Search(searchRequest.searchInfo, searchRequest.playerInfo, auctionEntries);
+}
+
+namespace
+{
+    // Required levels per level band list
+    constexpr uint32 AUCTION_SEARCH_LEVEL_BAND = 10;
+
+    // Below this many candidates checking the remaining filters directly is cheaper than intersecting their lists
+    constexpr std::size_t AUCTION_SEARCH_MIN_INTERSECT = 64;
+
+    uint64 MakeSubClassKey(uint32 itemClass, uint32 itemSubClass)
     {
-        std::shared_ptr<SearchableAuctionEntry> const& Aentry = pair.second;
-        SearchableAuctionEntryItem const& Aitem = Aentry->item;
-        ItemTemplate const* proto = Aitem.itemTemplate;
+        return (uint64(itemClass) << 32) | itemSubClass;
+    }
 
-        if (searchRequest.searchInfo.itemClass != 0xffffffff && proto->Class != searchRequest.searchInfo.itemClass)
-            continue;
+    uint64 MakeTrigramKey(std::wstring const& name, std::size_t pos)
+    {
+        return (uint64(uint32(name[pos]) & 0x1FFFFF) << 42) | (uint64(uint32(name[pos + 1]) & 0x1FFFFF) << 21) | (uint32(name[pos + 2]) & 0x1FFFFF);
+    }
 
-        if (searchRequest.searchInfo.itemSubClass != 0xffffffff && proto->SubClass != searchRequest.searchInfo.itemSubClass)
-            continue;
+    std::vector<uint64> GetTrigramKeys(std::wstring const& name)
+    {
+        std::vector<uint64> keys;
+        if (name.size() < 3)
+            return keys;
+
+        keys.reserve(name.size() - 2);
+        for (std::size_t i = 0; i + 2 < name.size(); ++i)
+            keys.push_back(MakeTrigramKey(name, i));
+
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        return keys;
+    }
+
+    bool TermContains(std::vector<AuctionSearchPostingList const*> const& term, uint32 auctionId)
+    {
+        for (AuctionSearchPostingList const* list : term)
+            if (std::binary_search(list->ids.begin(), list->ids.end(), auctionId))
+                return true;
+
+        return false;
+    }
+
+    std::size_t GetTermSize(std::vector<AuctionSearchPostingList const*> const& term)
+    {
+        std::size_t size = 0;
+        for (AuctionSearchPostingList const* list : term)
+            size += list->ids.size();
+
+        return size;
+    }
+}
+
+template<class Visitor>
+void AuctionHouseSearchIndex::VisitKeys(SearchableAuctionEntry const& auctionEntry, Visitor&& visitor)
+{
+    ItemTemplate const* proto = auctionEntry.item.itemTemplate;
+
+    visitor(_itemClasses, proto->Class);
+    visitor(_itemSubClasses, MakeSubClassKey(proto->Class, proto->SubClass));
+    visitor(_inventoryTypes, proto->InventoryType);
+    visitor(_qualities, proto->Quality);
+    visitor(_levelBands, proto->RequiredLevel / AUCTION_SEARCH_LEVEL_BAND);
+
+    for (uint8 i = 0; i < MAX_CLASSES - 1; ++i)
+        if (proto->AllowableClass & (1 << i))
+            visitor(_allowableClasses, i);
+
+    for (uint8 i = 0; i < MAX_RACES - 1; ++i)
+        if (proto->AllowableRace & (1 << i))
+            visitor(_allowableRaces, i);
+
+    for (uint8 locale = 0; locale < TOTAL_LOCALES; ++locale)
+        if (_nameTrigramsBuilt[locale])
+            for (uint64 key : GetTrigramKeys(auctionEntry.item.itemName[locale]))
+                visitor(_nameTrigrams[locale], key);
+}
+
+void AuctionHouseSearchIndex::AddAuction(std::shared_ptr<SearchableAuctionEntry> const& auctionEntry)
+{
+    uint32 const auctionId = auctionEntry->Id;
+    if (!_auctions.emplace(auctionId, auctionEntry).second)
+        return;
+
+    VisitKeys(*auctionEntry, [auctionId](PostingListMap& lists, uint64 key)
+    {
+        AuctionSearchPostingList& list = lists[key];
 
-        if (searchRequest.searchInfo.inventoryType != 0xffffffff && proto->InventoryType != searchRequest.searchInfo.inventoryType)
+        // auction ids grow, new auctions almost always go to the end
+        if (list.ids.empty() || list.ids.back() < auctionId)
         {
-            // xinef: exception, robes are counted as chests
-            if (searchRequest.searchInfo.inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
-                continue;
+            list.ids.push_back(auctionId);
+            return;
         }
 
-        if (searchRequest.searchInfo.quality != 0xffffffff && proto->Quality < searchRequest.searchInfo.quality)
-            continue;
-
-        if (searchRequest.searchInfo.levelmin != 0x00 && (proto->RequiredLevel < searchRequest.searchInfo.levelmin
-            || (searchRequest.searchInfo.levelmax != 0x00 && proto->RequiredLevel > searchRequest.searchInfo.levelmax)))
+        std::vector<uint32>::iterator itr = std::lower_bound(list.ids.begin(), list.ids.end(), auctionId);
+        if (itr != list.ids.end() && *itr == auctionId)
         {
-            continue;
+            // re-added before its removal was compacted
+            --list.removed;
+            return;
         }
 
-        if (searchRequest.searchInfo.usable != 0x00)
+        list.ids.insert(itr, auctionId);
+    });
+}
+
+void AuctionHouseSearchIndex::RemoveAuction(uint32 auctionId)
+{
+    SearchableAuctionEntriesMap::iterator itr = _auctions.find(auctionId);
+    if (itr == _auctions.end())
+        return;
+
+    std::shared_ptr<SearchableAuctionEntry> auctionEntry = std::move(itr->second);
+    _auctions.erase(itr);
+
+    // Erasing from the front of long lists would move all of them, dead ids are skipped by searches until compacted
+    VisitKeys(*auctionEntry, [this](PostingListMap& lists, uint64 key)
+    {
+        PostingListMap::iterator listItr = lists.find(key);
+        if (listItr == lists.end())
+            return;
+
+        AuctionSearchPostingList& list = listItr->second;
+        if (++list.removed * 2 < list.ids.size())
+            return;
+
+        Compact(list);
+        if (list.ids.empty())
+            lists.erase(listItr);
+    });
+}
+
+void AuctionHouseSearchIndex::Compact(AuctionSearchPostingList& list) const
+{
+    list.ids.erase(std::remove_if(list.ids.begin(), list.ids.end(), [this](uint32 auctionId)
+    {
+        return !_auctions.contains(auctionId);
+    }), list.ids.end());
+
+    list.removed = 0;
+}
+
+void AuctionHouseSearchIndex::BuildTrigrams(int locale)
+{
+    PostingListMap& lists = _nameTrigrams[locale];
+    for (auto const& [auctionId, auctionEntry] : _auctions)
+        for (uint64 key : GetTrigramKeys(auctionEntry->item.itemName[locale]))
+            lists[key].ids.push_back(auctionId);
+
+    for (auto& [key, list] : lists)
+        std::sort(list.ids.begin(), list.ids.end());
+
+    _nameTrigramsBuilt[locale] = true;
+}
+
+void AuctionHouseSearchIndex::Search(AuctionHouseSearchInfo const& searchInfo, AuctionHousePlayerInfo const& playerInfo, SortableAuctionEntriesList& auctionEntries)
+{
+    std::vector<SearchTerm> terms;
+    bool noMatch = false;
+
+    // Adds a filter, an auction must be in one of the lists of keys
+    auto addTerm = [&](PostingListMap const& lists, std::vector<uint64> const& keys)
+    {
+        SearchTerm term;
+        for (uint64 key : keys)
         {
-            if (!searchRequest.playerInfo.usablePlayerInfo.value().PlayerCanUseItem(proto))
-                continue;
+            PostingListMap::const_iterator itr = lists.find(key);
+            if (itr != lists.end())
+                term.push_back(&itr->second);
         }
 
-        // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
-        // No need to do any of this if no search term was entered
-        if (!searchRequest.searchInfo.wsearchedname.empty())
+        if (term.empty())
+            noMatch = true;
+        else
+            terms.push_back(std::move(term));
+    };
+
+    if (searchInfo.itemClass != 0xffffffff)
+    {
+        if (searchInfo.itemSubClass != 0xffffffff)
+            addTerm(_itemSubClasses, { MakeSubClassKey(searchInfo.itemClass, searchInfo.itemSubClass) });
+        else
+            addTerm(_itemClasses, { searchInfo.itemClass });
+    }
+
+    if (searchInfo.inventoryType != 0xffffffff)
+    {
+        // xinef: exception, robes are counted as chests
+        if (searchInfo.inventoryType == INVTYPE_CHEST)
+            addTerm(_inventoryTypes, { INVTYPE_CHEST, INVTYPE_ROBE });
+        else
+            addTerm(_inventoryTypes, { searchInfo.inventoryType });
+    }
+
+    if (searchInfo.quality != 0xffffffff)
+    {
+        std::vector<uint64> qualities;
+        for (uint32 quality = searchInfo.quality; quality < MAX_ITEM_QUALITY; ++quality)
+            qualities.push_back(quality);
+
+        addTerm(_qualities, qualities);
+    }
+
+    if (searchInfo.levelmin != 0x00)
+    {
+        std::vector<uint64> levelBands;
+        uint32 lastBand = (searchInfo.levelmax != 0x00 ? searchInfo.levelmax : std::numeric_limits<uint8>::max()) / AUCTION_SEARCH_LEVEL_BAND;
+        for (uint32 band = searchInfo.levelmin / AUCTION_SEARCH_LEVEL_BAND; band <= lastBand; ++band)
+            levelBands.push_back(band);
+
+        addTerm(_levelBands, levelBands);
+    }
+
+    if (searchInfo.usable != 0x00 && playerInfo.usablePlayerInfo)
+    {
+        auto addMaskTerm = [&](PostingListMap const& lists, uint32 mask, uint8 indexedBits)
+        {
+            // bits without a list could match any auction
+            if (mask >> indexedBits)
+                return;
+
+            std::vector<uint64> bits;
+            for (uint8 i = 0; i < indexedBits; ++i)
+                if (mask & (1 << i))
+                    bits.push_back(i);
+
+            addTerm(lists, bits);
+        };
+
+        addMaskTerm(_allowableClasses, playerInfo.usablePlayerInfo->classMask, MAX_CLASSES - 1);
+        addMaskTerm(_allowableRaces, playerInfo.usablePlayerInfo->raceMask, MAX_RACES - 1);
+    }
+
+    // Every trigram of the searched name has to be in the item name
+    if (searchInfo.wsearchedname.size() >= 3 && playerInfo.loc_idx >= 0 && playerInfo.loc_idx < TOTAL_LOCALES)
+    {
+        if (!_nameTrigramsBuilt[playerInfo.loc_idx])
+            BuildTrigrams(playerInfo.loc_idx);
+
+        for (uint64 key : GetTrigramKeys(searchInfo.wsearchedname))
+            addTerm(_nameTrigrams[playerInfo.loc_idx], { key });
+    }
+
+    if (noMatch)
+        return;
+
+    if (terms.empty())
+    {
+        for (auto const& pair : _auctions)
+            if (MatchesSearch(*pair.second, searchInfo, playerInfo))
+                auctionEntries.push_back(pair.second.get());
+
+        return;
+    }
+
+    std::sort(terms.begin(), terms.end(), [](SearchTerm const& left, SearchTerm const& right)
+    {
+        return GetTermSize(left) < GetTermSize(right);
+    });
+
+    // Candidates are the auctions of the most selective filter, narrowed down by the next ones
+    std::vector<uint32> candidates;
+    candidates.reserve(GetTermSize(terms.front()));
+    for (AuctionSearchPostingList const* list : terms.front())
+        candidates.insert(candidates.end(), list->ids.begin(), list->ids.end());
+
+    if (terms.front().size() > 1)
+        std::sort(candidates.begin(), candidates.end());
+
+    for (std::size_t i = 1; i < terms.size() && candidates.size() > AUCTION_SEARCH_MIN_INTERSECT; ++i)
+    {
+        SearchTerm const& term = terms[i];
+        if (term.size() == 1)
         {
-            if (Aitem.itemName[searchRequest.playerInfo.loc_idx].find(searchRequest.searchInfo.wsearchedname) == std::wstring::npos)
-                continue;
+            // both are sorted, a merge is cheaper than looking up every candidate
+            std::vector<uint32> const& ids = term.front()->ids;
+            candidates.erase(std::set_intersection(candidates.begin(), candidates.end(), ids.begin(), ids.end(), candidates.begin()), candidates.end());
+            continue;
         }
 
-        auctionEntries.push_back(Aentry.get());
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&term](uint32 auctionId)
+        {
+            return !TermContains(term, auctionId);
+        }), candidates.end());
+    }
+
+    // The lists only narrow down the auctions, every candidate is checked against the whole search
+    for (uint32 auctionId : candidates)
+    {
+        SearchableAuctionEntriesMap::const_iterator itr = _auctions.find(auctionId);
+        if (itr != _auctions.end() && MatchesSearch(*itr->second, searchInfo, playerInfo))
+            auctionEntries.push_back(itr->second.get());
+    }
+}
+
+bool AuctionHouseSearchIndex::MatchesSearch(SearchableAuctionEntry const& auctionEntry, AuctionHouseSearchInfo const& searchInfo, AuctionHousePlayerInfo const& playerInfo)
+{
+    SearchableAuctionEntryItem const& Aitem = auctionEntry.item;
+    ItemTemplate const* proto = Aitem.itemTemplate;
+
+    if (searchInfo.itemClass != 0xffffffff && proto->Class != searchInfo.itemClass)
+        return false;
+
+    if (searchInfo.itemSubClass != 0xffffffff && proto->SubClass != searchInfo.itemSubClass)
+        return false;
+
+    if (searchInfo.inventoryType != 0xffffffff && proto->InventoryType != searchInfo.inventoryType)
+    {
+        // xinef: exception, robes are counted as chests
+        if (searchInfo.inventoryType != INVTYPE_CHEST || proto->InventoryType != INVTYPE_ROBE)
+            return false;
+    }
+
+    if (searchInfo.quality != 0xffffffff && proto->Quality < searchInfo.quality)
+        return false;
+
+    if (searchInfo.levelmin != 0x00 && (proto->RequiredLevel < searchInfo.levelmin
+        || (searchInfo.levelmax != 0x00 && proto->RequiredLevel > searchInfo.levelmax)))
+    {
+        return false;
+    }
+
+    if (searchInfo.usable != 0x00)
+    {
+        if (!playerInfo.usablePlayerInfo.value().PlayerCanUseItem(proto))
+            return false;
+    }
+
+    // Allow search by suffix (ie: of the Monkey) or partial name (ie: Monkey)
+    // No need to do any of this if no search term was entered
+    if (!searchInfo.wsearchedname.empty())
+    {
+        if (Aitem.itemName[playerInfo.loc_idx].find(searchInfo.wsearchedname) == std::wstring::npos)
+            return false;
     }
+
+    return true;
 }
 
 AuctionHouseSearcher::AuctionHouseSearcher()
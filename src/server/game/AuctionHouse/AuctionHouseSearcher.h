@@ -24,6 +24,7 @@
 #include "LockedQueue.h"
 #include "MPSCQueue.h"
 #include "PCQueue.h"
+#include <array>
 #include <memory>
 #include <thread>
 #include <unordered_map>
@@ -237,6 +238,51 @@ private:
     int _loc_idx;
 };
 
+// Sorted ids of the auctions sharing one search key. Removed auctions are only dropped once they make up half of the list.
+struct AuctionSearchPostingList
+{
+    std::vector<uint32> ids;
+    uint32 removed{ 0 };
+};
+
+// Auctions of one auction house with inverted indexes over the searchable item properties,
+// so a search only looks at the auctions of its most selective filters instead of all of them
+class AuctionHouseSearchIndex
+{
+public:
+    void AddAuction(std::shared_ptr<SearchableAuctionEntry> const& auctionEntry);
+    void RemoveAuction(uint32 auctionId);
+
+    [[nodiscard]] SearchableAuctionEntriesMap const& GetAuctions() const { return _auctions; }
+
+    // Appends every auction matching the search, name trigrams of a locale are indexed on its first search
+    void Search(AuctionHouseSearchInfo const& searchInfo, AuctionHousePlayerInfo const& playerInfo, SortableAuctionEntriesList& auctionEntries);
+
+    static bool MatchesSearch(SearchableAuctionEntry const& auctionEntry, AuctionHouseSearchInfo const& searchInfo, AuctionHousePlayerInfo const& playerInfo);
+
+private:
+    using PostingListMap = std::unordered_map<uint64, AuctionSearchPostingList>;
+    using SearchTerm = std::vector<AuctionSearchPostingList const*>; // an auction matches a term if it is in any of its lists
+
+    template<class Visitor>
+    void VisitKeys(SearchableAuctionEntry const& auctionEntry, Visitor&& visitor);
+
+    void BuildTrigrams(int locale);
+    void Compact(AuctionSearchPostingList& list) const;
+
+    SearchableAuctionEntriesMap _auctions;
+
+    PostingListMap _itemClasses;
+    PostingListMap _itemSubClasses;
+    PostingListMap _inventoryTypes;
+    PostingListMap _qualities;
+    PostingListMap _levelBands;
+    PostingListMap _allowableClasses;                           // one list per class bit
+    PostingListMap _allowableRaces;                             // one list per race bit
+    std::array<PostingListMap, TOTAL_LOCALES> _nameTrigrams;
+    std::array<bool, TOTAL_LOCALES> _nameTrigramsBuilt{};
+};
+
 class AuctionHouseWorkerThread
 {
 public:
@@ -259,11 +305,12 @@ private:
     void SearchOwnerListRequest(AuctionSearchOwnerListRequest const& searchOwnerListRequest);
     void SearchBidderListRequest(AuctionSearchBidderListRequest const& searchBidderListRequest);
 
-    void BuildListAuctionItems(AuctionSearchListRequest const& searchRequest, SortableAuctionEntriesList& auctionEntries, SearchableAuctionEntriesMap const& auctionMap) const;
+    void BuildListAuctionItems(AuctionSearchListRequest const& searchRequest, SortableAuctionEntriesList& auctionEntries);
 
-    SearchableAuctionEntriesMap& GetSearchableAuctionMap(AuctionHouseFaction faction) { return _searchableAuctionMap[static_cast<uint8>(faction)]; };
+    AuctionHouseSearchIndex& GetSearchIndex(AuctionHouseFaction faction) { return _searchIndex[static_cast<uint8>(faction)]; }
+    SearchableAuctionEntriesMap const& GetSearchableAuctionMap(AuctionHouseFaction faction) { return GetSearchIndex(faction).GetAuctions(); };
 
-    SearchableAuctionEntriesMap _searchableAuctionMap[MAX_AUCTION_HOUSE_FACTIONS];
+    AuctionHouseSearchIndex _searchIndex[MAX_AUCTION_HOUSE_FACTIONS];
     LockedQueue<std::shared_ptr<AuctionSearcherUpdate>> _auctionUpdatesQueue;
 
     ProducerConsumerQueue<AuctionSearcherRequest*>* _requestQueue;
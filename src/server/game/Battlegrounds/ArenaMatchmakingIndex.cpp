@@ -0,0 +1,130 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ArenaMatchmakingIndex.h"
+#include "BattlegroundQueue.h"
+#include "Timer.h"
+#include <algorithm>
+#include <limits>
+
+void ArenaMatchmakingIndex::AddTeam(GroupQueueInfo* ginfo)
+{
+    if (_positions.contains(ginfo))
+        return;
+
+    Position position;
+    position.Rating = _byRating.emplace(ginfo->ArenaMatchmakerRating, ginfo);
+    position.JoinOrder = _byJoinOrder.emplace(_nextJoinOrder++, ginfo).first;
+    _positions.emplace(ginfo, position);
+}
+
+void ArenaMatchmakingIndex::RemoveTeam(GroupQueueInfo const* ginfo)
+{
+    auto itr = _positions.find(ginfo);
+    if (itr == _positions.end())
+        return;
+
+    _byRating.erase(itr->second.Rating);
+    _byJoinOrder.erase(itr->second.JoinOrder);
+    _positions.erase(itr);
+}
+
+std::vector<ArenaMatchmakingIndex::Match> ArenaMatchmakingIndex::FindMatches(ArenaMatchmakingRules const& rules) const
+{
+    std::vector<Match> matches;
+    std::unordered_set<GroupQueueInfo const*> matched;
+
+    for (auto const& [joinOrder, ginfo] : _byJoinOrder)
+    {
+        if (matched.contains(ginfo))
+            continue;
+
+        if (GroupQueueInfo* opponent = FindOpponent(ginfo, rules, matched))
+        {
+            matches.emplace_back(ginfo, opponent);
+            matched.insert(ginfo);
+            matched.insert(opponent);
+        }
+    }
+
+    return matches;
+}
+
+GroupQueueInfo* ArenaMatchmakingIndex::FindOpponent(GroupQueueInfo const* ginfo, ArenaMatchmakingRules const& rules, std::unordered_set<GroupQueueInfo const*> const& matched) const
+{
+    // Every team that waited longer was already paired or looked for an opponent in its own, larger window,
+    // so searching the window of this team is enough even for opponents whose rating is discarded
+    uint32 const rating = ginfo->ArenaMatchmakerRating;
+    uint32 const window = GetRatingWindow(ginfo, rules);
+    bool const anyRating = IsRatingDiscarded(ginfo, rules);
+
+    // walk both ways from the team rating, always taking the closer side
+    RatingMap::const_iterator above = _byRating.lower_bound(rating);
+    RatingMap::const_reverse_iterator below(above);
+
+    while (above != _byRating.end() || below != _byRating.rend())
+    {
+        bool const takeAbove = above != _byRating.end() && (below == _byRating.rend() || above->first - rating <= rating - below->first);
+        GroupQueueInfo* candidate = takeAbove ? above->second : below->second;
+        uint32 const difference = takeAbove ? above->first - rating : rating - below->first;
+
+        if (difference > window && !anyRating)
+            break;
+
+        if (takeAbove)
+            ++above;
+        else
+            ++below;
+
+        if (candidate == ginfo || matched.contains(candidate) || !CanPlayAgainst(ginfo, candidate, rules))
+            continue;
+
+        return candidate;
+    }
+
+    return nullptr;
+}
+
+uint32 ArenaMatchmakingIndex::GetRatingWindow(GroupQueueInfo const* ginfo, ArenaMatchmakingRules const& rules)
+{
+    uint64 const waited = getMSTimeDiff(ginfo->JoinTime, rules.Now);
+    uint64 const window = rules.MaxRatingDifference + uint64(rules.RatingDifferenceGrowth) * waited / MINUTE / IN_MILLISECONDS;
+    return uint32(std::min<uint64>(window, std::numeric_limits<uint32>::max()));
+}
+
+bool ArenaMatchmakingIndex::IsRatingDiscarded(GroupQueueInfo const* ginfo, ArenaMatchmakingRules const& rules)
+{
+    return getMSTimeDiff(ginfo->JoinTime, rules.Now) > rules.RatingDiscardTimer;
+}
+
+bool ArenaMatchmakingIndex::CanPlayAgainst(GroupQueueInfo const* ginfo, GroupQueueInfo const* opponent, ArenaMatchmakingRules const& rules)
+{
+    if (ginfo->IsInvitedToBGInstanceGUID || opponent->IsInvitedToBGInstanceGUID)
+        return false;
+
+    if (ginfo->ArenaTeamId == opponent->ArenaTeamId)
+        return false;
+
+    // a team skips the team it just played against until it waited long enough
+    if (ginfo->PreviousOpponentsTeamId == opponent->ArenaTeamId && getMSTimeDiff(ginfo->JoinTime, rules.Now) <= rules.PreviousOpponentsDiscardTimer)
+        return false;
+
+    if (opponent->PreviousOpponentsTeamId == ginfo->ArenaTeamId && getMSTimeDiff(opponent->JoinTime, rules.Now) <= rules.PreviousOpponentsDiscardTimer)
+        return false;
+
+    return true;
+}
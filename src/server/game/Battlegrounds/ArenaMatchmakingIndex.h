@@ -0,0 +1,84 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _ARENAMATCHMAKINGINDEX_H
+#define _ARENAMATCHMAKINGINDEX_H
+
+#include "Define.h"
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+struct GroupQueueInfo;
+
+struct ArenaMatchmakingRules
+{
+    uint32 Now;                                             // game time in milliseconds, same clock as GroupQueueInfo::JoinTime
+    uint32 MaxRatingDifference;
+    uint32 RatingDifferenceGrowth;                          // added to MaxRatingDifference per minute in queue
+    uint32 RatingDiscardTimer;                              // after this long in queue a team plays against any rating
+    uint32 PreviousOpponentsDiscardTimer;                   // after this long in queue a team may play its previous opponents again
+};
+
+/*
+ * Rated arena teams waiting in one bracket of a queue, ordered by matchmaker
+ * rating and by join order.
+ *
+ * Teams are paired longest waiting first, each with the closest rating it is
+ * allowed to play against, so a queue update costs a rating lookup per team
+ * instead of a walk of the queue.
+ */
+class ArenaMatchmakingIndex
+{
+public:
+    using Match = std::pair<GroupQueueInfo*, GroupQueueInfo*>;
+
+    void AddTeam(GroupQueueInfo* ginfo);
+    void RemoveTeam(GroupQueueInfo const* ginfo);
+
+    [[nodiscard]] bool IsEmpty() const { return _positions.empty(); }
+    [[nodiscard]] std::size_t GetSize() const { return _positions.size(); }
+
+    // Pairs the waiting teams, the first team of a match joined earlier than the second
+    [[nodiscard]] std::vector<Match> FindMatches(ArenaMatchmakingRules const& rules) const;
+
+    // Largest rating difference the team accepts, grows with its time in queue
+    [[nodiscard]] static uint32 GetRatingWindow(GroupQueueInfo const* ginfo, ArenaMatchmakingRules const& rules);
+    [[nodiscard]] static bool IsRatingDiscarded(GroupQueueInfo const* ginfo, ArenaMatchmakingRules const& rules);
+    [[nodiscard]] static bool CanPlayAgainst(GroupQueueInfo const* ginfo, GroupQueueInfo const* opponent, ArenaMatchmakingRules const& rules);
+
+private:
+    using RatingMap = std::multimap<uint32, GroupQueueInfo*>;
+    using JoinOrderMap = std::map<uint64, GroupQueueInfo*>;
+
+    struct Position
+    {
+        RatingMap::iterator Rating;
+        JoinOrderMap::iterator JoinOrder;
+    };
+
+    GroupQueueInfo* FindOpponent(GroupQueueInfo const* ginfo, ArenaMatchmakingRules const& rules, std::unordered_set<GroupQueueInfo const*> const& matched) const;
+
+    RatingMap _byRating;
+    JoinOrderMap _byJoinOrder;                              // JoinTime wraps around, an insertion counter does not
+    std::unordered_map<GroupQueueInfo const*, Position> _positions;
+    uint64 _nextJoinOrder{ 0 };
+};
+
+#endif
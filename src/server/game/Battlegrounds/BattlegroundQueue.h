@@ -18,6 +18,7 @@
 #ifndef __BATTLEGROUNDQUEUE_H
 #define __BATTLEGROUNDQUEUE_H
 
+#include "ArenaMatchmakingIndex.h"
 #include "Battleground.h"
 #include "DBCEnums.h"
 #include "EventProcessor.h"
@@ -124,6 +125,9 @@ public:
     //one selection pool for horde, other one for alliance
     SelectionPool m_SelectionPools[PVP_TEAMS_COUNT];
 
+    // rated arena teams of m_QueuedGroups not invited yet, by matchmaker rating
+    ArenaMatchmakingIndex m_ArenaMatchmaking[MAX_BATTLEGROUND_BRACKETS];
+
     void SetQueueAnnouncementTimer(uint32 bracketId, int32 timer, bool isCrossFactionBG = true);
     [[nodiscard]] int32 GetQueueAnnouncementTimer(uint32 bracketId) const;
 
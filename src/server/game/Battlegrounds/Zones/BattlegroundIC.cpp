@@ -733,16 +733,16 @@ void BattlegroundIC::HandleContestedNodes(ICNodePoint* nodePoint)
             DelCreature(type);
         }
 
-        std::list<Creature*> cannons;
+        Acore::ScratchVector<Creature*> cannons;
         if (nodePoint->faction == TEAM_HORDE)
             gunshipAlliance->GetCreatureListWithEntryInGrid(cannons, NPC_ALLIANCE_GUNSHIP_CANNON, 150.0f);
         else
             gunshipHorde->GetCreatureListWithEntryInGrid(cannons, NPC_HORDE_GUNSHIP_CANNON, 150.0f);
 
-        for (std::list<Creature*>::const_iterator itr = cannons.begin(); itr != cannons.end(); ++itr)
+        for (Creature* cannon : cannons)
         {
-            (*itr)->GetVehicleKit()->RemoveAllPassengers();
-            (*itr)->SetUnitFlag(UNIT_FLAG_NOT_SELECTABLE);
+            cannon->GetVehicleKit()->RemoveAllPassengers();
+            cannon->SetUnitFlag(UNIT_FLAG_NOT_SELECTABLE);
         }
     }
     else if (nodePoint->nodeType == NODE_TYPE_WORKSHOP)
@@ -770,14 +770,14 @@ void BattlegroundIC::HandleCapturedNodes(ICNodePoint* nodePoint, bool recapture)
                 if (!gunshipAlliance || !gunshipHorde)
                     break;
 
-                std::list<Creature*> cannons;
+                Acore::ScratchVector<Creature*> cannons;
                 if (nodePoint->faction == TEAM_ALLIANCE)
                     gunshipAlliance->GetCreatureListWithEntryInGrid(cannons, NPC_ALLIANCE_GUNSHIP_CANNON, 150.0f);
                 else
                     gunshipHorde->GetCreatureListWithEntryInGrid(cannons, NPC_HORDE_GUNSHIP_CANNON, 150.0f);
 
-                for (std::list<Creature*>::const_iterator itr = cannons.begin(); itr != cannons.end(); ++itr)
-                    (*itr)->RemoveUnitFlag(UNIT_FLAG_NOT_SELECTABLE);
+                for (Creature* cannon : cannons)
+                    cannon->RemoveUnitFlag(UNIT_FLAG_NOT_SELECTABLE);
 
                 for (uint8 u = 0; u < MAX_HANGAR_TELEPORTERS_SPAWNS; ++u)
                 {
@@ -26,6 +26,33 @@
 #include "SocialMgr.h"
 #include "World.h"
 
+namespace
+{
+    bool TestIgnoreBit(std::vector<uint64> const& mask, uint32 slot)
+    {
+        return (slot / 64) < mask.size() && (mask[slot / 64] & (uint64(1) << (slot % 64)));
+    }
+
+    void SetIgnoreBit(std::vector<uint64>& mask, uint32 slot, bool set)
+    {
+        if (set)
+        {
+            if (mask.size() <= slot / 64)
+                mask.resize(slot / 64 + 1, 0);
+
+            mask[slot / 64] |= uint64(1) << (slot % 64);
+        }
+        else if ((slot / 64) < mask.size())
+        {
+            mask[slot / 64] &= ~(uint64(1) << (slot % 64));
+
+            // keep masks of senders nobody ignores empty
+            while (!mask.empty() && !mask.back())
+                mask.pop_back();
+        }
+    }
+}
+
 Channel::Channel(std::string const& name, uint32 channelId, uint32 channelDBId, TeamId teamId, bool announce, bool ownership):
     _announce(announce),
     _ownership(ownership),
@@ -208,6 +235,7 @@ void Channel::JoinChannel(Player* player, std::string const& pass)
     pinfo.plrPtr = player;
 
     playersStore[guid] = pinfo;
+    AddRecipient(playersStore[guid]);
 
     if (_channelRights.joinMessage.length())
         ChatHandler(player->GetSession()).PSendSysMessage("{}", _channelRights.joinMessage);
@@ -271,6 +299,7 @@ void Channel::LeaveChannel(Player* player, bool send)
 
     bool changeowner = playersStore[guid].IsOwner();
 
+    RemoveRecipient(playersStore[guid]);
     playersStore.erase(guid);
     if (_announce && ShouldAnnouncePlayer(player))
     {
@@ -438,6 +467,7 @@ void Channel::KickOrBan(Player const* player, std::string const& badname, bool b
 
     if (isOnChannel)
     {
+        RemoveRecipient(playersStore[victim]);
         playersStore.erase(victim);
         bad->LeftChannel(this);
         RemoveWatching(bad);
@@ -906,16 +936,85 @@ void Channel::SetOwner(ObjectGuid guid, bool exclaim)
 
 void Channel::SendToAll(WorldPacket* data, ObjectGuid guid)
 {
-    for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-        if (!guid || !i->second.plrPtr->GetSocial()->HasIgnore(guid))
-            i->second.plrPtr->GetSession()->SendPacket(data);
+    std::shared_ptr<WorldPacket const> packet = std::make_shared<WorldPacket const>(*data);
+
+    if (!guid || !IsOn(guid))
+    {
+        for (Player* recipient : _recipients)
+            if (!guid || !recipient->GetSocial()->HasIgnore(guid))
+                recipient->GetSession()->SendSharedPacket(packet);
+
+        return;
+    }
+
+    IgnoreMask const& ignoring = GetIgnoreMask(guid);
+    for (uint32 slot = 0; slot < _recipients.size(); ++slot)
+        if (!TestIgnoreBit(ignoring, slot))
+            _recipients[slot]->GetSession()->SendSharedPacket(packet);
 }
 
 void Channel::SendToAllButOne(WorldPacket* data, ObjectGuid who)
 {
-    for (PlayerContainer::const_iterator i = playersStore.begin(); i != playersStore.end(); ++i)
-        if (i->first != who)
-            i->second.plrPtr->GetSession()->SendPacket(data);
+    std::shared_ptr<WorldPacket const> packet = std::make_shared<WorldPacket const>(*data);
+
+    for (Player* recipient : _recipients)
+        if (recipient->GetGUID() != who)
+            recipient->GetSession()->SendSharedPacket(packet);
+}
+
+void Channel::SetIgnored(ObjectGuid member, ObjectGuid ignoredGuid, bool ignored)
+{
+    PlayerContainer::const_iterator itr = playersStore.find(member);
+    if (itr == playersStore.end())
+        return;
+
+    IgnoreMaskContainer::iterator mask = _ignoreMasks.find(ignoredGuid);
+    if (mask != _ignoreMasks.end())
+        SetIgnoreBit(mask->second, itr->second.recipientSlot, ignored);
+}
+
+void Channel::AddRecipient(PlayerInfo& pinfo)
+{
+    pinfo.recipientSlot = _recipients.size();
+    _recipients.push_back(pinfo.plrPtr);
+
+    for (auto& [sender, mask] : _ignoreMasks)
+        if (pinfo.plrPtr->GetSocial()->HasIgnore(sender))
+            SetIgnoreBit(mask, pinfo.recipientSlot, true);
+}
+
+void Channel::RemoveRecipient(PlayerInfo const& pinfo)
+{
+    uint32 const slot = pinfo.recipientSlot;
+    uint32 const last = _recipients.size() - 1;
+
+    // move the last recipient into the freed slot, together with its ignore bits
+    if (slot != last)
+    {
+        Player* moved = _recipients[last];
+        _recipients[slot] = moved;
+        playersStore[moved->GetGUID()].recipientSlot = slot;
+
+        for (auto& [sender, mask] : _ignoreMasks)
+            SetIgnoreBit(mask, slot, TestIgnoreBit(mask, last));
+    }
+
+    for (auto& [sender, mask] : _ignoreMasks)
+        SetIgnoreBit(mask, last, false);
+
+    _recipients.pop_back();
+    _ignoreMasks.erase(pinfo.player);
+}
+
+Channel::IgnoreMask const& Channel::GetIgnoreMask(ObjectGuid sender)
+{
+    auto [itr, inserted] = _ignoreMasks.try_emplace(sender);
+    if (inserted)
+        for (uint32 slot = 0; slot < _recipients.size(); ++slot)
+            if (_recipients[slot]->GetSocial()->HasIgnore(sender))
+                SetIgnoreBit(itr->second, slot, true);
+
+    return itr->second;
 }
 
 void Channel::SendToOne(WorldPacket* data, ObjectGuid who)
@@ -147,6 +147,7 @@ class Channel
         ObjectGuid player;
         uint8 flags;
         Player* plrPtr; // pussywizard
+        uint32 recipientSlot = 0; // index in _recipients
 
         [[nodiscard]] bool HasFlag(uint8 flag) const { return flags & flag; }
         void SetFlag(uint8 flag) { if (!HasFlag(flag)) flags |= flag; }
@@ -221,6 +222,9 @@ public:
     void AddWatching(Player* p);
     void RemoveWatching(Player* p);
 
+    // Keeps the ignore masks in sync when a member changes their ignore list
+    void SetIgnored(ObjectGuid member, ObjectGuid ignoredGuid, bool ignored);
+
 private:
     // initial packet data (notify type and channel name)
     void MakeNotifyPacket(WorldPacket* data, uint8 notify_type);
@@ -313,9 +317,17 @@ private:
         }
     }
 
+    // One bit per recipient slot, set when that recipient ignores the sender. Empty when nobody does.
+    using IgnoreMask = std::vector<uint64>;
+
+    void AddRecipient(PlayerInfo& pinfo);
+    void RemoveRecipient(PlayerInfo const& pinfo);
+    IgnoreMask const& GetIgnoreMask(ObjectGuid sender);
+
     using PlayerContainer = std::unordered_map<ObjectGuid, PlayerInfo>;
     using BannedContainer = std::unordered_map<ObjectGuid, uint32>;
     using PlayersWatchingContainer = std::unordered_set<Player*>;
+    using IgnoreMaskContainer = std::unordered_map<ObjectGuid, IgnoreMask>;
     bool _announce;
     bool _moderation;
     bool _ownership;
@@ -332,5 +344,7 @@ private:
     PlayerContainer playersStore;
     BannedContainer bannedStore;
     PlayersWatchingContainer playersWatchingStore;
+    std::vector<Player*> _recipients;                   // members of playersStore, compacted on leave
+    IgnoreMaskContainer _ignoreMasks;                   // built on the first message of a sender, dropped when they leave
 };
 #endif
@@ -0,0 +1,256 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _THREATHEAP_H
+#define _THREATHEAP_H
+
+#include "Define.h"
+#include <algorithm>
+#include <vector>
+
+/*
+ * Max heap on threat where every reference knows its own position, so a reference
+ * whose threat changed is sifted alone. Equal threat is ordered by insertion.
+ *
+ * REF needs GetThreat() and the members iHeapIndex and iSequence, kept by the heap.
+ */
+template<class REF>
+class ThreatHeap
+{
+public:
+    [[nodiscard]] bool empty() const { return _heap.empty(); }
+    [[nodiscard]] std::size_t size() const { return _heap.size(); }
+    [[nodiscard]] REF* front() const { return _heap.empty() ? nullptr : _heap.front(); }
+
+    [[nodiscard]] bool contains(REF const* ref) const
+    {
+        return ref->iHeapIndex < _heap.size() && _heap[ref->iHeapIndex] == ref;
+    }
+
+    void insert(REF* ref)
+    {
+        if (contains(ref))
+            return;
+
+        ref->iSequence = _sequence++;
+        ref->iHeapIndex = _heap.size();
+        _heap.push_back(ref);
+        siftUp(ref->iHeapIndex);
+    }
+
+    void remove(REF* ref)
+    {
+        if (!contains(ref))
+            return;
+
+        uint32 index = ref->iHeapIndex;
+        REF* last = _heap.back();
+        _heap.pop_back();
+        if (last != ref)
+        {
+            _heap[index] = last;
+            last->iHeapIndex = index;
+            siftUp(index);
+            siftDown(last->iHeapIndex);
+        }
+    }
+
+    // Restores the order after the threat of the reference changed
+    void update(REF* ref)
+    {
+        if (!contains(ref))
+            return;
+
+        siftUp(ref->iHeapIndex);
+        siftDown(ref->iHeapIndex);
+    }
+
+    void clear() { _heap.clear(); }
+
+    static bool isHigher(REF const* a, REF const* b)
+    {
+        if (a->GetThreat() != b->GetThreat())
+            return a->GetThreat() > b->GetThreat();
+
+        return a->iSequence < b->iSequence;
+    }
+
+    // Calls visitor(ref, isLast) from the highest to the lowest threat until it returns true
+    template<class VISITOR>
+    void visitInThreatOrder(VISITOR&& visitor) const;
+
+    /*
+     * Two pass victim selection of ThreatContainer::SelectNextVictim, in threat order.
+     * isSecondChoice(ref): targets only chosen if all of them are second choice
+     * canAttack(ref): targets that can be chosen at all
+     * isInMeleeRange(ref): targets that take over with 110% of the threat of currentVictim instead of 130%
+     */
+    template<class SECOND_CHOICE, class CAN_ATTACK, class IN_MELEE_RANGE>
+    REF* selectVictim(REF* currentVictim, SECOND_CHOICE&& isSecondChoice, CAN_ATTACK&& canAttack, IN_MELEE_RANGE&& isInMeleeRange) const;
+
+private:
+    void siftUp(uint32 index)
+    {
+        REF* ref = _heap[index];
+        while (index > 0)
+        {
+            uint32 parent = (index - 1) / 2;
+            if (!isHigher(ref, _heap[parent]))
+                break;
+
+            _heap[index] = _heap[parent];
+            _heap[index]->iHeapIndex = index;
+            index = parent;
+        }
+
+        _heap[index] = ref;
+        ref->iHeapIndex = index;
+    }
+
+    void siftDown(uint32 index)
+    {
+        REF* ref = _heap[index];
+        uint32 size = _heap.size();
+        while (true)
+        {
+            uint32 child = 2 * index + 1;
+            if (child >= size)
+                break;
+
+            if (child + 1 < size && isHigher(_heap[child + 1], _heap[child]))
+                ++child;
+
+            if (!isHigher(_heap[child], ref))
+                break;
+
+            _heap[index] = _heap[child];
+            _heap[index]->iHeapIndex = index;
+            index = child;
+        }
+
+        _heap[index] = ref;
+        ref->iHeapIndex = index;
+    }
+
+    std::vector<REF*> _heap;
+    uint32 _sequence{0};
+};
+
+template<class REF>
+template<class VISITOR>
+void ThreatHeap<REF>::visitInThreatOrder(VISITOR&& visitor) const
+{
+    if (_heap.empty())
+        return;
+
+    // Frontier of heap positions whose parents were already visited, the best one is always the next in order
+    auto frontierOrder = [this](uint32 a, uint32 b) { return isHigher(_heap[b], _heap[a]); };
+    std::vector<uint32> frontier;
+    frontier.reserve(8);
+    frontier.push_back(0);
+
+    while (!frontier.empty())
+    {
+        std::pop_heap(frontier.begin(), frontier.end(), frontierOrder);
+        uint32 index = frontier.back();
+        frontier.pop_back();
+
+        for (uint32 child = 2 * index + 1; child <= 2 * index + 2 && child < _heap.size(); ++child)
+        {
+            frontier.push_back(child);
+            std::push_heap(frontier.begin(), frontier.end(), frontierOrder);
+        }
+
+        if (visitor(_heap[index], frontier.empty()))
+            return;
+    }
+}
+
+template<class REF>
+template<class SECOND_CHOICE, class CAN_ATTACK, class IN_MELEE_RANGE>
+REF* ThreatHeap<REF>::selectVictim(REF* currentVictim, SECOND_CHOICE&& isSecondChoice, CAN_ATTACK&& canAttack, IN_MELEE_RANGE&& isInMeleeRange) const
+{
+    REF* currentRef = nullptr;
+    bool found = false;
+    bool noPriorityTargetFound = false;
+
+    // pussywizard: iterate from highest to lowest threat
+    // the second pass only happens if the lowest entry of the first one was a second choice target
+    auto select = [&](REF* ref, bool isLast) -> bool
+    {
+        currentRef = ref;
+
+        // pussywizard: don't go to threat comparison if this ref is immune to damage or has aura breakable on damage (second choice target)
+        // pussywizard: if this is the last entry on the threat list, then all targets are second choice, set bool to true and loop threat list again, ignoring this section
+        if (!noPriorityTargetFound && isSecondChoice(currentRef))
+        {
+            if (isLast)
+                noPriorityTargetFound = true;
+
+            return false;
+        }
+
+        // pussywizard: skip not valid targets
+        if (!canAttack(currentRef))
+            return false;
+
+        if (currentVictim) // pussywizard: if not nullptr then target must have 10%/30% more threat
+        {
+            if (currentVictim == currentRef) // pussywizard: nothing found previously was good and enough, currentRef passed all necessary tests, so end now
+            {
+                found = true;
+                return true;
+            }
+
+            // pussywizard: implement 110% threat rule for targets in melee range and 130% rule for targets in ranged distances
+            if (currentRef->GetThreat() > 1.3f * currentVictim->GetThreat()) // pussywizard: enough in all cases, end
+            {
+                found = true;
+                return true;
+            }
+            else if (currentRef->GetThreat() > 1.1f * currentVictim->GetThreat()) // pussywizard: enought only if target in melee range
+            {
+                if (isInMeleeRange(currentRef))
+                {
+                    found = true;
+                    return true;
+                }
+            }
+            else // pussywizard: nothing found previously was good and enough, this and next entries on the list have less than 110% threat, and currentVictim is present and valid as checked before the loop (otherwise it's nullptr), so end now
+            {
+                currentRef = currentVictim;
+                found = true;
+                return true;
+            }
+        }
+        else // pussywizard: no currentVictim, first passing all checks is chosen (highest threat)
+        {
+            found = true;
+            return true;
+        }
+
+        return false;
+    };
+
+    visitInThreatOrder(select);
+    if (!found && noPriorityTargetFound)
+        visitInThreatOrder(select);
+
+    return found ? currentRef : nullptr;
+}
+
+#endif
@@ -97,6 +97,8 @@ HostileReference::HostileReference(Unit* refUnit, ThreatMgr* threatMgr, float th
     link(refUnit, threatMgr);
     iUnitGuid = refUnit->GetGUID();
     iOnline = true;
+    iHeapIndex = 0;
+    iSequence = 0;
 }
 
 //============================================================
@@ -254,6 +256,8 @@ void ThreatContainer::clearReferences()
     }
 
     iThreatList.clear();
+    iThreatHeap.clear();
+    iReferencesByGuid.clear();
 }
 
 //============================================================
@@ -268,16 +272,45 @@ HostileReference* ThreatContainer::getReferenceByTarget(Unit const* victim) cons
 
 HostileReference* ThreatContainer::getReferenceByTarget(ObjectGuid const& guid) const
 {
-    for (ThreatContainer::StorageType::const_iterator i = iThreatList.begin(); i != iThreatList.end(); ++i)
-    {
-        HostileReference* ref = (*i);
-        if (ref && ref->getUnitGuid() == guid)
-        {
-            return ref;
-        }
-    }
+    auto itr = iReferencesByGuid.find(guid);
+    return itr != iReferencesByGuid.end() ? itr->second : nullptr;
+}
+
+//============================================================
+
+void ThreatContainer::addReference(HostileReference* hostileRef)
+{
+    if (iThreatHeap.contains(hostileRef))
+        return;
 
-    return nullptr;
+    iThreatHeap.insert(hostileRef);
+    iReferencesByGuid.emplace(hostileRef->getUnitGuid(), hostileRef);
+    iThreatList.push_back(hostileRef);
+    iDirty = true;
+}
+
+void ThreatContainer::remove(HostileReference* hostileRef)
+{
+    if (!iThreatHeap.contains(hostileRef))
+        return;
+
+    iThreatHeap.remove(hostileRef);
+
+    auto itr = iReferencesByGuid.find(hostileRef->getUnitGuid());
+    if (itr != iReferencesByGuid.end() && itr->second == hostileRef)
+        iReferencesByGuid.erase(itr);
+
+    // removing keeps the list order
+    iThreatList.remove(hostileRef);
+}
+
+void ThreatContainer::updateReference(HostileReference* hostileRef)
+{
+    if (!iThreatHeap.contains(hostileRef))
+        return;
+
+    iThreatHeap.update(hostileRef);
+    iDirty = true;
 }
 
 //============================================================
@@ -305,7 +338,7 @@ void ThreatContainer::ModifyThreatByPercent(Unit* victim, int32 percent)
 void ThreatContainer::update()
 {
     if (iDirty && iThreatList.size() > 1)
-        iThreatList.sort(Acore::ThreatOrderPred());
+        iThreatList.sort(&ThreatHeap<HostileReference>::isHigher);
 
     iDirty = false;
 }
@@ -318,10 +351,6 @@ HostileReference* ThreatContainer::SelectNextVictim(Creature* attacker, HostileR
 {
     // pussywizard: pretty much remade this whole function
 
-    HostileReference* currentRef = nullptr;
-    bool found = false;
-    bool noPriorityTargetFound = false;
-
     // pussywizard: currentVictim is needed to compare if threat was exceeded by 10%/30% for melee/range targets (only then switching current target)
     if (currentVictim)
     {
@@ -332,78 +361,22 @@ HostileReference* ThreatContainer::SelectNextVictim(Creature* attacker, HostileR
             currentVictim = nullptr;
     }
 
-    ThreatContainer::StorageType::const_iterator lastRef = iThreatList.end();
-    --lastRef;
-
-    // pussywizard: iterate from highest to lowest threat
-    for (ThreatContainer::StorageType::const_iterator iter = iThreatList.begin(); iter != iThreatList.end() && !found;)
-    {
-        currentRef = (*iter);
-
-        Unit* target = currentRef->getTarget();
-        ASSERT(target); // if the ref has status online the target must be there !
-
-        // pussywizard: don't go to threat comparison if this ref is immune to damage or has aura breakable on damage (second choice target)
-        // pussywizard: if this is the last entry on the threat list, then all targets are second choice, set bool to true and loop threat list again, ignoring this section
-        if (!noPriorityTargetFound && (target->IsImmunedToDamageOrSchool(attacker->GetMeleeDamageSchoolMask()) || target->HasNegativeAuraWithInterruptFlag(AURA_INTERRUPT_FLAG_TAKE_DAMAGE) || target->HasUnitState(UNIT_STATE_CONFUSED) || target->HasAuraTypeWithCaster(SPELL_AURA_IGNORED, attacker->GetGUID())))
+    return iThreatHeap.selectVictim(currentVictim,
+        [attacker](HostileReference* ref)
         {
-            if (iter != lastRef)
-            {
-                ++iter;
-                continue;
-            }
-            else
-            {
-                noPriorityTargetFound = true;
-                iter = iThreatList.begin();
-                continue;
-            }
-        }
+            Unit* target = ref->getTarget();
+            ASSERT(target); // if the ref has status online the target must be there !
 
-        // pussywizard: skip not valid targets
-        if (attacker->CanCreatureAttack(target))
+            return target->IsImmunedToDamageOrSchool(attacker->GetMeleeDamageSchoolMask()) || target->HasNegativeAuraWithInterruptFlag(AURA_INTERRUPT_FLAG_TAKE_DAMAGE) || target->HasUnitState(UNIT_STATE_CONFUSED) || target->HasAuraTypeWithCaster(SPELL_AURA_IGNORED, attacker->GetGUID());
+        },
+        [attacker](HostileReference* ref)
         {
-            if (currentVictim) // pussywizard: if not nullptr then target must have 10%/30% more threat
-            {
-                if (currentVictim == currentRef) // pussywizard: nothing found previously was good and enough, currentRef passed all necessary tests, so end now
-                {
-                    found = true;
-                    break;
-                }
+            Unit* target = ref->getTarget();
+            ASSERT(target);
 
-                // pussywizard: implement 110% threat rule for targets in melee range and 130% rule for targets in ranged distances
-                if (currentRef->GetThreat() > 1.3f * currentVictim->GetThreat()) // pussywizard: enough in all cases, end
-                {
-                    found = true;
-                    break;
-                }
-                else if (currentRef->GetThreat() > 1.1f * currentVictim->GetThreat()) // pussywizard: enought only if target in melee range
-                {
-                    if (attacker->IsWithinMeleeRange(target))
-                    {
-                        found = true;
-                        break;
-                    }
-                }
-                else // pussywizard: nothing found previously was good and enough, this and next entries on the list have less than 110% threat, and currentVictim is present and valid as checked before the loop (otherwise it's nullptr), so end now
-                {
-                    currentRef = currentVictim;
-                    found = true;
-                    break;
-                }
-            }
-            else // pussywizard: no currentVictim, first passing all checks is chosen (highest threat, list is sorted)
-            {
-                found = true;
-                break;
-            }
-        }
-        ++iter;
-    }
-    if (!found)
-        currentRef = nullptr;
-
-    return currentRef;
+            return attacker->CanCreatureAttack(target);
+        },
+        [attacker](HostileReference* ref) { return attacker->IsWithinMeleeRange(ref->getTarget()); });
 }
 
 //============================================================
@@ -591,9 +564,11 @@ void ThreatMgr::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusCh
     switch (threatRefStatusChangeEvent->getType())
     {
         case UEV_THREAT_REF_THREAT_CHANGE:
-            if ((getCurrentVictim() == hostileRef && threatRefStatusChangeEvent->getFValue() < 0.0f) ||
-                    (getCurrentVictim() != hostileRef && threatRefStatusChangeEvent->getFValue() > 0.0f))
-                setDirty(true);                             // the order in the threat list might have changed
+            // the order in the threat list might have changed
+            if (hostileRef->IsOnline())
+                iThreatContainer.updateReference(hostileRef);
+            else
+                iThreatOfflineContainer.updateReference(hostileRef);
             break;
         case UEV_THREAT_REF_ONLINE_STATUS:
             if (!hostileRef->IsOnline())
@@ -612,10 +587,9 @@ void ThreatMgr::processThreatEvent(ThreatRefStatusChangeEvent* threatRefStatusCh
             }
             else
             {
-                if (getCurrentVictim() && hostileRef->GetThreat() > (1.1f * getCurrentVictim()->GetThreat()))
-                    setDirty(true);
-                iThreatContainer.addReference(hostileRef);
+                // the reference can only be part of one container at a time
                 iThreatOfflineContainer.remove(hostileRef);
+                iThreatContainer.addReference(hostileRef);
             }
             break;
         case UEV_THREAT_REF_REMOVE_FROM_LIST:
@@ -22,8 +22,10 @@
 #include "ObjectGuid.h"
 #include "Reference.h"
 #include "SharedDefines.h"
+#include "ThreatHeap.h"
 #include "UnitEvents.h"
 #include <list>
+#include <unordered_map>
 
 //==============================================================
 
@@ -46,6 +48,8 @@ struct ThreatCalcHelper
 //==============================================================
 class HostileReference : public Reference<Unit, ThreatMgr>
 {
+    template<class REF> friend class ThreatHeap;
+
 public:
     HostileReference(Unit* refUnit, ThreatMgr* threatMgr, float threat);
 
@@ -134,6 +138,8 @@ private:
     float iTempThreatModifier;                          // used for taunt
     ObjectGuid iUnitGuid;
     bool iOnline;
+    uint32 iHeapIndex;                                  // position in the threat heap of the owning container
+    uint32 iSequence;                                   // insertion order in that heap, breaks ties between equal threat
 };
 
 //==============================================================
@@ -161,12 +167,12 @@ public:
 
     [[nodiscard]] bool empty() const
     {
-        return iThreatList.empty();
+        return iThreatHeap.empty();
     }
 
     [[nodiscard]] HostileReference* getMostHated() const
     {
-        return iThreatList.empty() ? nullptr : iThreatList.front();
+        return iThreatHeap.front();
     }
 
     HostileReference* getReferenceByTarget(Unit const* victim) const;
@@ -175,21 +181,22 @@ public:
     [[nodiscard]] StorageType const& GetThreatList() const { return iThreatList; }
 
 private:
-    void remove(HostileReference* hostileRef)
-    {
-        iThreatList.remove(hostileRef);
-    }
+    void remove(HostileReference* hostileRef);
 
-    void addReference(HostileReference* hostileRef)
-    {
-        iThreatList.push_back(hostileRef);
-    }
+    void addReference(HostileReference* hostileRef);
+
+    // Restores the heap order after the threat of the reference changed
+    void updateReference(HostileReference* hostileRef);
 
     void clearReferences();
 
     // Sort the list if necessary
     void update();
 
+    ThreatHeap<HostileReference> iThreatHeap;
+    std::unordered_map<ObjectGuid, HostileReference*> iReferencesByGuid;
+
+    // Same references as the heap, sorted on update for the callers iterating the threat list
     StorageType iThreatList;
     bool iDirty{false};
 };
@@ -309,21 +316,4 @@ struct RedirectThreatInfo
     }
 };
 
-//=================================================
-
-namespace Acore
-{
-    // Binary predicate for sorting HostileReferences based on threat value
-    class ThreatOrderPred
-    {
-    public:
-        ThreatOrderPred(bool ascending = false) : m_ascending(ascending) {}
-        bool operator() (HostileReference const* a, HostileReference const* b) const
-        {
-            return m_ascending ? a->GetThreat() < b->GetThreat() : a->GetThreat() > b->GetThreat();
-        }
-    private:
-        const bool m_ascending;
-    };
-}
 #endif
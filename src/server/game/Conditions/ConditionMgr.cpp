@@ -29,6 +29,7 @@
 #include "SpellAuras.h"
 #include "SpellMgr.h"
 #include "WorldState.h"
+#include <tuple>
 
 // Checks if object meets the condition
 // Can have CONDITION_SOURCE_TYPE_NONE && !mReferenceId if called from a special event (ie: eventAI)
@@ -833,6 +834,11 @@ ConditionList ConditionMgr::GetConditionReferences(uint32 refId)
     return conditions;
 }
 
+void ConditionMgr::AddToReferenceTemplate(uint32 refId, Condition* cond)
+{
+    ConditionReferenceStore[refId].push_back(cond);
+}
+
 uint32 ConditionMgr::GetSearcherTypeMaskForConditionList(ConditionList const& conditions)
 {
     if (conditions.empty())
@@ -934,9 +940,108 @@ bool ConditionMgr::IsObjectMeetToConditions(ConditionSourceInfo& sourceInfo, Con
         return true;
 
     LOG_DEBUG("condition", "ConditionMgr::IsObjectMeetToConditions");
+    if (ConditionProgram const* program = GetConditionProgram(conditions))
+        return program->Evaluate([&sourceInfo](Condition* condition) { return condition->Meets(sourceInfo); });
+
     return IsObjectMeetToConditionList(sourceInfo, conditions);
 }
 
+ConditionProgram const* ConditionMgr::GetConditionProgram(ConditionList const& conditions) const
+{
+    auto itr = _programs.find(conditions.front());
+    if (itr == _programs.end() || !itr->second.IsCompiledFrom(conditions))
+        return nullptr;
+
+    return &itr->second;
+}
+
+void ConditionMgr::CompileConditionPrograms()
+{
+    uint32 oldMSTime = getMSTime();
+
+    for (auto const& [sourceType, typeContainer] : ConditionStore)
+        for (auto const& [entry, conditions] : typeContainer)
+            AddConditionProgram(conditions);
+
+    for (CreatureSpellConditionContainer const* store : { &VehicleSpellConditionStore, &SpellClickEventConditionStore, &NpcVendorConditionContainerStore })
+        for (auto const& [sourceGroup, typeContainer] : *store)
+            for (auto const& [entry, conditions] : typeContainer)
+                AddConditionProgram(conditions);
+
+    for (auto const& [key, typeContainer] : SmartEventConditionStore)
+        for (auto const& [eventId, conditions] : typeContainer)
+            AddConditionProgram(conditions);
+
+    // grouped conditions were handed out to loot templates, gossip menus and spells by their source
+    // identity in load order, rebuild the same lists to compile them
+    std::map<std::tuple<uint32, uint32, int32, uint32>, ConditionList> groupedLists;
+    for (Condition* cond : AllocatedMemoryStore)
+        groupedLists[std::make_tuple(uint32(cond->SourceType), cond->SourceGroup, cond->SourceEntry, cond->SourceId)].push_back(cond);
+
+    for (auto const& [identity, conditions] : groupedLists)
+        AddConditionProgram(conditions);
+
+    LOG_INFO("server.loading", ">> Compiled {} condition programs ({} reference templates) in {} ms", _programs.size(), _referencePrograms.size(), GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
+}
+
+void ConditionMgr::AddConditionProgram(ConditionList const& conditions)
+{
+    if (conditions.empty())
+        return;
+
+    Condition const* front = conditions.front();
+    if (_ambiguousPrograms.find(front) != _ambiguousPrograms.end())
+        return;
+
+    auto itr = _programs.find(front);
+    if (itr != _programs.end())
+    {
+        if (!itr->second.IsCompiledFrom(conditions))
+        {
+            _programs.erase(itr);
+            _ambiguousPrograms.insert(front);
+        }
+
+        return;
+    }
+
+    ConditionProgram program;
+    if (program.Compile(conditions, [this](uint32 referenceId, ConditionProgram const*& reference) { return ResolveReferenceProgram(referenceId, reference); }))
+        _programs.emplace(front, std::move(program));
+}
+
+bool ConditionMgr::ResolveReferenceProgram(uint32 referenceId, ConditionProgram const*& program)
+{
+    program = nullptr;
+
+    if (_unresolvedReferencePrograms.find(referenceId) != _unresolvedReferencePrograms.end())
+        return false;
+
+    auto compiled = _referencePrograms.find(referenceId);
+    if (compiled != _referencePrograms.end())
+    {
+        program = &compiled->second;
+        return true;
+    }
+
+    // missing templates are ignored, same as when interpreting
+    ConditionReferenceContainer::const_iterator ref = ConditionReferenceStore.find(referenceId);
+    if (ref == ConditionReferenceStore.end())
+        return true;
+
+    // stays unresolved if the template references itself through other templates
+    _unresolvedReferencePrograms.insert(referenceId);
+
+    ConditionProgram referenceProgram;
+    if (!referenceProgram.Compile(ref->second, [this](uint32 nestedId, ConditionProgram const*& nested) { return ResolveReferenceProgram(nestedId, nested); }))
+        return false;
+
+    _unresolvedReferencePrograms.erase(referenceId);
+    program = &(_referencePrograms[referenceId] = std::move(referenceProgram));
+    return true;
+}
+
 bool ConditionMgr::CanHaveSourceGroupSet(ConditionSourceType sourceType) const
 {
     return (sourceType == CONDITION_SOURCE_TYPE_CREATURE_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_DISENCHANT_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_FISHING_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_GAMEOBJECT_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_ITEM_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_MAIL_LOOT_TEMPLATE || sourceType == CONDITION_SOURCE_TYPE_MILLING_LOOT_TEMPLATE ||
@@ -1000,20 +1105,19 @@ ConditionList ConditionMgr::GetConditionsForVehicleSpell(uint32 creatureId, uint
     return cond;
 }
 
-ConditionList ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType)
+ConditionList const* ConditionMgr::GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const
 {
-    ConditionList                                cond;
     SmartEventConditionContainer::const_iterator itr = SmartEventConditionStore.find(std::make_pair(entryOrGuid, sourceType));
     if (itr != SmartEventConditionStore.end())
     {
         ConditionTypeContainer::const_iterator i = (*itr).second.find(eventId + 1);
         if (i != (*itr).second.end())
         {
-            cond = (*i).second;
             LOG_DEBUG("condition", "GetConditionsForSmartEvent: found conditions for Smart Event entry or guid {} event_id {}", entryOrGuid, eventId);
+            return &(*i).second;
         }
     }
-    return cond;
+    return nullptr;
 }
 
 ConditionList ConditionMgr::GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId)
@@ -1044,6 +1148,7 @@ void ConditionMgr::LoadConditions(bool isReload)
     uint32 oldMSTime = getMSTime();
 
     Clean();
+    ++_loadGeneration;
 
     // must clear all custom handled cases (groupped types) before reload
     if (isReload)
@@ -1145,13 +1250,7 @@ void ConditionMgr::LoadConditions(bool isReload)
 
         if (iSourceTypeOrReferenceId < 0) // it is a reference template
         {
-            uint32 uRefId = std::abs(iSourceTypeOrReferenceId);
-            if (ConditionReferenceStore.find(uRefId) == ConditionReferenceStore.end()) // make sure we have a list for our conditions, based on reference id
-            {
-                ConditionList mCondList;
-                ConditionReferenceStore[uRefId] = mCondList;
-            }
-            ConditionReferenceStore[uRefId].push_back(cond); // add to reference storage
+            AddToReferenceTemplate(std::abs(iSourceTypeOrReferenceId), cond); // add to reference storage
             count++;
             continue;
         } // end of reference templates
@@ -1314,6 +1413,8 @@ void ConditionMgr::LoadConditions(bool isReload)
 
     LOG_INFO("server.loading", ">> Loaded {} conditions in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
+
+    CompileConditionPrograms();
 }
 
 bool ConditionMgr::addToLootTemplate(Condition* cond, LootTemplate* loot)
@@ -2471,6 +2572,11 @@ bool ConditionMgr::isConditionTypeValid(Condition* cond)
 
 void ConditionMgr::Clean()
 {
+    _programs.clear();
+    _ambiguousPrograms.clear();
+    _referencePrograms.clear();
+    _unresolvedReferencePrograms.clear();
+
     for (ConditionReferenceContainer::iterator itr = ConditionReferenceStore.begin(); itr != ConditionReferenceStore.end(); ++itr)
     {
         for (ConditionList::const_iterator it = itr->second.begin(); it != itr->second.end(); ++it) delete *it;
@@ -18,9 +18,12 @@
 #ifndef ACORE_CONDITIONMGR_H
 #define ACORE_CONDITIONMGR_H
 
+#include "ConditionProgram.h"
 #include "Define.h"
 #include <list>
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 
 class Player;
 class Unit;
@@ -254,6 +257,8 @@ public:
     void LoadConditions(bool isReload = false);
     bool isConditionTypeValid(Condition* cond);
     ConditionList GetConditionReferences(uint32 refId);
+    // Takes ownership of the condition, reference templates are freed when conditions are reloaded
+    void AddToReferenceTemplate(uint32 refId, Condition* cond);
 
     uint32 GetSearcherTypeMaskForConditionList(ConditionList const& conditions);
     bool IsObjectMeetToConditions(WorldObject* object, ConditionList const& conditions);
@@ -263,10 +268,14 @@ public:
     [[nodiscard]] bool CanHaveSourceIdSet(ConditionSourceType sourceType) const;
     ConditionList GetConditionsForNotGroupedEntry(ConditionSourceType sourceType, uint32 entry);
     ConditionList GetConditionsForSpellClickEvent(uint32 creatureId, uint32 spellId);
-    ConditionList GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType);
+    // Returned list stays valid until conditions are reloaded, see GetLoadGeneration
+    ConditionList const* GetConditionsForSmartEvent(int32 entryOrGuid, uint32 eventId, uint32 sourceType) const;
     ConditionList GetConditionsForVehicleSpell(uint32 creatureId, uint32 spellId);
     ConditionList GetConditionsForNpcVendorEvent(uint32 creatureId, uint32 itemId);
 
+    // Incremented every time the condition stores are (re)loaded
+    [[nodiscard]] uint32 GetLoadGeneration() const { return _loadGeneration; }
+
 private:
     bool isSourceTypeValid(Condition* cond);
     bool addToLootTemplate(Condition* cond, LootTemplate* loot);
@@ -275,6 +284,11 @@ private:
     bool addToSpellImplicitTargetConditions(Condition* cond);
     bool IsObjectMeetToConditionList(ConditionSourceInfo& sourceInfo, ConditionList const& conditions);
 
+    void CompileConditionPrograms();
+    void AddConditionProgram(ConditionList const& conditions);
+    bool ResolveReferenceProgram(uint32 referenceId, ConditionProgram const*& program);
+    [[nodiscard]] ConditionProgram const* GetConditionProgram(ConditionList const& conditions) const;
+
     void Clean(); // free up resources
     std::list<Condition*> AllocatedMemoryStore; // some garbage collection :)
 
@@ -284,6 +298,14 @@ private:
     CreatureSpellConditionContainer   SpellClickEventConditionStore;
     NpcVendorConditionContainer       NpcVendorConditionContainerStore;
     SmartEventConditionContainer      SmartEventConditionStore;
+
+    uint32 _loadGeneration = 0;
+
+    // Compiled lists keyed by their first condition, lists sharing it with different content stay interpreted
+    std::unordered_map<Condition const*, ConditionProgram> _programs;
+    std::unordered_set<Condition const*> _ambiguousPrograms;
+    std::unordered_map<uint32, ConditionProgram> _referencePrograms;
+    std::unordered_set<uint32> _unresolvedReferencePrograms;
 };
 
 #define sConditionMgr ConditionMgr::instance()
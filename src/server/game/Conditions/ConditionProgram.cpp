@@ -0,0 +1,78 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConditionProgram.h"
+#include "ConditionMgr.h"
+#include <algorithm>
+
+bool ConditionProgram::Compile(std::list<Condition*> const& conditions, ReferenceResolver const& resolveReference)
+{
+    _instructions.clear();
+    _source.assign(conditions.begin(), conditions.end());
+    _allGroups = 0;
+
+    std::vector<uint32> elseGroups;
+    for (Condition* condition : conditions)
+    {
+        if (!condition->isLoaded())
+            continue;
+
+        auto slot = std::find(elseGroups.begin(), elseGroups.end(), condition->ElseGroup);
+        if (slot == elseGroups.end())
+        {
+            if (elseGroups.size() == MAX_ELSE_GROUPS)
+                return false;
+
+            slot = elseGroups.insert(elseGroups.end(), condition->ElseGroup);
+        }
+
+        Instruction instruction;
+        instruction.Cond = condition;
+        instruction.Reference = nullptr;
+        instruction.Group = uint8(std::distance(elseGroups.begin(), slot));
+        instruction.LastOfGroup = false;
+
+        if (condition->ReferenceId)
+        {
+            instruction.Cond = nullptr;
+            if (!resolveReference(condition->ReferenceId, instruction.Reference))
+                return false;
+        }
+
+        _instructions.push_back(instruction);
+        _allGroups |= uint64(1) << instruction.Group;
+    }
+
+    // a group passes once its last instruction passed without an earlier failure
+    uint64 closedGroups = 0;
+    for (auto itr = _instructions.rbegin(); itr != _instructions.rend(); ++itr)
+    {
+        uint64 const group = uint64(1) << itr->Group;
+        if (!(closedGroups & group))
+        {
+            itr->LastOfGroup = true;
+            closedGroups |= group;
+        }
+    }
+
+    return true;
+}
+
+bool ConditionProgram::IsCompiledFrom(std::list<Condition*> const& conditions) const
+{
+    return conditions.size() == _source.size() && std::equal(conditions.begin(), conditions.end(), _source.begin());
+}
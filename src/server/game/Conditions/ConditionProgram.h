@@ -0,0 +1,99 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_CONDITION_PROGRAM_H
+#define ACORE_CONDITION_PROGRAM_H
+
+#include "Define.h"
+#include <functional>
+#include <list>
+#include <vector>
+
+struct Condition;
+
+/*
+ * Flat form of a condition list, compiled when conditions are loaded.
+ *
+ * Instructions keep the list order; each one knows the dense slot of its else
+ * group and whether it closes that group, so evaluation tracks failed groups in
+ * a bit mask instead of a map, skips conditions of failed groups, stops as soon
+ * as one group passed or all of them failed, and runs reference templates
+ * through their own program instead of looking them up again.
+ */
+class ConditionProgram
+{
+public:
+    // Else groups a program can track, lists with more of them stay interpreted
+    static constexpr uint32 MAX_ELSE_GROUPS = 64;
+
+    // Sets program to the compiled reference template (nullptr if it does not exist),
+    // returns false if the template can not be compiled
+    using ReferenceResolver = std::function<bool(uint32 referenceId, ConditionProgram const*& program)>;
+
+    bool Compile(std::list<Condition*> const& conditions, ReferenceResolver const& resolveReference);
+
+    // Checks that the program was compiled from a list holding the same conditions in the same order
+    [[nodiscard]] bool IsCompiledFrom(std::list<Condition*> const& conditions) const;
+
+    template<class Meets>
+    bool Evaluate(Meets&& meets) const;
+
+private:
+    struct Instruction
+    {
+        Condition* Cond;                    // nullptr for references
+        ConditionProgram const* Reference;  // nullptr for plain conditions and missing reference templates
+        uint8 Group;                        // dense else group slot
+        bool LastOfGroup;
+    };
+
+    std::vector<Instruction> _instructions;
+    std::vector<Condition const*> _source;
+    uint64 _allGroups = 0;
+};
+
+template<class Meets>
+bool ConditionProgram::Evaluate(Meets&& meets) const
+{
+    uint64 failedGroups = 0;
+    for (Instruction const& instruction : _instructions)
+    {
+        uint64 const group = uint64(1) << instruction.Group;
+        if (failedGroups & group)
+            continue;
+
+        bool passed = true; // missing reference templates are ignored
+        if (instruction.Cond)
+            passed = meets(instruction.Cond);
+        else if (instruction.Reference)
+            passed = instruction.Reference->Evaluate(meets);
+
+        if (!passed)
+        {
+            failedGroups |= group;
+            if (failedGroups == _allGroups)
+                return false;
+        }
+        else if (instruction.LastOfGroup)
+            return true;
+    }
+
+    // only reached without any loaded condition
+    return false;
+}
+
+#endif
@@ -167,6 +167,7 @@ bool DisableMgr::HandleDisableType(DisableType type, uint32 entry, uint8 flags,
         {
             SpellInfo* spellInfo = const_cast<SpellInfo*>(sSpellMgr->GetSpellInfo(entry));
             spellInfo->AttributesEx2 |= SPELL_ATTR2_IGNORE_LINE_OF_SIGHT;
+            sSpellMgr->UpdateSpellInfoHotData(spellInfo);
         }
 
         break;
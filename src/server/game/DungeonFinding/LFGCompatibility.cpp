@@ -0,0 +1,98 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LFGCompatibility.h"
+#include <array>
+
+namespace lfg
+{
+    namespace
+    {
+        constexpr uint64 SUM_BYTES = 0x0101010101010101;
+
+        // Role combinations index the bytes of the counts: bit 0 tank, bit 1 healer, bit 2 damage
+        constexpr uint8 GetRoleIndex(uint8 roles)
+        {
+            return (roles >> 1) & 7;
+        }
+
+        struct RoleSlots
+        {
+            uint64 countMask;                                  // bytes of the combinations using only these roles
+            uint8 capacity;                                    // slots of these roles in a group
+        };
+
+        constexpr std::array<RoleSlots, 8> MakeRoleSlots()
+        {
+            std::array<RoleSlots, 8> slots = { };
+            for (uint8 roles = 0; roles < 8; ++roles)
+            {
+                for (uint8 combination = 0; combination < 8; ++combination)
+                    if (!(combination & ~roles))
+                        slots[roles].countMask |= uint64(0xFF) << (combination * 8);
+
+                slots[roles].capacity = ((roles & 1) ? LFG_TANKS_NEEDED : 0) + ((roles & 2) ? LFG_HEALERS_NEEDED : 0) + ((roles & 4) ? LFG_DPS_NEEDED : 0);
+            }
+
+            return slots;
+        }
+
+        constexpr std::array<RoleSlots, 8> ROLE_SLOTS = MakeRoleSlots();
+    }
+
+    LfgCompatibilityData::LfgCompatibilityData() : _roleCounts(0), _allDungeonsInMask(true)
+    {
+        _dungeons.set();
+    }
+
+    LfgCompatibilityData::LfgCompatibilityData(LfgDungeonSet const& dungeons, LfgRolesMap const& roles) : _roleCounts(0), _allDungeonsInMask(true)
+    {
+        for (uint32 dungeonId : dungeons)
+        {
+            if (dungeonId < LFG_DUNGEON_MASK_SIZE)
+                _dungeons.set(dungeonId);
+            else
+                _allDungeonsInMask = false;
+        }
+
+        for (LfgRolesMap::const_iterator itr = roles.begin(); itr != roles.end(); ++itr)
+            _roleCounts += uint64(1) << (GetRoleIndex(itr->second) * 8);
+    }
+
+    void LfgCompatibilityData::Add(LfgCompatibilityData const& other)
+    {
+        // a group has at most MAXGROUPSIZE players in up to 5 entries, no byte overflows
+        _dungeons &= other._dungeons;
+        _roleCounts += other._roleCounts;
+        _allDungeonsInMask = _allDungeonsInMask && other._allDungeonsInMask;
+    }
+
+    uint8 LfgCompatibilityData::GetPlayers() const
+    {
+        return uint8((_roleCounts * SUM_BYTES) >> 56);
+    }
+
+    bool LfgCompatibilityData::CanFillRoles() const
+    {
+        // Hall's condition: the players limited to any set of roles must fit in the slots of those roles
+        for (RoleSlots const& slots : ROLE_SLOTS)
+            if (((_roleCounts & slots.countMask) * SUM_BYTES) >> 56 > slots.capacity)
+                return false;
+
+        return true;
+    }
+}
@@ -0,0 +1,63 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _LFGCOMPATIBILITY_H
+#define _LFGCOMPATIBILITY_H
+
+#include "LFG.h"
+#include <bitset>
+
+namespace lfg
+{
+    enum LfgCompatibilityDataEnum
+    {
+        LFG_DUNGEON_MASK_SIZE                        = 512     // LFGDungeons.dbc ids, selections with higher ids skip the dungeon pre-check
+    };
+
+    using LfgDungeonMask = std::bitset<LFG_DUNGEON_MASK_SIZE>;
+
+    /*
+     * Fixed size summary of the dungeons and roles of a queue entry.
+     *
+     * Summaries of the members of a candidate group combine with a bitset AND
+     * and a single add, which rejects most combinations before the ignore,
+     * role assignment and dungeon checks that work on maps and sets.
+     */
+    class LfgCompatibilityData
+    {
+    public:
+        LfgCompatibilityData();
+        LfgCompatibilityData(LfgDungeonSet const& dungeons, LfgRolesMap const& roles);
+
+        void Add(LfgCompatibilityData const& other);
+
+        [[nodiscard]] uint8 GetPlayers() const;
+
+        // Whether every player can take a different slot of 1 tank, 1 healer and 3 damage dealers, same answer as LFGMgr::CheckGroupRoles
+        [[nodiscard]] bool CanFillRoles() const;
+
+        // False only if the dungeon selections surely have nothing in common
+        [[nodiscard]] bool MayHaveCommonDungeon() const { return !_allDungeonsInMask || _dungeons.any(); }
+
+    private:
+        LfgDungeonMask _dungeons;
+        uint64 _roleCounts;                                    // players per tank/healer/damage combination, one byte each
+        bool _allDungeonsInMask;
+    };
+}
+
+#endif
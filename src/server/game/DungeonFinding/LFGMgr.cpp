@@ -333,14 +333,10 @@ namespace lfg
         else if (task == 1)
         {
             this->lastProposalId = m_lfgProposalId; // pussywizard: task 2 is done independantly, store previous value in LFGMgr for future use
-            uint8 newGroupsProcessed = 0;
+            uint32 newGroupsProcessed = 0;
             // Check if a proposal can be formed with the new groups being added
             for (LfgQueueContainer::iterator it = QueuesStore.begin(); it != QueuesStore.end(); ++it)
-            {
                 newGroupsProcessed += it->second.FindGroups();
-                if (newGroupsProcessed)
-                    break;
-            }
 
             // Update all players status queue info
             if (!newGroupsProcessed) // don't do this on updates that precessed groups (performance)
@@ -351,10 +347,11 @@ namespace lfg
         {
             if (lastProposalId != m_lfgProposalId)
             {
-                // pussywizard: only one proposal can be created in World::Update (during maps update), and it has id == m_lfgProposalId, so try to find only that one, dunno why for loop here xD
-                for (LfgProposalContainer::const_iterator itProposal = ProposalsStore.find(m_lfgProposalId); itProposal != ProposalsStore.end(); ++itProposal)
+                // every proposal created during maps update, their ids follow lastProposalId
+                for (LfgProposalContainer::const_iterator itProposal = ProposalsStore.upper_bound(lastProposalId); itProposal != ProposalsStore.end();)
                 {
                     uint32 proposalId = itProposal->first;
+                    ++itProposal; // UpdateProposal may remove this proposal
                     LfgProposal& proposal = ProposalsStore[proposalId];
 
                     ObjectGuid guid;
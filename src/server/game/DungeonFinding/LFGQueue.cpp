@@ -149,12 +149,35 @@ namespace lfg
     void LFGQueue::RemoveFromCompatibles(ObjectGuid guid)
     {
         LOG_DEBUG("lfg", "COMPATIBLES REMOVE for: {}", guid.ToString());
-        for (LfgCompatibleContainer::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
-            if (it->hasGuid(guid))
+        LfgCompatibleIndex::iterator itIndex = CompatibleIndex.find(guid);
+        if (itIndex != CompatibleIndex.end())
+        {
+            std::vector<LfgCompatibleContainer::iterator> compatibles = std::move(itIndex->second);
+            CompatibleIndex.erase(itIndex);
+
+            for (LfgCompatibleContainer::iterator it : compatibles)
             {
                 LOG_DEBUG("lfg", "Removed Compatible: {}, because of: {}", it->toString(), guid.ToString());
+
+                // the other members keep their index entries, drop this compatible from them
+                for (uint8 i = 0; i < 5 && it->guids[i]; ++i)
+                {
+                    if (it->guids[i] == guid)
+                        continue;
+
+                    LfgCompatibleIndex::iterator itOther = CompatibleIndex.find(it->guids[i]);
+                    if (itOther == CompatibleIndex.end())
+                        continue;
+
+                    std::erase(itOther->second, it);
+                    if (itOther->second.empty())
+                        CompatibleIndex.erase(itOther);
+                }
+
                 it->clear(); // set to 0, this will be removed while iterating in FindNewGroups
             }
+        }
+
         for (LfgCompatibleContainer::iterator itr = CompatibleTempList.begin(); itr != CompatibleTempList.end(); )
         {
             LfgCompatibleContainer::iterator it = itr++;
@@ -172,11 +195,19 @@ namespace lfg
         CompatibleTempList.push_back(key);
     }
 
-    uint8 LFGQueue::FindGroups()
+    void LFGQueue::AddToCompatibleIndex(LfgCompatibleContainer::iterator itr)
+    {
+        for (uint8 i = 0; i < 5 && itr->guids[i]; ++i)
+            CompatibleIndex[itr->guids[i]].push_back(itr);
+    }
+
+    uint32 LFGQueue::FindGroups()
     {
         LOG_DEBUG("lfg", "FIND GROUPS!");
-        uint8 newGroupsProcessed = 0;
-        if (!newToQueueStore.empty())
+        uint32 newGroupsProcessed = 0;
+
+        // everyone waiting when the update started, proposals take their members off the list on the way
+        for (std::size_t pending = newToQueueStore.size(); pending && !newToQueueStore.empty(); --pending)
         {
             ++newGroupsProcessed;
             ObjectGuid newGuid = newToQueueStore.front();
@@ -186,11 +217,14 @@ namespace lfg
 
             FindNewGroups(newGuid);
 
+            // splice keeps the iterators valid
+            for (LfgCompatibleContainer::iterator itr = CompatibleTempList.begin(); itr != CompatibleTempList.end(); ++itr)
+                AddToCompatibleIndex(itr);
+
             CompatibleList.splice((pushCompatiblesToFront ? CompatibleList.begin() : CompatibleList.end()), CompatibleTempList);
             CompatibleTempList.clear();
-
-            return newGroupsProcessed; // pussywizard: only one per update, shouldn't be a problem
         }
+
         return newGroupsProcessed;
     }
 
@@ -206,8 +240,9 @@ namespace lfg
         // we have to take into account that FindNewGroups is called every X minutes if number of compatibles is low!
         // build set of already present compatibles for this guid
         std::set<Lfg5Guids> currentCompatibles;
-        for (Lfg5GuidsList::iterator it = CompatibleList.begin(); it != CompatibleList.end(); ++it)
-            if (it->hasGuid(newGuid))
+        LfgCompatibleIndex::const_iterator itIndex = CompatibleIndex.find(newGuid);
+        if (itIndex != CompatibleIndex.end())
+            for (LfgCompatibleContainer::iterator it : itIndex->second)
             {
                 // unset roles here so they are not copied, restore after insertion
                 LfgRolesMap* r = it->roles;
@@ -264,6 +299,7 @@ namespace lfg
         uint8 numLfgGroups = 0;
         ObjectGuid guid;
         uint64 addToFoundMask = 0;
+        LfgCompatibilityData compatibility;
 
         for (uint8 i = 0; i < 5 && !(guid = check.guids[i]).IsEmpty() && numLfgGroups < 2 && numPlayers <= MAXGROUPSIZE; ++i)
         {
@@ -280,6 +316,7 @@ namespace lfg
                 proposalGroups[it2->first] = itQueue->first.IsGroup() ? itQueue->first : ObjectGuid::Empty;
 
             numPlayers += itQueue->second.roles.size();
+            compatibility.Add(itQueue->second.compatibility);
 
             if (sLFGMgr->IsLfgGroup(guid))
             {
@@ -313,6 +350,13 @@ namespace lfg
         // If it's single group no need to check for duplicate players, ignores, bad roles or bad dungeons as it's been checked before joining
         if (check.size() > 1)
         {
+            // packed pre-check, most combinations fail here without walking the role maps and dungeon sets
+            if (!compatibility.CanFillRoles())
+                return LFG_INCOMPATIBLES_NO_ROLES;
+
+            if (!compatibility.MayHaveCommonDungeon())
+                return LFG_INCOMPATIBLES_NO_DUNGEONS;
+
             for (uint8 i = 0; i < 5 && check.guids[i]; ++i)
             {
                 const LfgRolesMap& roles = QueueDataStore[check.guids[i]].roles;
@@ -573,14 +617,14 @@ namespace lfg
 
     uint32 LFGQueue::FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue)
     {
-        uint32 numOfCompatibles = 0;
-        for (LfgCompatibleContainer::const_iterator itr = CompatibleList.begin(); itr != CompatibleList.end(); ++itr)
-            if (itr->hasGuid(itrQueue->first))
-            {
-                ++numOfCompatibles;
-                UpdateBestCompatibleInQueue(itrQueue, *itr);
-            }
-        return numOfCompatibles;
+        LfgCompatibleIndex::const_iterator itIndex = CompatibleIndex.find(itrQueue->first);
+        if (itIndex == CompatibleIndex.end())
+            return 0;
+
+        for (LfgCompatibleContainer::iterator itr : itIndex->second)
+            UpdateBestCompatibleInQueue(itrQueue, *itr);
+
+        return itIndex->second.size();
     }
 
     void LFGQueue::UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, Lfg5Guids const& key)
@@ -19,6 +19,9 @@
 #define _LFGQUEUE_H
 
 #include "LFG.h"
+#include "LFGCompatibility.h"
+#include <unordered_map>
+#include <vector>
 
 namespace lfg
 {
@@ -42,7 +45,7 @@ namespace lfg
 
         LfgQueueData(time_t _joinTime, LfgDungeonSet  _dungeons, LfgRolesMap  _roles):
             joinTime(_joinTime), lastRefreshTime(_joinTime), tanks(LFG_TANKS_NEEDED), healers(LFG_HEALERS_NEEDED),
-            dps(LFG_DPS_NEEDED), dungeons(std::move(_dungeons)), roles(std::move(_roles))
+            dps(LFG_DPS_NEEDED), dungeons(std::move(_dungeons)), roles(std::move(_roles)), compatibility(dungeons, roles)
         { }
 
         time_t joinTime;                                       // Player queue join time (to calculate wait times)
@@ -52,6 +55,7 @@ namespace lfg
         uint8 dps{LFG_DPS_NEEDED};                             // Dps needed
         LfgDungeonSet dungeons;                                // Selected Player/Group Dungeon/s
         LfgRolesMap roles;                                     // Selected Player Role/s
+        LfgCompatibilityData compatibility;                    // Packed dungeons and roles for the compatibility pre-check
         Lfg5Guids bestCompatible;                              // Best compatible combination of people queued
     };
 
@@ -65,6 +69,7 @@ namespace lfg
     using LfgWaitTimesContainer = std::map<uint32, LfgWaitTime>;
     using LfgQueueDataContainer = std::map<ObjectGuid, LfgQueueData>;
     using LfgCompatibleContainer = std::list<Lfg5Guids>;
+    using LfgCompatibleIndex = std::unordered_map<ObjectGuid, std::vector<LfgCompatibleContainer::iterator>>;
     /**
         Stores all data related to queue
     */
@@ -88,7 +93,7 @@ namespace lfg
         time_t GetJoinTime(ObjectGuid guid);
 
         // Find new group
-        uint8 FindGroups();
+        uint32 FindGroups();
 
     private:
         void SetQueueUpdateData(std::string const& strGuids, LfgRolesMap const& proposalRoles);
@@ -98,6 +103,7 @@ namespace lfg
 
         void RemoveFromCompatibles(ObjectGuid guid);
         void AddToCompatibles(Lfg5Guids const& key);
+        void AddToCompatibleIndex(LfgCompatibleContainer::iterator itr);
 
         uint32 FindBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue);
         void UpdateBestCompatibleInQueue(LfgQueueDataContainer::iterator itrQueue, Lfg5Guids const& key);
@@ -110,6 +116,7 @@ namespace lfg
         LfgQueueDataContainer QueueDataStore;              // Queued groups
         LfgCompatibleContainer CompatibleList;             // Compatible dungeons
         LfgCompatibleContainer CompatibleTempList;         // new compatibles are added to this container while main one is being iterated
+        LfgCompatibleIndex CompatibleIndex;                // Entries of CompatibleList each queued guid is part of
 
         LfgWaitTimesContainer waitTimesAvgStore;           // Average wait time to find a group queuing as multiple roles
         LfgWaitTimesContainer waitTimesTankStore;          // Average wait time to find a group queuing as tank
@@ -269,6 +269,8 @@ bool TemporaryThreatModifierEvent::Execute(uint64 /*e_time*/, uint32 /*p_time*/)
     return true;
 }
 
+ACORE_DEFINE_SLAB_POOLED_CLASS(Creature)
+
 Creature::Creature(bool isWorldObject): Unit(isWorldObject), MovableMapObject(), m_groupLootTimer(0), lootingGroupLowGUID(0), m_lootRecipientGroup(0),
     m_corpseRemoveTime(0), m_respawnTime(0), m_respawnDelay(300), m_corpseDelay(60), m_wanderDistance(0.0f), m_boundaryCheckTime(2500),
     m_transportCheckTimer(1000), lootPickPocketRestoreTime(0), m_combatPulseTime(0), m_combatPulseDelay(0), m_reactState(REACT_AGGRESSIVE), m_defaultMovementType(IDLE_MOTION_TYPE),
@@ -300,6 +302,9 @@ Creature::Creature(bool isWorldObject): Unit(isWorldObject), MovableMapObject(),
     _focusSpell = nullptr;
 
     m_respawnedTime = time_t(0);
+
+    // events added by spells or scripts have to run on time, also while the map lets the creature sleep
+    m_Events.SetEventAddedHandler([this]() { WakeMapUpdate(); });
 }
 
 Creature::~Creature()
@@ -1972,6 +1977,9 @@ void Creature::setDeathState(DeathState state, bool despawn)
 {
     Unit::setDeathState(state, despawn);
 
+    // the map may be skipping the creature until its respawn
+    WakeMapUpdate();
+
     if (state == DeathState::JustDied)
     {
         m_corpseRemoveTime = GameTime::GetGameTime().count() + m_corpseDelay;
@@ -3802,6 +3810,7 @@ bool Creature::CanGeneratePickPocketLoot() const
 void Creature::SetRespawnTime(uint32 respawn)
 {
     m_respawnTime = respawn ? GameTime::GetGameTime().count() + respawn : 0;
+    WakeMapUpdate();
 }
 
 void Creature::SetCorpseRemoveTime(uint32 delay)
@@ -3916,3 +3925,67 @@ bool Creature::IsUpdateNeeded()
 
     return false;
 }
+
+MapUpdateKind Creature::ComputeMapUpdateKind() const
+{
+    if (m_deathState != DeathState::Alive)
+        return MapUpdateKind::Dead;
+
+    if (IsInCombat())
+        return MapUpdateKind::Combat;
+
+    if (HasUnitState(UNIT_STATE_MOVING) || isMoving())
+        return MapUpdateKind::Moving;
+
+    return MapUpdateKind::Idle;
+}
+
+bool Creature::CanSleep()
+{
+    // scripted AIs derive from the core ones and keep their own timers
+    if (!IsAIEnabled || !AI()->CanSleep() || GetScriptId() || !GetAIName().empty() || TriggerJustRespawned || NeedChangeAI)
+        return false;
+
+    if (!IsAlive() || IsInCombat() || IsInEvadeMode() || GetVictim())
+        return false;
+
+    // summons count down their lifetime in their updates
+    if (IsSummon() || isActiveObject() || IsVisibilityOverridden() || GetCharmerOrOwnerGUID() || GetTransport() || m_vehicleKit)
+        return false;
+
+    // anything an update still has to advance keeps the creature awake
+    if (m_assistanceTimer || m_delayed_unit_relocation_timer || m_delayed_unit_ai_notify_timer || !m_Events.Empty() || !m_gameObj.empty())
+        return false;
+
+    if (GetMotionMaster()->GetCurrentMovementGeneratorType() != IDLE_MOTION_TYPE || HasUnitState(UNIT_STATE_MOVING) || isMoving() || !movespline->Finalized())
+        return false;
+
+    for (Spell* spell : m_currentSpells)
+        if (spell)
+            return false;
+
+    if (GetHealth() < GetMaxHealth() || GetPower(getPowerType()) < GetMaxPower(getPowerType()))
+        return false;
+
+    for (auto const& [spellId, aura] : m_ownedAuras)
+    {
+        if (!aura->IsPermanent())
+            return false;
+
+        for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
+            if (AuraEffect const* effect = aura->GetEffect(i))
+                if (effect->IsPeriodic())
+                    return false;
+    }
+
+    return true;
+}
+
+time_t Creature::GetMapUpdateSleepTime() const
+{
+    // dead creatures only wait for their respawn, pets of players keep checking for transports
+    if (m_deathState != DeathState::Dead || GetOwnerGUID().IsPlayer())
+        return 0;
+
+    return m_respawnTime;
+}
@@ -23,6 +23,7 @@
 #include "Common.h"
 #include "CreatureData.h"
 #include "LootMgr.h"
+#include "SlabPool.h"
 #include "Unit.h"
 #include <list>
 
@@ -45,6 +46,8 @@ public:
     explicit Creature(bool isWorldObject = false);
     ~Creature() override;
 
+    ACORE_SLAB_POOLED_CLASS;
+
     void AddToWorld() override;
     void RemoveFromWorld() override;
 
@@ -438,6 +441,18 @@ public:
 
     bool IsUpdateNeeded() override;
 
+    [[nodiscard]] MapUpdateKind ComputeMapUpdateKind() const;
+    // Whether the creature has nothing to do until something wakes it, see Map::UpdateNonPlayerObjects
+    [[nodiscard]] bool CanSleep();
+    // Game time until which the map can skip updating the creature, 0 if it needs every update
+    [[nodiscard]] time_t GetMapUpdateSleepTime() const;
+    // Requests the cache lines Update() starts with, called by the map a few objects ahead
+    void PrefetchUpdateData() const
+    {
+        ACORE_PREFETCH(this);
+        ACORE_PREFETCH(&m_deathState);
+    }
+
 protected:
     bool CreateFromProto(ObjectGuid::LowType guidlow, uint32 Entry, uint32 vehId, const CreatureData* data = nullptr);
     bool InitEntry(uint32 entry, const CreatureData* data = nullptr);
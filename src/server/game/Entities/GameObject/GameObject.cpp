@@ -38,6 +38,8 @@
 #include <G3D/CoordinateFrame.h>
 #include <G3D/Quat.h>
 
+ACORE_DEFINE_SLAB_POOLED_CLASS(GameObject)
+
 GameObject::GameObject() : WorldObject(false), MovableMapObject(),
     m_model(nullptr), m_goValue(), m_AI(nullptr)
 {
@@ -2599,6 +2601,9 @@ void GameObject::EnableCollision(bool enable)
         phaseMask = GetPhaseMask();
 
     m_model->enable(phaseMask);
+
+    if (IsInWorld())
+        GetMap()->InvalidateCollisionCache(*m_model);
 }
 
 void GameObject::UpdateModel()
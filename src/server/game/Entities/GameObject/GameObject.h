@@ -24,6 +24,7 @@
 #include "LootMgr.h"
 #include "Object.h"
 #include "SharedDefines.h"
+#include "SlabPool.h"
 #include "Unit.h"
 
 class GameObjectAI;
@@ -120,6 +121,8 @@ public:
     explicit GameObject();
     ~GameObject() override;
 
+    ACORE_SLAB_POOLED_CLASS;
+
     void BuildValuesUpdate(uint8 updateType, ByteBuffer* data, Player* target) override;
 
     void AddToWorld() override;
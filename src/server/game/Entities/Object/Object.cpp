@@ -21,7 +21,9 @@
 #include "CellImpl.h"
 #include "Chat.h"
 #include "Creature.h"
+#include "DBCStores.h"
 #include "DynamicVisibility.h"
+#include "GameObject.h"
 #include "GameObjectAI.h"
 #include "GameTime.h"
 #include "GridNotifiers.h"
@@ -97,6 +99,8 @@ WorldObject::~WorldObject()
         }
         ResetMap();
     }
+
+    RemoveFromSpatialIndex();
 }
 
 Object::~Object()
@@ -1382,6 +1386,54 @@ bool WorldObject::IsWithinLOSInMap(WorldObject const* obj, VMAP::ModelIgnoreFlag
     return GetMap()->isInLineOfSight(x, y, z, ox, oy, oz, GetPhaseMask(), checks, ignoreFlags);
 }
 
+void WorldObject::IsWithinLOSInMap(std::vector<WorldObject const*> const& objs, std::vector<bool>& results, VMAP::ModelIgnoreFlags ignoreFlags, LineOfSightChecks checks) const
+{
+    results.assign(objs.size(), false);
+
+    // the rays of other objects start at the hit sphere point facing each target
+    if (!IsPlayer())
+    {
+        for (std::size_t i = 0; i < objs.size(); ++i)
+            results[i] = IsWithinLOSInMap(objs[i], ignoreFlags, checks);
+        return;
+    }
+
+    float x, y, z;
+    GetPosition(x, y, z);
+    z += GetCollisionHeight();
+
+    std::vector<G3D::Vector3> targets;
+    std::vector<std::size_t> indices;
+    targets.reserve(objs.size());
+    indices.reserve(objs.size());
+    for (std::size_t i = 0; i < objs.size(); ++i)
+    {
+        WorldObject const* obj = objs[i];
+        if (!IsInMap(obj))
+            continue;
+
+        float ox, oy, oz;
+        if (obj->IsPlayer())
+        {
+            obj->GetPosition(ox, oy, oz);
+            oz += obj->GetCollisionHeight();
+        }
+        else
+            obj->GetHitSpherePointFor({ x, y, z }, ox, oy, oz);
+
+        targets.emplace_back(ox, oy, oz);
+        indices.push_back(i);
+    }
+
+    if (targets.empty())
+        return;
+
+    std::vector<bool> inSight;
+    GetMap()->isInLineOfSight(x, y, z, targets, inSight, GetPhaseMask(), checks, ignoreFlags);
+    for (std::size_t i = 0; i < indices.size(); ++i)
+        results[indices[i]] = inSight[i];
+}
+
 void WorldObject::GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z, Optional<float> collisionHeight, Optional<float> combatReach) const
 {
     Position pos = GetHitSpherePointFor(dest, collisionHeight, combatReach);
@@ -2511,6 +2563,13 @@ void WorldObject::GetGameObjectListWithEntryInGrid(std::list<GameObject*>& gameo
     Cell::VisitGridObjects(this, searcher, maxSearchRange);
 }
 
+void WorldObject::GetGameObjectListWithEntryInGrid(Acore::ScratchVector<GameObject*>& gameobjectList, uint32 entry, float maxSearchRange) const
+{
+    Acore::AllGameObjectsWithEntryInRange check(this, entry, maxSearchRange);
+    Acore::GameObjectListSearcher<Acore::AllGameObjectsWithEntryInRange> searcher(this, gameobjectList, check);
+    Cell::VisitGridObjects(this, searcher, maxSearchRange);
+}
+
 void WorldObject::GetGameObjectListWithEntryInGrid(std::list<GameObject*>& gameobjectList, std::vector<uint32> const& entries, float maxSearchRange) const
 {
     Acore::AllGameObjectsMatchingOneEntryInRange check(this, entries, maxSearchRange);
@@ -2525,6 +2584,13 @@ void WorldObject::GetCreatureListWithEntryInGrid(std::list<Creature*>& creatureL
     Cell::VisitGridObjects(this, searcher, maxSearchRange);
 }
 
+void WorldObject::GetCreatureListWithEntryInGrid(Acore::ScratchVector<Creature*>& creatureList, uint32 entry, float maxSearchRange) const
+{
+    Acore::AllCreaturesOfEntryInRange check(this, entry, maxSearchRange);
+    Acore::CreatureListSearcher<Acore::AllCreaturesOfEntryInRange> searcher(this, creatureList, check);
+    Cell::VisitGridObjects(this, searcher, maxSearchRange);
+}
+
 void WorldObject::GetCreatureListWithEntryInGrid(std::list<Creature*>& creatureList, std::vector<uint32> const& entries, float maxSearchRange) const
 {
     Acore::AllCreaturesMatchingOneEntryInRange check(this, entries, maxSearchRange);
@@ -2801,6 +2867,41 @@ void WorldObject::GetChargeContactPoint(WorldObject const* obj, float& x, float&
     return (m_valuesCount > UNIT_FIELD_COMBATREACH) ? m_floatValues[UNIT_FIELD_COMBATREACH] : DEFAULT_WORLD_OBJECT_SIZE * GetObjectScale();
 }
 
+uint32 WorldObject::GetGridMapTypeMask() const
+{
+    switch (GetTypeId())
+    {
+        case TYPEID_UNIT:
+            return GRID_MAP_TYPE_MASK_CREATURE;
+        case TYPEID_PLAYER:
+            return GRID_MAP_TYPE_MASK_PLAYER;
+        case TYPEID_GAMEOBJECT:
+            return GRID_MAP_TYPE_MASK_GAMEOBJECT;
+        case TYPEID_DYNAMICOBJECT:
+            return GRID_MAP_TYPE_MASK_DYNAMICOBJECT;
+        case TYPEID_CORPSE:
+            return GRID_MAP_TYPE_MASK_CORPSE;
+        default:
+            return 0;
+    }
+}
+
+float WorldObject::GetSpatialIndexRadius() const
+{
+    // gameobjects are found by their model bounds, see GameObject::IsInRange
+    if (GameObject const* go = ToGameObject())
+    {
+        if (GameObjectDisplayInfoEntry const* info = sGameObjectDisplayInfoStore.LookupEntry(go->GetGOInfo()->displayId))
+        {
+            float const x = std::max(std::fabs(info->minX), std::fabs(info->maxX));
+            float const y = std::max(std::fabs(info->minY), std::fabs(info->maxY));
+            return std::max(GetObjectSize(), std::sqrt(x * x + y * y) * GetObjectScale());
+        }
+    }
+
+    return GetObjectSize();
+}
+
 void WorldObject::MovePosition(Position& pos, float dist, float angle)
 {
     angle += GetOrientation();
@@ -3244,6 +3345,12 @@ bool WorldObject::IsUpdateNeeded()
     return false;
 }
 
+void WorldObject::WakeMapUpdate()
+{
+    if (m_currMap)
+        m_currMap->WakeUpdatableObject(this);
+}
+
 bool WorldObject::CanBeAddedToMapUpdateList()
 {
     switch (GetTypeId())
@@ -31,6 +31,7 @@
 #include "ObjectGuid.h"
 #include "Optional.h"
 #include "Position.h"
+#include "ScratchArena.h"
 #include "UpdateData.h"
 #include "UpdateMask.h"
 #include <memory>
@@ -359,7 +360,7 @@ class GridObject
 public:
     [[nodiscard]] bool IsInGrid() const { return _gridRef.isValid(); }
     void AddToGrid(GridRefMgr<T>& m) { ASSERT(!IsInGrid()); _gridRef.link(&m, (T*)this); }
-    void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); }
+    void RemoveFromGrid() { ASSERT(IsInGrid()); _gridRef.unlink(); static_cast<T*>(this)->RemoveFromSpatialIndex(); }
 private:
     GridReference<T> _gridRef;
 };
@@ -422,11 +423,30 @@ public:
     {
         NotUpdating,
         PendingAdd,
-        Updating
+        Updating,
+        Sleeping    // out of the update list until the wake time or a wake event
     };
 
+    [[nodiscard]] bool IsMapUpdateSleeping() const { return _mapUpdateState == Sleeping; }
+
 protected:
-    UpdatableMapObject() : _mapUpdateListOffset(0), _mapUpdateState(NotUpdating) { }
+    UpdatableMapObject() : _mapUpdateListOffset(0), _mapUpdateState(NotUpdating), _mapUpdateKind(MapUpdateKind::Other), _mapWakeTime(0ms), _mapSleepStart(0ms) { }
+
+    void SetMapSleepStart(Milliseconds time)
+    {
+        _mapSleepStart = time;
+    }
+
+    // the first update after sleeping covers all the time since the last update, so timers keep their pace
+    uint32 TakeMapUpdateDiff(uint32 diff, Milliseconds now)
+    {
+        if (_mapSleepStart == 0ms)
+            return diff;
+
+        uint32 const slept = uint32((now - _mapSleepStart).count());
+        _mapSleepStart = 0ms;
+        return std::max(diff, slept);
+    }
 
 private:
     void SetMapUpdateListOffset(std::size_t const offset)
@@ -451,9 +471,33 @@ private:
         return _mapUpdateState;
     }
 
+    void SetMapUpdateKind(MapUpdateKind kind)
+    {
+        _mapUpdateKind = kind;
+    }
+
+    MapUpdateKind GetMapUpdateKind() const
+    {
+        return _mapUpdateKind;
+    }
+
+    void SetMapWakeTime(Milliseconds time)
+    {
+        _mapWakeTime = time;
+    }
+
+    Milliseconds GetMapWakeTime() const
+    {
+        ASSERT(_mapUpdateState == Sleeping, "Attempted to get wake time when object is not sleeping");
+        return _mapWakeTime;
+    }
+
 private:
     std::size_t _mapUpdateListOffset;
     UpdateState _mapUpdateState;
+    MapUpdateKind _mapUpdateKind; // update list the object is stored in
+    Milliseconds _mapWakeTime;
+    Milliseconds _mapSleepStart; // game time of the last update before sleeping
 };
 
 class WorldObject : public Object, public WorldLocation
@@ -533,6 +577,8 @@ public:
     bool IsWithinDistInMap(WorldObject const* obj, float dist2compare, bool is3D = true, bool useBoundingRadius = true) const;
     [[nodiscard]] bool IsWithinLOS(float x, float y, float z, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS) const;
     [[nodiscard]] bool IsWithinLOSInMap(WorldObject const* obj, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS, Optional<float> collisionHeight = { }, Optional<float> combatReach = { }) const;
+    // results[i] holds IsWithinLOSInMap(objs[i]), checked as one batch when this is a player
+    void IsWithinLOSInMap(std::vector<WorldObject const*> const& objs, std::vector<bool>& results, VMAP::ModelIgnoreFlags ignoreFlags = VMAP::ModelIgnoreFlags::Nothing, LineOfSightChecks checks = LINEOFSIGHT_ALL_CHECKS) const;
     [[nodiscard]] Position GetHitSpherePointFor(Position const& dest, Optional<float> collisionHeight = { }, Optional<float> combatReach = { }) const;
     void GetHitSpherePointFor(Position const& dest, float& x, float& y, float& z, Optional<float> collisionHeight = { }, Optional<float> combatReach = { }) const;
     bool GetDistanceOrder(WorldObject const* obj1, WorldObject const* obj2, bool is3D = true) const;
@@ -587,6 +633,13 @@ public:
     [[nodiscard]] Map* FindMap() const { return m_currMap; }
     //used to check all object's GetMap() calls when object is not in world!
 
+    // Entry in the spatial index of the map, added by the map together with the grid cell
+    [[nodiscard]] SpatialIndexSlot& GetSpatialIndexSlot() { return m_spatialIndexSlot; }
+    [[nodiscard]] uint32 GetGridMapTypeMask() const;
+    [[nodiscard]] float GetSpatialIndexRadius() const;
+    void UpdateSpatialIndex() { if (m_spatialIndexSlot.Index) m_spatialIndexSlot.Index->Move(m_spatialIndexSlot, GetPositionX(), GetPositionY(), GetSpatialIndexRadius()); }
+    void RemoveFromSpatialIndex() { MapSpatialIndex::Remove(m_spatialIndexSlot); }
+
     void SetZoneScript();
     void ClearZoneScript();
     [[nodiscard]] ZoneScript* GetZoneScript() const { return m_zoneScript; }
@@ -603,8 +656,10 @@ public:
 
     [[nodiscard]] Player* SelectNearestPlayer(float distance = 0) const;
     void GetGameObjectListWithEntryInGrid(std::list<GameObject*>& lList, uint32 uiEntry, float fMaxSearchRange) const;
+    void GetGameObjectListWithEntryInGrid(Acore::ScratchVector<GameObject*>& gameobjectList, uint32 entry, float maxSearchRange) const;
     void GetGameObjectListWithEntryInGrid(std::list<GameObject*>& gameobjectList, std::vector<uint32> const& entries, float maxSearchRange) const;
     void GetCreatureListWithEntryInGrid(std::list<Creature*>& lList, uint32 uiEntry, float fMaxSearchRange) const;
+    void GetCreatureListWithEntryInGrid(Acore::ScratchVector<Creature*>& creatureList, uint32 entry, float maxSearchRange) const;
     void GetCreatureListWithEntryInGrid(std::list<Creature*>& creatureList, std::vector<uint32> const& entries, float maxSearchRange) const;
     void GetDeadCreatureListInGrid(std::list<Creature*>& lList, float maxSearchRange, bool alive = false) const;
 
@@ -685,6 +740,8 @@ public:
     void RemoveAllowedLooter(ObjectGuid guid);
 
     virtual bool IsUpdateNeeded();
+    // Updates the object on the next map update, even if it sleeps or is skipped until later
+    void WakeMapUpdate();
     bool CanBeAddedToMapUpdateList();
 
     std::string GetDebugInfo() const override;
@@ -725,6 +782,7 @@ protected:
     virtual bool IsAlwaysDetectableFor(WorldObject const* /*seer*/) const { return false; }
 private:
     Map* m_currMap;                                    //current object's Map location
+    SpatialIndexSlot m_spatialIndexSlot;
     Milliseconds _heartbeatTimer;
     //uint32 m_mapId;                                     // object at map with map_id
     uint32 m_InstanceId;                                // in map copy with instance id
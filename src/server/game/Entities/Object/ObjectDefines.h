@@ -69,6 +69,18 @@ enum class VisibilityDistanceType : uint8
     Max
 };
 
+// Groups of the map update list, the objects of a group take similar paths through their update
+enum class MapUpdateKind : uint8
+{
+    Idle,       // creatures out of combat and standing still
+    Moving,     // creatures out of combat with an active movement
+    Combat,
+    Dead,       // corpses and creatures waiting for their respawn
+    Other,      // gameobjects and dynamic objects
+
+    Max
+};
+
 uint32 PAIR64_HIPART(uint64 x)
 {
     return (uint32)((x >> 32) & UI64LIT(0x00000000FFFFFFFF));
@@ -5022,6 +5022,12 @@ void Player::ClearChannelWatch()
         (*itr)->RemoveWatching(this);
 }
 
+void Player::UpdateChannelIgnore(ObjectGuid ignoredGuid, bool ignored)
+{
+    for (Channel* channel : m_channels)
+        channel->SetIgnored(GetGUID(), ignoredGuid, ignored);
+}
+
 void Player::HandleBaseModValue(BaseModGroup modGroup, BaseModType modType, float amount, bool apply)
 {
     if (modGroup >= BASEMOD_END)
@@ -2066,6 +2066,7 @@ public:
     void LeftChannel(Channel* c);
     void CleanupChannels();
     void ClearChannelWatch();
+    void UpdateChannelIgnore(ObjectGuid ignoredGuid, bool ignored);
     void UpdateLFGChannel();
     void UpdateLocalChannels(uint32 newZone);
 
@@ -251,6 +251,7 @@ void MotionTransport::UpdatePosition(float x, float y, float z, float o)
         GetMap()->LoadGrid(x, y);
 
     Relocate(x, y, z, o);
+    UpdateSpatialIndex();
     UpdateModelPosition();
 
     UpdatePassengerPositions(_passengers);
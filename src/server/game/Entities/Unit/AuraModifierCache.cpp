@@ -0,0 +1,128 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuraModifierCache.h"
+#include "SpellAuraEffects.h"
+#include "Util.h"
+
+namespace
+{
+    // Filtered aggregates kept per unit, the table is dropped once it grows past this
+    constexpr std::size_t MAX_FILTERED_AGGREGATES = 64;
+}
+
+AuraModifierAggregate AuraModifierCache::Get(AuraType auraType, EffectList const& effects)
+{
+    if (effects.empty())
+        return {};
+
+    if (_aggregates.empty())
+        _aggregates.resize(TOTAL_AURAS);
+
+    if (!_valid.test(auraType))
+    {
+        _aggregates[auraType] = Compute(effects, [](AuraEffect const*) { return true; });
+        _valid.set(auraType);
+    }
+
+    return _aggregates[auraType];
+}
+
+AuraModifierAggregate AuraModifierCache::GetByMiscValue(AuraType auraType, EffectList const& effects, int32 miscValue)
+{
+    return GetFiltered(auraType, effects, Filter::MiscValue, miscValue);
+}
+
+AuraModifierAggregate AuraModifierCache::GetByMiscMask(AuraType auraType, EffectList const& effects, uint32 miscMask)
+{
+    return GetFiltered(auraType, effects, Filter::MiscMask, int32(miscMask));
+}
+
+void AuraModifierCache::Invalidate(AuraType auraType)
+{
+    _valid.reset(auraType);
+
+    if (!_hasFiltered.test(auraType))
+        return;
+
+    _hasFiltered.reset(auraType);
+    for (std::size_t i = 0; i < _filtered.size();)
+    {
+        if (_filtered[i].Type == auraType)
+        {
+            _filtered[i] = _filtered.back();
+            _filtered.pop_back();
+        }
+        else
+            ++i;
+    }
+}
+
+void AuraModifierCache::Clear()
+{
+    _valid.reset();
+    _hasFiltered.reset();
+    _filtered.clear();
+}
+
+template<class Predicate>
+AuraModifierAggregate AuraModifierCache::Compute(EffectList const& effects, Predicate&& predicate)
+{
+    AuraModifierAggregate aggregate;
+    for (AuraEffect const* aurEff : effects)
+    {
+        if (!predicate(aurEff))
+            continue;
+
+        int32 const amount = aurEff->GetAmount();
+        aggregate.Total += amount;
+        AddPct(aggregate.Multiplier, amount);
+        if (amount > aggregate.MaxPositive)
+            aggregate.MaxPositive = amount;
+        if (amount < aggregate.MaxNegative)
+            aggregate.MaxNegative = amount;
+    }
+
+    return aggregate;
+}
+
+AuraModifierAggregate AuraModifierCache::GetFiltered(AuraType auraType, EffectList const& effects, Filter kind, int32 key)
+{
+    if (effects.empty())
+        return {};
+
+    if (_hasFiltered.test(auraType))
+        for (FilteredAggregate const& filtered : _filtered)
+            if (filtered.Type == auraType && filtered.Kind == kind && filtered.Key == key)
+                return filtered.Value;
+
+    AuraModifierAggregate aggregate;
+    if (kind == Filter::MiscValue)
+        aggregate = Compute(effects, [key](AuraEffect const* aurEff) { return aurEff->GetMiscValue() == key; });
+    else
+        aggregate = Compute(effects, [mask = uint32(key)](AuraEffect const* aurEff) { return (aurEff->GetMiscValue() & mask) != 0; });
+
+    if (_filtered.size() >= MAX_FILTERED_AGGREGATES)
+    {
+        _filtered.clear();
+        _hasFiltered.reset();
+    }
+
+    _filtered.push_back({ auraType, kind, key, aggregate });
+    _hasFiltered.set(auraType);
+    return aggregate;
+}
@@ -0,0 +1,83 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _AURA_MODIFIER_CACHE_H
+#define _AURA_MODIFIER_CACHE_H
+
+#include "Define.h"
+#include "SpellAuraDefines.h"
+#include <bitset>
+#include <list>
+#include <vector>
+
+class AuraEffect;
+
+struct AuraModifierAggregate
+{
+    int32 Total = 0;
+    float Multiplier = 1.0f;
+    int32 MaxPositive = 0;
+    int32 MaxNegative = 0;
+};
+
+/*
+ * Aggregated amounts of the aura effects registered on a unit, per aura type.
+ *
+ * Aggregates are computed from the effect list on first use, in list order, and
+ * kept until the unit invalidates the aura type (effect registered, unregistered,
+ * amount changed or effect enabled/disabled). Misc value and misc mask filtered
+ * aggregates are kept in a small side table next to the unfiltered ones.
+ */
+class AuraModifierCache
+{
+public:
+    using EffectList = std::list<AuraEffect*>;
+
+    AuraModifierAggregate Get(AuraType auraType, EffectList const& effects);
+    AuraModifierAggregate GetByMiscValue(AuraType auraType, EffectList const& effects, int32 miscValue);
+    AuraModifierAggregate GetByMiscMask(AuraType auraType, EffectList const& effects, uint32 miscMask);
+
+    void Invalidate(AuraType auraType);
+    void Clear();
+
+private:
+    enum class Filter : uint8
+    {
+        MiscValue,
+        MiscMask
+    };
+
+    struct FilteredAggregate
+    {
+        AuraType Type;
+        Filter Kind;
+        int32 Key;
+        AuraModifierAggregate Value;
+    };
+
+    template<class Predicate>
+    static AuraModifierAggregate Compute(EffectList const& effects, Predicate&& predicate);
+
+    AuraModifierAggregate GetFiltered(AuraType auraType, EffectList const& effects, Filter kind, int32 key);
+
+    std::vector<AuraModifierAggregate> _aggregates; // indexed by AuraType, allocated on first use
+    std::bitset<TOTAL_AURAS> _valid;
+    std::bitset<TOTAL_AURAS> _hasFiltered;
+    std::vector<FilteredAggregate> _filtered;
+};
+
+#endif
@@ -215,6 +215,7 @@ Unit::Unit(bool isWorldObject) : WorldObject(isWorldObject),
     m_race(0),
     m_AutoRepeatFirstCast(false),
     m_procDeep(0),
+    m_procAuraCandidatesGeneration(0),
     m_removedAurasCount(0),
     i_motionMaster(new MotionMaster(this)),
     m_regenTimer(0),
@@ -811,6 +812,8 @@ void Unit::DealDamageMods(Unit const* victim, uint32& damage, uint32* absorb)
 uint32 Unit::DealDamage(Unit* attacker, Unit* victim, uint32 damage, CleanDamage const* cleanDamage, DamageEffectType damagetype, SpellSchoolMask damageSchoolMask, SpellInfo const* spellProto, bool durabilityLoss, bool /*allowGM*/, Spell const* damageSpell /*= nullptr*/)
 {
     damage = sScriptMgr->DealDamage(attacker, victim, damage, damagetype);
+    victim->WakeMapUpdate();
+
     // Xinef: initialize damage done for rage calculations
     // Xinef: its rare to modify damage in hooks, however training dummy's sets damage to 0
     uint32 rage_damage = damage + ((cleanDamage != nullptr) ? cleanDamage->absorbed_damage : 0);
@@ -3991,6 +3994,7 @@ bool Unit::CanSparringWith(Unit const* attacker) const
 void Unit::SetCurrentCastedSpell(Spell* pSpell)
 {
     ASSERT(pSpell);                                         // nullptr may be never passed here, use InterruptSpell or InterruptNonMeleeSpells
+    WakeMapUpdate();
 
     CurrentSpellTypes CSpellType = pSpell->GetCurrentContainer();
 
@@ -4449,6 +4453,7 @@ void Unit::_AddAura(UnitAura* aura, Unit* caster)
 {
     ASSERT(!m_cleanupDone);
     m_ownedAuras.insert(AuraMap::value_type(aura->GetId(), aura));
+    WakeMapUpdate();
 
     _RemoveNoStackAurasDueToAura(aura);
 
@@ -4506,6 +4511,7 @@ AuraApplication* Unit::_CreateAuraApplication(Aura* aura, uint8 effMask)
 
     AuraApplication* aurApp = new AuraApplication(this, caster, aura, effMask);
     m_appliedAuras.insert(AuraApplicationMap::value_type(aurId, aurApp));
+    _AddProcAuraCandidate(aurApp);
 
     // xinef: do not insert our application to interruptible list if application target is not the owner (area auras)
     // xinef: even if it gets removed, it will be reapplied in a second
@@ -4582,6 +4588,43 @@ void Unit::_ApplyAura(AuraApplication* aurApp, uint8 effMask)
 }
 
 // removes aura application from lists and unapplies effects
+void Unit::_AddProcAuraCandidate(AuraApplication* aurApp)
+{
+    uint32 procFlags = sSpellMgr->GetSpellProcEventFlags(aurApp->GetBase()->GetSpellInfo());
+    if (!procFlags)
+        return;
+
+    // same position as in m_appliedAuras: after all applications of lower or equal spell id
+    uint32 spellId = aurApp->GetBase()->GetId();
+    auto itr = std::upper_bound(m_procAuraCandidates.begin(), m_procAuraCandidates.end(), spellId, [](uint32 id, ProcAuraCandidate const& candidate)
+    {
+        return id < candidate.AurApp->GetBase()->GetId();
+    });
+
+    m_procAuraCandidates.insert(itr, { aurApp, procFlags });
+}
+
+void Unit::_RemoveProcAuraCandidate(AuraApplication* aurApp)
+{
+    auto itr = std::find_if(m_procAuraCandidates.begin(), m_procAuraCandidates.end(), [aurApp](ProcAuraCandidate const& candidate)
+    {
+        return candidate.AurApp == aurApp;
+    });
+
+    if (itr != m_procAuraCandidates.end())
+        m_procAuraCandidates.erase(itr);
+}
+
+void Unit::_RebuildProcAuraCandidates()
+{
+    m_procAuraCandidates.clear();
+    for (auto const& [spellId, aurApp] : m_appliedAuras)
+        if (uint32 procFlags = sSpellMgr->GetSpellProcEventFlags(aurApp->GetBase()->GetSpellInfo()))
+            m_procAuraCandidates.push_back({ aurApp, procFlags });
+
+    m_procAuraCandidatesGeneration = sSpellMgr->GetProcDataGeneration();
+}
+
 void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMode)
 {
     AuraApplication* aurApp = i->second;
@@ -4602,6 +4645,7 @@ void Unit::_UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMo
 
     // Remove all pointers from lists here to prevent possible pointer invalidation on spellcast/auraapply/auraremove
     m_appliedAuras.erase(i);
+    _RemoveProcAuraCandidate(aurApp);
 
     // xinef: do not insert our application to interruptible list if application target is not the owner (area auras)
     // xinef: event if it gets removed, it will be reapplied in a second
@@ -4733,6 +4777,8 @@ void Unit::_RegisterAuraEffect(AuraEffect* aurEff, bool apply)
         m_modAuras[aurEff->GetAuraType()].push_back(aurEff);
     else
         m_modAuras[aurEff->GetAuraType()].remove(aurEff);
+
+    m_auraModifierCache.Invalidate(aurEff->GetAuraType());
 }
 
 // All aura base removes should go threw this function!
@@ -5974,82 +6020,39 @@ int32 Unit::GetTotalAuraModifierAreaExclusive(AuraType auratype) const
 
 int32 Unit::GetTotalAuraModifier(AuraType auratype) const
 {
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    if (mTotalAuraList.empty())
-        return 0;
-
-    int32 modifier = 0;
-
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        modifier += (*i)->GetAmount();
-
-    return modifier;
+    return m_auraModifierCache.Get(auratype, GetAuraEffectsByType(auratype)).Total;
 }
 
 float Unit::GetTotalAuraMultiplier(AuraType auratype) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        AddPct(multiplier, (*i)->GetAmount());
-
-    return multiplier;
+    return m_auraModifierCache.Get(auratype, GetAuraEffectsByType(auratype)).Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifier(AuraType auratype)
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return m_auraModifierCache.Get(auratype, GetAuraEffectsByType(auratype)).MaxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifier(AuraType auratype) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-
-    return modifier;
+    return m_auraModifierCache.Get(auratype, GetAuraEffectsByType(auratype)).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask)
-            modifier += (*i)->GetAmount();
-    }
-    return modifier;
+    return m_auraModifierCache.GetByMiscMask(auratype, GetAuraEffectsByType(auratype), misc_mask).Total;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if (((*i)->GetMiscValue() & misc_mask))
-            AddPct(multiplier, (*i)->GetAmount());
-
-    return multiplier;
+    return m_auraModifierCache.GetByMiscMask(auratype, GetAuraEffectsByType(auratype), misc_mask).Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask, const AuraEffect* except) const
 {
+    if (!except)
+        return m_auraModifierCache.GetByMiscMask(auratype, GetAuraEffectsByType(auratype), misc_mask).MaxPositive;
+
     int32 modifier = 0;
 
     AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
@@ -6064,68 +6067,27 @@ int32 Unit::GetMaxPositiveAuraModifierByMiscMask(AuraType auratype, uint32 misc_
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscMask(AuraType auratype, uint32 misc_mask) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue()& misc_mask && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return m_auraModifierCache.GetByMiscMask(auratype, GetAuraEffectsByType(auratype), misc_mask).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetMiscValue() == misc_value)
-            modifier += (*i)->GetAmount();
-
-    return modifier;
+    return m_auraModifierCache.GetByMiscValue(auratype, GetAuraEffectsByType(auratype), misc_value).Total;
 }
 
 float Unit::GetTotalAuraMultiplierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    float multiplier = 1.0f;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-        if ((*i)->GetMiscValue() == misc_value)
-            AddPct(multiplier, (*i)->GetAmount());
-
-    return multiplier;
+    return m_auraModifierCache.GetByMiscValue(auratype, GetAuraEffectsByType(auratype), misc_value).Multiplier;
 }
 
 int32 Unit::GetMaxPositiveAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() > modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return m_auraModifierCache.GetByMiscValue(auratype, GetAuraEffectsByType(auratype), misc_value).MaxPositive;
 }
 
 int32 Unit::GetMaxNegativeAuraModifierByMiscValue(AuraType auratype, int32 misc_value) const
 {
-    int32 modifier = 0;
-
-    AuraEffectList const& mTotalAuraList = GetAuraEffectsByType(auratype);
-    for (AuraEffectList::const_iterator i = mTotalAuraList.begin(); i != mTotalAuraList.end(); ++i)
-    {
-        if ((*i)->GetMiscValue() == misc_value && (*i)->GetAmount() < modifier)
-            modifier = (*i)->GetAmount();
-    }
-
-    return modifier;
+    return m_auraModifierCache.GetByMiscValue(auratype, GetAuraEffectsByType(auratype), misc_value).MaxNegative;
 }
 
 int32 Unit::GetTotalAuraModifierByAffectMask(AuraType auratype, SpellInfo const* affectedSpell) const
@@ -13795,6 +13757,8 @@ void Unit::SetInCombatState(bool PvP, Unit* enemy, uint32 duration)
     if (!IsAlive())
         return;
 
+    WakeMapUpdate();
+
     if (PvP)
         m_CombatTimer = std::max<uint32>(GetCombatTimer(), std::max<uint32>(5500, duration));
     else if (duration)
@@ -16188,25 +16152,35 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
 
     ProcEventInfo eventInfo = ProcEventInfo(actor, actionTarget, target, procFlag, 0, procPhase, procExtra, procSpell, damageInfo, healInfo, procAura, procAuraEffectIndex);
 
+    if (m_procAuraCandidatesGeneration != sSpellMgr->GetProcDataGeneration())
+        _RebuildProcAuraCandidates();
+
+    if (isVictim)
+        procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
+
     ProcTriggeredList procTriggered;
-    // Fill procTriggered list
-    for (AuraApplicationMap::const_iterator itr = GetAppliedAuras().begin(); itr != GetAppliedAuras().end(); ++itr)
+    // Fill procTriggered list, only auras listening to one of the event proc flags can trigger
+    for (std::size_t index = 0; index < m_procAuraCandidates.size(); ++index)
     {
+        if (!(m_procAuraCandidates[index].ProcFlags & procFlag))
+            continue;
+
+        AuraApplication* aurApp = m_procAuraCandidates[index].AurApp;
+        uint32 const spellId = aurApp->GetBase()->GetId();
+
         // Do not allow auras to proc from effect triggered by itself
-        if (procAura && procAura->Id == itr->first)
+        if (procAura && procAura->Id == spellId)
             continue;
 
         // Xinef: Generic Item Equipment cooldown, -1 is a special marker
-        if (itr->second->GetBase()->GetCastItemGUID() && HasSpellItemCooldown(itr->first, uint32(-1)))
+        if (aurApp->GetBase()->GetCastItemGUID() && HasSpellItemCooldown(spellId, uint32(-1)))
             continue;
 
-        ProcTriggeredData triggerData(itr->second->GetBase());
+        ProcTriggeredData triggerData(aurApp->GetBase());
         // Defensive procs are active on absorbs (so absorption effects are not a hindrance)
         bool active = damage || (procExtra & PROC_EX_BLOCK && isVictim);
-        if (isVictim)
-            procExtra &= ~PROC_EX_INTERNAL_REQ_FAMILY;
 
-        SpellInfo const* spellProto = itr->second->GetBase()->GetSpellInfo();
+        SpellInfo const* spellProto = aurApp->GetBase()->GetSpellInfo();
 
         // only auras that have trigger spell should proc from fully absorbed damage
         if (procExtra & PROC_EX_ABSORB && isVictim)
@@ -16219,7 +16193,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
             active = true;
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptCheckProcHandlers(itr->second, eventInfo))
+        if (!triggerData.aura->CallScriptCheckProcHandlers(aurApp, eventInfo))
         {
             continue;
         }
@@ -16227,7 +16201,7 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         bool isTriggeredAtSpellProcEvent = IsTriggeredAtSpellProcEvent(target, triggerData.aura, attType, isVictim, active, triggerData.spellProcEvent, eventInfo);
 
         // AuraScript Hook
-        if (!triggerData.aura->CallScriptAfterCheckProcHandlers(itr->second, eventInfo, isTriggeredAtSpellProcEvent))
+        if (!triggerData.aura->CallScriptAfterCheckProcHandlers(aurApp, eventInfo, isTriggeredAtSpellProcEvent))
         {
             continue;
         }
@@ -16243,9 +16217,9 @@ void Unit::ProcDamageAndSpellFor(bool isVictim, Unit* target, uint32 procFlag, u
         bool hasTriggeredProc = false;
         for (uint8 i = 0; i < MAX_SPELL_EFFECTS; ++i)
         {
-            if (itr->second->HasEffect(i))
+            if (aurApp->HasEffect(i))
             {
-                AuraEffect* aurEff = itr->second->GetBase()->GetEffect(i);
+                AuraEffect* aurEff = aurApp->GetBase()->GetEffect(i);
 
                 // Skip this auras
                 if (isNonTriggerAura[aurEff->GetAuraType()])
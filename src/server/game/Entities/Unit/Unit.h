@@ -18,6 +18,7 @@
 #ifndef __UNIT_H
 #define __UNIT_H
 
+#include "AuraModifierCache.h"
 #include "EnumFlag.h"
 #include "EventProcessor.h"
 #include "FollowerRefMgr.h"
@@ -1276,6 +1277,9 @@ public:
     void _ApplyAura(AuraApplication* aurApp, uint8 effMask);
     void _UnapplyAura(AuraApplicationMap::iterator& i, AuraRemoveMode removeMode);
     void _UnapplyAura(AuraApplication* aurApp, AuraRemoveMode removeMode);
+    void _AddProcAuraCandidate(AuraApplication* aurApp);
+    void _RemoveProcAuraCandidate(AuraApplication* aurApp);
+    void _RebuildProcAuraCandidates();
     void _RemoveNoStackAuraApplicationsDueToAura(Aura* aura);
     void _RemoveNoStackAurasDueToAura(Aura* aura);
     bool _IsNoStackAuraDueToAura(Aura* appliedAura, Aura* existingAura) const;
@@ -1338,6 +1342,8 @@ public:
     void _ApplyAllAuraStatMods();
 
     [[nodiscard]] AuraEffectList const& GetAuraEffectsByType(AuraType type) const { return m_modAuras[type]; }
+    // Drops the cached aggregates of an aura type, called whenever an effect of that type changes its amount
+    void InvalidateAuraModifiers(AuraType type) { m_auraModifierCache.Invalidate(type); }
     AuraList&       GetSingleCastAuras()       { return m_scAuras; }
     [[nodiscard]] AuraList const& GetSingleCastAuras() const { return m_scAuras; }
 
@@ -2061,11 +2067,22 @@ protected:
 
     AuraMap m_ownedAuras;
     AuraApplicationMap m_appliedAuras;
+
+    // Applied auras that can proc in ProcDamageAndSpellFor, kept in m_appliedAuras order
+    struct ProcAuraCandidate
+    {
+        AuraApplication* AurApp;
+        uint32 ProcFlags;
+    };
+    std::vector<ProcAuraCandidate> m_procAuraCandidates;
+    uint32 m_procAuraCandidatesGeneration;
+
     AuraList m_removedAuras;
     AuraMap::iterator m_auraUpdateIterator;
     uint32 m_removedAurasCount;
 
     AuraEffectList m_modAuras[TOTAL_AURAS];
+    mutable AuraModifierCache m_auraModifierCache;
     AuraList m_scAuras;                        // casted singlecast auras
     AuraApplicationList m_interruptableAuras;  // auras which have interrupt mask applied on unit
     AuraStateAurasMap m_auraStateAuras;        // Used for improve performance of aura state checks on aura apply/remove
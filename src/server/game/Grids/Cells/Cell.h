@@ -113,6 +113,9 @@ struct Cell
 
 private:
     template<class T, class CONTAINER> void VisitCircle(TypeContainerVisitor<T, CONTAINER>&, Map&, CellCoord const&, CellCoord const&) const;
+
+    // Searches the spatial index of the map instead of the cells, if the map has one and the visitor supports it
+    template<class T> static bool VisitSpatialIndex(Map const& map, float x, float y, float radius, uint32 containers, T& visitor);
 };
 
 #endif
@@ -161,9 +161,32 @@ inline void Cell::VisitCircle(TypeContainerVisitor<T, CONTAINER>& visitor, Map&
     }
 }
 
+template<class T>
+inline bool Cell::VisitSpatialIndex(Map const& map, float x, float y, float radius, uint32 containers, T& visitor)
+{
+    // only searchers whose result does not depend on the visiting order
+    if constexpr (requires { visitor.VisitObject(static_cast<WorldObject*>(nullptr)); visitor.GetSpatialTypeMask(); })
+    {
+        MapSpatialIndex const* index = map.GetSpatialIndex();
+        if (!index || radius <= 0.0f)
+            return false;
+
+        index->VisitCircle(x, y, std::min<float>(radius, SIZE_OF_GRIDS), visitor.GetSpatialTypeMask(), containers, [&visitor](WorldObject* obj)
+        {
+            visitor.VisitObject(obj);
+        });
+        return true;
+    }
+    else
+        return false;
+}
+
 template<class T>
 inline void Cell::VisitGridObjects(WorldObject const* center_obj, T& visitor, float radius)
 {
+    if (VisitSpatialIndex(*center_obj->GetMap(), center_obj->GetPositionX(), center_obj->GetPositionY(), radius + center_obj->GetCombatReach(), SPATIAL_INDEX_GRID_OBJECTS, visitor))
+        return;
+
     CellCoord p(Acore::ComputeCellCoord(center_obj->GetPositionX(), center_obj->GetPositionY()));
     Cell cell(p);
 
@@ -174,6 +197,9 @@ inline void Cell::VisitGridObjects(WorldObject const* center_obj, T& visitor, fl
 template<class T>
 inline void Cell::VisitWorldObjects(WorldObject const* center_obj, T& visitor, float radius)
 {
+    if (VisitSpatialIndex(*center_obj->GetMap(), center_obj->GetPositionX(), center_obj->GetPositionY(), radius + center_obj->GetCombatReach(), SPATIAL_INDEX_WORLD_OBJECTS, visitor))
+        return;
+
     CellCoord p(Acore::ComputeCellCoord(center_obj->GetPositionX(), center_obj->GetPositionY()));
     Cell cell(p);
 
@@ -184,6 +210,9 @@ inline void Cell::VisitWorldObjects(WorldObject const* center_obj, T& visitor, f
 template<class T>
 inline void Cell::VisitAllObjects(WorldObject const* center_obj, T& visitor, float radius)
 {
+    if (VisitSpatialIndex(*center_obj->GetMap(), center_obj->GetPositionX(), center_obj->GetPositionY(), radius + center_obj->GetCombatReach(), SPATIAL_INDEX_ALL_OBJECTS, visitor))
+        return;
+
     CellCoord p(Acore::ComputeCellCoord(center_obj->GetPositionX(), center_obj->GetPositionY()));
     Cell cell(p);
 
@@ -196,6 +225,9 @@ inline void Cell::VisitAllObjects(WorldObject const* center_obj, T& visitor, flo
 template<class T>
 inline void Cell::VisitGridObjects(float x, float y, Map* map, T& visitor, float radius)
 {
+    if (VisitSpatialIndex(*map, x, y, radius, SPATIAL_INDEX_GRID_OBJECTS, visitor))
+        return;
+
     CellCoord p(Acore::ComputeCellCoord(x, y));
     Cell cell(p);
 
@@ -206,6 +238,9 @@ inline void Cell::VisitGridObjects(float x, float y, Map* map, T& visitor, float
 template<class T>
 inline void Cell::VisitWorldObjects(float x, float y, Map* map, T& visitor, float radius)
 {
+    if (VisitSpatialIndex(*map, x, y, radius, SPATIAL_INDEX_WORLD_OBJECTS, visitor))
+        return;
+
     CellCoord p(Acore::ComputeCellCoord(x, y));
     Cell cell(p);
 
@@ -216,6 +251,9 @@ inline void Cell::VisitWorldObjects(float x, float y, Map* map, T& visitor, floa
 template<class T>
 inline void Cell::VisitAllObjects(float x, float y, Map* map, T& visitor, float radius)
 {
+    if (VisitSpatialIndex(*map, x, y, radius, SPATIAL_INDEX_ALL_OBJECTS, visitor))
+        return;
+
     CellCoord p(Acore::ComputeCellCoord(x, y));
     Cell cell(p);
 
@@ -98,6 +98,8 @@ void GridObjectLoader::LoadAllCellsInGrid()
                 _grid.AddWorldObject(cell.CellX(), cell.CellY(), corpse);
             else
                 _grid.AddGridObject(cell.CellX(), cell.CellY(), corpse);
+
+            _map->AddToSpatialIndex(corpse, corpse->IsWorldObject());
         }
     }
 }
@@ -124,6 +126,13 @@ void GridObjectUnloader::Visit(GridRefMgr<T>& m)
     }
 }
 
+void GridObjectUnloader::Visit(CorpseMapType& m)
+{
+    // corpses are deleted with Map, they only leave the grid and the spatial index
+    while (!m.IsEmpty())
+        m.getFirst()->GetSource()->RemoveFromGrid();
+}
+
 template<class T>
 void GridObjectCleaner::Visit(GridRefMgr<T>& m)
 {
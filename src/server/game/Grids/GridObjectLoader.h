@@ -53,7 +53,7 @@ public:
 class GridObjectUnloader
 {
 public:
-    void Visit(CorpseMapType&) { }    // corpses are deleted with Map
+    void Visit(CorpseMapType& m);
     template<class T> void Visit(GridRefMgr<T>& m);
 };
 #endif
@@ -54,6 +54,47 @@ TerrainMapDataReadResult GridTerrainData::Load(std::string const& mapFileName)
     return TerrainMapDataReadResult::Success;
 }
 
+std::size_t GridTerrainData::GetMemoryUsage() const
+{
+    std::size_t size = sizeof(GridTerrainData);
+
+    if (_loadedAreaData)
+    {
+        size += sizeof(LoadedAreaData);
+        if (_loadedAreaData->areaMap)
+            size += sizeof(LoadedAreaData::AreaMapType);
+    }
+
+    if (_loadedHeightData)
+    {
+        size += sizeof(LoadedHeightData);
+        if (_loadedHeightData->uint16HeightData)
+            size += sizeof(LoadedHeightData::Uint16HeightData);
+        if (_loadedHeightData->uint8HeightData)
+            size += sizeof(LoadedHeightData::Uint8HeightData);
+        if (_loadedHeightData->floatHeightData)
+            size += sizeof(LoadedHeightData::FloatHeightData);
+        if (_loadedHeightData->minHeightPlanes)
+            size += sizeof(LoadedHeightData::HeightPlanesType);
+    }
+
+    if (_loadedLiquidData)
+    {
+        size += sizeof(LoadedLiquidData);
+        if (_loadedLiquidData->liquidEntry)
+            size += sizeof(LoadedLiquidData::LiquidEntryType);
+        if (_loadedLiquidData->liquidFlags)
+            size += sizeof(LoadedLiquidData::LiquidFlagsType);
+        if (_loadedLiquidData->liquidMap)
+            size += sizeof(LoadedLiquidData::LiquidMapType) + _loadedLiquidData->liquidMap->capacity() * sizeof(float);
+    }
+
+    if (_loadedHoleData)
+        size += sizeof(LoadedHoleData);
+
+    return size;
+}
+
 bool GridTerrainData::LoadAreaData(std::ifstream& fileStream, uint32 const offset)
 {
     fileStream.seekg(offset);
@@ -243,6 +243,9 @@ public:
     float getMinHeight(float x, float y) const;
     float getLiquidLevel(float x, float y) const;
     LiquidData const GetLiquidData(float x, float y, float z, float collisionHeight, uint8 ReqLiquidType) const;
+
+    // Bytes allocated for the loaded data
+    [[nodiscard]] std::size_t GetMemoryUsage() const;
 };
 
 #endif
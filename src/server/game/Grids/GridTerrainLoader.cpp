@@ -3,6 +3,7 @@
 #include "MMapFactory.h"
 #include "MMapMgr.h"
 #include "ScriptMgr.h"
+#include "TerrainTileCache.h"
 #include "VMapFactory.h"
 #include "VMapMgr2.h"
 
@@ -32,12 +33,27 @@ void GridTerrainLoader::LoadMap()
     // map file name
     std::string const mapFileName = Acore::StringFormat("{}maps/{:03}{:02}{:02}.map", sWorld->GetDataPath(), _map->GetId(), _grid.GetX(), _grid.GetY());
 
-    // loading data
-    LOG_DEBUG("maps", "Loading map {}", mapFileName);
-    std::unique_ptr<GridTerrainData> terrainData = std::make_unique<GridTerrainData>();
-    TerrainMapDataReadResult loadResult = terrainData->Load(mapFileName);
+    // the terrain of this grid may still be referenced by an instance of the map
+    if (std::shared_ptr<GridTerrainData> cached = sTerrainTileCache->Find(_map->GetId(), _grid.GetX(), _grid.GetY()))
+    {
+        _grid.SetTerrainData(std::move(cached));
+        sScriptMgr->OnLoadGridMap(_map, _grid.GetTerrainData(), _grid.GetX(), _grid.GetY());
+        return;
+    }
+
+    // loading data, unless it was already read in the background
+    std::unique_ptr<GridTerrainData> terrainData;
+    TerrainMapDataReadResult loadResult;
+    _preloaded = _map->GetGridPreloader().TakeTerrain(_grid.GetX(), _grid.GetY(), terrainData, loadResult);
+    if (!_preloaded)
+    {
+        LOG_DEBUG("maps", "Loading map {}", mapFileName);
+        terrainData = std::make_unique<GridTerrainData>();
+        loadResult = terrainData->Load(mapFileName);
+    }
+
     if (loadResult == TerrainMapDataReadResult::Success)
-        _grid.SetTerrainData(std::move(terrainData));
+        _grid.SetTerrainData(sTerrainTileCache->Insert(_map->GetId(), _grid.GetX(), _grid.GetY(), std::move(terrainData)));
     else
     {
         if (loadResult == TerrainMapDataReadResult::InvalidMagic)
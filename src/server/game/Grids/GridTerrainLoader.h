@@ -24,10 +24,13 @@ class GridTerrainLoader
 {
 public:
     GridTerrainLoader(MapGridType& grid, Map* map)
-        : _grid(grid), _map(map) { }
+        : _grid(grid), _map(map), _preloaded(false) { }
 
     void LoadTerrain();
 
+    // True if the terrain was read in the background by the GridPreloader of the map
+    [[nodiscard]] bool IsTerrainPreloaded() const { return _preloaded; }
+
     static bool ExistMap(uint32 mapid, int gx, int gy);
     static bool ExistVMap(uint32 mapid, int gx, int gy);
 
@@ -38,6 +41,7 @@ private:
 
     MapGridType& _grid;
     Map* _map;
+    bool _preloaded;
 };
 
 class GridTerrainUnloader
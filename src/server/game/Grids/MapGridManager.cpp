@@ -1,6 +1,8 @@
 #include "MapGridManager.h"
 #include "GridObjectLoader.h"
 #include "GridTerrainLoader.h"
+#include "Map.h"
+#include "Metric.h"
 
 void MapGridManager::CreateGrid(uint16 const x, uint16 const y)
 {
@@ -8,13 +10,20 @@ void MapGridManager::CreateGrid(uint16 const x, uint16 const y)
     if (IsGridCreated(x, y))
         return;
 
+    [[maybe_unused]] bool preloaded = false; // only read by the metric, when the timer stops
+    METRIC_TIMER("map_grid_terrain_load_time",
+        METRIC_TAG("map_id", std::to_string(_map->GetId())),
+        METRIC_TAG("preloaded", preloaded ? "1" : "0"));
+
     std::unique_ptr<MapGridType> grid = std::make_unique<MapGridType>(x, y);
     grid->link(_map);
 
     GridTerrainLoader loader(*grid, _map);
     loader.LoadTerrain();
+    preloaded = loader.IsTerrainPreloaded();
 
     _mapGrid[x][y] = std::move(grid);
+    _map->InvalidateCollisionCache(GridCoord(x, y));
 
     ++_createdGridsCount;
 }
@@ -28,6 +37,8 @@ bool MapGridManager::LoadGrid(uint16 const x, uint16 const y)
     // Must mark as loaded first, as GridObjectLoader spawning objects can attempt to recursively load the grid
     grid->SetObjectDataLoaded();
 
+    METRIC_TIMER("map_grid_objects_load_time", METRIC_TAG("map_id", std::to_string(_map->GetId())));
+
     GridObjectLoader loader(*grid, _map);
     loader.LoadAllCellsInGrid();
 
@@ -59,6 +70,7 @@ void MapGridManager::UnloadGrid(uint16 const x, uint16 const y)
     terrainUnloader.UnloadTerrain();
 
     _mapGrid[x][y] = nullptr;
+    _map->InvalidateCollisionCache(GridCoord(x, y));
 }
 
 bool MapGridManager::IsGridCreated(uint16 const x, uint16 const y) const
@@ -0,0 +1,178 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapSpatialIndex.h"
+#include "Errors.h"
+#include <bit>
+
+MapSpatialIndex::~MapSpatialIndex()
+{
+    // objects outliving the map must not point back into the index
+    for (auto const& [key, node] : _nodes)
+        for (EntryList const& list : node->Lists)
+            for (Entry const& entry : list.Entries)
+                entry.Slot->Index = nullptr;
+
+    for (Entry const& entry : _largeEntries)
+        entry.Slot->Index = nullptr;
+}
+
+void MapSpatialIndex::Insert(WorldObject* object, SpatialIndexSlot& slot, float x, float y, float radius, uint32 flags)
+{
+    ASSERT(std::has_single_bit(flags & GRID_MAP_TYPE_MASK_ALL) && (flags & SPATIAL_INDEX_ALL_OBJECTS));
+
+    if (slot.Index)
+        Remove(slot);
+
+    slot.Index = this;
+    InsertEntry({ x, y, radius, flags, object, &slot });
+}
+
+void MapSpatialIndex::Move(SpatialIndexSlot& slot, float x, float y, float radius)
+{
+    ASSERT(slot.Index == this);
+
+    bool const large = radius > MAX_NODE_ENTRY_RADIUS;
+    if (slot.Node == LARGE_ENTRIES_NODE)
+    {
+        Entry& entry = _largeEntries[slot.Position];
+        if (large)
+        {
+            entry.X = x;
+            entry.Y = y;
+            entry.Radius = radius;
+            return;
+        }
+    }
+    else if (!large && ComputeNode(x, y) == slot.Node)
+    {
+        // most moves stay inside of the node
+        EntryList& list = _nodes.at(slot.Node)->Lists[slot.List];
+        Entry& entry = list.Entries[slot.Position];
+        entry.X = x;
+        entry.Y = y;
+        entry.Radius = radius;
+        list.Extend(entry);
+        return;
+    }
+
+    Entry moved = slot.Node == LARGE_ENTRIES_NODE ? _largeEntries[slot.Position] : _nodes.at(slot.Node)->Lists[slot.List].Entries[slot.Position];
+    moved.X = x;
+    moved.Y = y;
+    moved.Radius = radius;
+    RemoveEntry(slot);
+    InsertEntry(moved);
+}
+
+void MapSpatialIndex::Remove(SpatialIndexSlot& slot)
+{
+    if (!slot.Index)
+        return;
+
+    slot.Index->RemoveEntry(slot);
+    slot.Index = nullptr;
+}
+
+uint32 MapSpatialIndex::ComputeList(uint32 flags)
+{
+    return std::countr_zero(flags & GRID_MAP_TYPE_MASK_ALL);
+}
+
+void MapSpatialIndex::EntryList::Extend(Entry const& entry)
+{
+    Containers |= entry.Flags & SPATIAL_INDEX_ALL_OBJECTS;
+    MinX = std::min(MinX, entry.X - entry.Radius);
+    MinY = std::min(MinY, entry.Y - entry.Radius);
+    MaxX = std::max(MaxX, entry.X + entry.Radius);
+    MaxY = std::max(MaxY, entry.Y + entry.Radius);
+}
+
+void MapSpatialIndex::EntryList::Recompute()
+{
+    Containers = 0;
+    if (Entries.empty())
+        return;
+
+    Entry const& first = Entries.front();
+    MinX = MaxX = first.X;
+    MinY = MaxY = first.Y;
+    for (Entry const& entry : Entries)
+        Extend(entry);
+}
+
+void MapSpatialIndex::InsertEntry(Entry const& entry)
+{
+    SpatialIndexSlot& slot = *entry.Slot;
+    ++_size;
+
+    if (entry.Radius > MAX_NODE_ENTRY_RADIUS)
+    {
+        slot.Node = LARGE_ENTRIES_NODE;
+        slot.List = 0;
+        slot.Position = _largeEntries.size();
+        _largeEntries.push_back(entry);
+        return;
+    }
+
+    slot.Node = ComputeNode(entry.X, entry.Y);
+    slot.List = ComputeList(entry.Flags);
+
+    std::unique_ptr<Node>& node = _nodes[slot.Node];
+    if (!node)
+        node = std::make_unique<Node>();
+
+    EntryList& list = node->Lists[slot.List];
+    slot.Position = list.Entries.size();
+    list.Entries.push_back(entry);
+    if (list.Entries.size() == 1)
+        list.Recompute();
+    else
+        list.Extend(entry);
+
+    ++node->Size;
+}
+
+void MapSpatialIndex::RemoveEntry(SpatialIndexSlot& slot)
+{
+    std::vector<Entry>* entries = &_largeEntries;
+    auto itr = _nodes.end();
+    if (slot.Node != LARGE_ENTRIES_NODE)
+    {
+        itr = _nodes.find(slot.Node);
+        ASSERT(itr != _nodes.end());
+        entries = &itr->second->Lists[slot.List].Entries;
+    }
+
+    ASSERT(slot.Position < entries->size() && (*entries)[slot.Position].Slot == &slot);
+
+    // the last entry of the list takes over the position
+    if (slot.Position + 1 != entries->size())
+    {
+        (*entries)[slot.Position] = entries->back();
+        (*entries)[slot.Position].Slot->Position = slot.Position;
+    }
+
+    entries->pop_back();
+    --_size;
+
+    if (itr == _nodes.end())
+        return;
+
+    itr->second->Lists[slot.List].Recompute();
+    if (!--itr->second->Size)
+        _nodes.erase(itr);
+}
@@ -0,0 +1,244 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _MAPSPATIALINDEX_H
+#define _MAPSPATIALINDEX_H
+
+#include "GridDefines.h"
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class MapSpatialIndex;
+class WorldObject;
+
+// Which cell container an indexed object is stored in, combined with the GridMapTypeMask of the object
+constexpr uint32 SPATIAL_INDEX_GRID_OBJECTS  = 0x20;
+constexpr uint32 SPATIAL_INDEX_WORLD_OBJECTS = 0x40;
+constexpr uint32 SPATIAL_INDEX_ALL_OBJECTS   = SPATIAL_INDEX_GRID_OBJECTS | SPATIAL_INDEX_WORLD_OBJECTS;
+
+// Position of an object inside of the index, owned by the object
+struct SpatialIndexSlot
+{
+    MapSpatialIndex* Index = nullptr;
+    uint32 Node = 0;
+    uint32 List = 0;
+    uint32 Position = 0;
+};
+
+/*
+ * Uniform grid over the objects of one map, with bounding data per cell.
+ *
+ * Every map cell area that holds objects gets a node with one entry list per
+ * object type. Each list keeps the box its objects reach into and the containers
+ * they are stored in, so a search for players skips the creatures of a node
+ * without looking at them and lists out of range are skipped as a whole.
+ * Entries store position and radius next to the object pointer, so radius, box
+ * and cone queries test distances without touching the objects themselves.
+ *
+ * Positions are updated by the map relocation functions, like the cells are.
+ * Workers must not add, move or remove objects while a query runs.
+ */
+class MapSpatialIndex
+{
+public:
+    static constexpr uint32 NODES_PER_CELL = 2; // per axis
+    static constexpr uint32 NODES_PER_MAP = TOTAL_NUMBER_OF_CELLS_PER_MAP * NODES_PER_CELL;
+    static constexpr float NODE_SIZE = SIZE_OF_GRID_CELL / NODES_PER_CELL;
+
+    // larger objects, like big gameobject models, are kept in one list every query checks
+    static constexpr float MAX_NODE_ENTRY_RADIUS = 10.0f;
+
+    MapSpatialIndex() = default;
+    ~MapSpatialIndex();
+
+    MapSpatialIndex(MapSpatialIndex const&) = delete;
+    MapSpatialIndex& operator=(MapSpatialIndex const&) = delete;
+
+    // flags are the GridMapTypeMask bit of the object and its container
+    void Insert(WorldObject* object, SpatialIndexSlot& slot, float x, float y, float radius, uint32 flags);
+    void Move(SpatialIndexSlot& slot, float x, float y, float radius);
+    static void Remove(SpatialIndexSlot& slot);
+
+    // Objects whose radius reaches into the circle
+    template<class Worker>
+    void VisitCircle(float x, float y, float radius, uint32 typeMask, uint32 containers, Worker&& worker) const;
+
+    // Objects whose radius reaches into the box
+    template<class Worker>
+    void VisitBox(float minX, float minY, float maxX, float maxY, uint32 typeMask, uint32 containers, Worker&& worker) const;
+
+    // Objects whose radius reaches into the circle sector of arc radians centered on orientation
+    template<class Worker>
+    void VisitCone(float x, float y, float radius, float orientation, float arc, uint32 typeMask, uint32 containers, Worker&& worker) const;
+
+    [[nodiscard]] std::size_t GetSize() const { return _size; }
+    [[nodiscard]] std::size_t GetNodeCount() const { return _nodes.size(); }
+
+private:
+    static constexpr uint32 TYPE_COUNT = 5; // bits of GRID_MAP_TYPE_MASK_ALL
+    static constexpr uint32 LARGE_ENTRIES_NODE = std::numeric_limits<uint32>::max();
+
+    struct Entry
+    {
+        float X;
+        float Y;
+        float Radius;
+        uint32 Flags;
+        WorldObject* Object;
+        SpatialIndexSlot* Slot;
+    };
+
+    struct EntryList
+    {
+        std::vector<Entry> Entries;
+        uint32 Containers = 0;
+
+        // box the entries reach into, it only grows while they move and is recomputed when one leaves
+        float MinX = 0.0f;
+        float MinY = 0.0f;
+        float MaxX = 0.0f;
+        float MaxY = 0.0f;
+
+        void Extend(Entry const& entry);
+        void Recompute();
+        [[nodiscard]] bool Overlaps(float minX, float minY, float maxX, float maxY) const { return MinX <= maxX && MaxX >= minX && MinY <= maxY && MaxY >= minY; }
+    };
+
+    struct Node
+    {
+        std::array<EntryList, TYPE_COUNT> Lists;
+        uint32 Size = 0;
+    };
+
+    static uint32 ComputeNodeCoord(float value);
+    static uint32 ComputeNode(float x, float y) { return ComputeNodeCoord(x) * NODES_PER_MAP + ComputeNodeCoord(y); }
+    static uint32 ComputeList(uint32 flags);
+
+    void InsertEntry(Entry const& entry);
+    void RemoveEntry(SpatialIndexSlot& slot);
+
+    // Visits the entries of every list reaching into the box
+    template<class Filter>
+    void VisitLists(float minX, float minY, float maxX, float maxY, uint32 typeMask, uint32 containers, Filter&& filter) const;
+
+    std::unordered_map<uint32, std::unique_ptr<Node>> _nodes;
+    std::vector<Entry> _largeEntries;
+    std::size_t _size = 0;
+};
+
+inline uint32 MapSpatialIndex::ComputeNodeCoord(float value)
+{
+    float const coord = (value + MAP_HALFSIZE) / NODE_SIZE;
+    if (!(coord > 0.0f))
+        return 0;
+
+    return std::min(uint32(coord), NODES_PER_MAP - 1);
+}
+
+template<class Filter>
+void MapSpatialIndex::VisitLists(float minX, float minY, float maxX, float maxY, uint32 typeMask, uint32 containers, Filter&& filter) const
+{
+    if (!_size)
+        return;
+
+    for (Entry const& entry : _largeEntries)
+        if ((entry.Flags & typeMask) && (entry.Flags & containers))
+            filter(entry);
+
+    // entries reaching into the box may have their position in a neighbour node
+    uint32 const lowX = ComputeNodeCoord(minX - MAX_NODE_ENTRY_RADIUS);
+    uint32 const lowY = ComputeNodeCoord(minY - MAX_NODE_ENTRY_RADIUS);
+    uint32 const highX = ComputeNodeCoord(maxX + MAX_NODE_ENTRY_RADIUS);
+    uint32 const highY = ComputeNodeCoord(maxY + MAX_NODE_ENTRY_RADIUS);
+
+    for (uint32 nodeX = lowX; nodeX <= highX; ++nodeX)
+    {
+        for (uint32 nodeY = lowY; nodeY <= highY; ++nodeY)
+        {
+            auto itr = _nodes.find(nodeX * NODES_PER_MAP + nodeY);
+            if (itr == _nodes.end())
+                continue;
+
+            for (uint32 type = 0; type < TYPE_COUNT; ++type)
+            {
+                EntryList const& list = itr->second->Lists[type];
+                if (!(typeMask & (1 << type)) || !(list.Containers & containers) || !list.Overlaps(minX, minY, maxX, maxY))
+                    continue;
+
+                for (Entry const& entry : list.Entries)
+                    if (entry.Flags & containers)
+                        filter(entry);
+            }
+        }
+    }
+}
+
+template<class Worker>
+void MapSpatialIndex::VisitCircle(float x, float y, float radius, uint32 typeMask, uint32 containers, Worker&& worker) const
+{
+    VisitLists(x - radius, y - radius, x + radius, y + radius, typeMask, containers, [&](Entry const& entry)
+    {
+        float const dx = entry.X - x;
+        float const dy = entry.Y - y;
+        float const reach = radius + entry.Radius;
+        if (dx * dx + dy * dy <= reach * reach)
+            worker(entry.Object);
+    });
+}
+
+template<class Worker>
+void MapSpatialIndex::VisitBox(float minX, float minY, float maxX, float maxY, uint32 typeMask, uint32 containers, Worker&& worker) const
+{
+    VisitLists(minX, minY, maxX, maxY, typeMask, containers, [&](Entry const& entry)
+    {
+        if (entry.X + entry.Radius >= minX && entry.X - entry.Radius <= maxX && entry.Y + entry.Radius >= minY && entry.Y - entry.Radius <= maxY)
+            worker(entry.Object);
+    });
+}
+
+template<class Worker>
+void MapSpatialIndex::VisitCone(float x, float y, float radius, float orientation, float arc, uint32 typeMask, uint32 containers, Worker&& worker) const
+{
+    float const halfArc = arc / 2.0f;
+    VisitLists(x - radius, y - radius, x + radius, y + radius, typeMask, containers, [&](Entry const& entry)
+    {
+        float const dx = entry.X - x;
+        float const dy = entry.Y - y;
+        float const reach = radius + entry.Radius;
+        float const distSq = dx * dx + dy * dy;
+        if (distSq > reach * reach)
+            return;
+
+        // objects overlapping the apex are in every direction
+        float const dist = std::sqrt(distSq);
+        if (dist <= entry.Radius)
+        {
+            worker(entry.Object);
+            return;
+        }
+
+        float const angle = std::remainder(std::atan2(dy, dx) - orientation, 2.0f * float(M_PI));
+        if (std::fabs(angle) <= halfArc + std::asin(entry.Radius / dist))
+            worker(entry.Object);
+    });
+}
+
+#endif
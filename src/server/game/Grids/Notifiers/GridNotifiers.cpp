@@ -152,6 +152,10 @@ inline void CreatureUnitRelocationWorker(Creature* c, Unit* u)
         return;
     }
 
+    // players coming within sight wake idle creatures the map stopped updating
+    if (c->IsMapUpdateSleeping() && u->IsPlayer() && c->IsWithinDist(u, c->m_SightDistance))
+        c->WakeMapUpdate();
+
     if (!c->HasUnitState(UNIT_STATE_SIGHTLESS))
     {
         if (c->IsAIEnabled && c->CanSeeOrDetect(u, false, true))
@@ -156,6 +156,9 @@ namespace Acore
 
     // SEARCHERS & LIST SEARCHERS & WORKERS
 
+    // List and last searchers also take single objects through VisitObject, so Cell can feed them from the
+    // spatial index of the map. First searchers and workers keep the cell order they were written for.
+
     // WorldObject searchers & workers
 
     // Generic base class to insert elements into arbitrary containers using push_back
@@ -222,6 +225,9 @@ namespace Acore
         void Visit(DynamicObjectMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+
+        void VisitObject(WorldObject* obj);
+        [[nodiscard]] uint32 GetSpatialTypeMask() const { return i_mapTypeMask; }
     };
 
     template<class Check>
@@ -243,6 +249,9 @@ namespace Acore
         void Visit(DynamicObjectMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+
+        void VisitObject(WorldObject* obj);
+        [[nodiscard]] uint32 GetSpatialTypeMask() const { return i_mapTypeMask; }
     };
 
     template<class Do>
@@ -333,6 +342,9 @@ namespace Acore
         void Visit(GameObjectMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+
+        void VisitObject(WorldObject* obj);
+        [[nodiscard]] uint32 GetSpatialTypeMask() const { return GRID_MAP_TYPE_MASK_GAMEOBJECT; }
     };
 
     template<class Check>
@@ -349,6 +361,9 @@ namespace Acore
         void Visit(GameObjectMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+
+        void VisitObject(WorldObject* obj);
+        [[nodiscard]] uint32 GetSpatialTypeMask() const { return GRID_MAP_TYPE_MASK_GAMEOBJECT; }
     };
 
     template<class Functor>
@@ -405,6 +420,9 @@ namespace Acore
         void Visit(PlayerMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+
+        void VisitObject(WorldObject* obj);
+        [[nodiscard]] uint32 GetSpatialTypeMask() const { return GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_PLAYER; }
     };
 
     // All accepted by Check units if any
@@ -423,6 +441,9 @@ namespace Acore
         void Visit(CreatureMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+
+        void VisitObject(WorldObject* obj);
+        [[nodiscard]] uint32 GetSpatialTypeMask() const { return GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_PLAYER; }
     };
 
     // Creature searchers
@@ -456,6 +477,9 @@ namespace Acore
         void Visit(CreatureMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+
+        void VisitObject(WorldObject* obj);
+        [[nodiscard]] uint32 GetSpatialTypeMask() const { return GRID_MAP_TYPE_MASK_CREATURE; }
     };
 
     template<class Check>
@@ -472,6 +496,9 @@ namespace Acore
         void Visit(CreatureMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+
+        void VisitObject(WorldObject* obj);
+        [[nodiscard]] uint32 GetSpatialTypeMask() const { return GRID_MAP_TYPE_MASK_CREATURE; }
     };
 
     template<class Do>
@@ -524,6 +551,9 @@ namespace Acore
         void Visit(PlayerMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+
+        void VisitObject(WorldObject* obj);
+        [[nodiscard]] uint32 GetSpatialTypeMask() const { return GRID_MAP_TYPE_MASK_PLAYER; }
     };
 
     template<class Check>
@@ -556,6 +586,9 @@ namespace Acore
         void Visit(PlayerMapType& m);
 
         template<class NOT_INTERESTED> void Visit(GridRefMgr<NOT_INTERESTED>&) {}
+
+        void VisitObject(WorldObject* obj);
+        [[nodiscard]] uint32 GetSpatialTypeMask() const { return GRID_MAP_TYPE_MASK_PLAYER; }
     };
 
     template<class Do>
@@ -44,6 +44,35 @@ inline void Acore::VisibleNotifier::Visit(GridRefMgr<T>& m)
 
 // SEARCHERS & LIST SEARCHERS & WORKERS
 
+namespace Acore
+{
+    // Passes an object found in the spatial index with the type its cell container would pass it with
+    template<class Func>
+    inline void VisitByGridType(WorldObject* obj, Func&& func)
+    {
+        switch (obj->GetTypeId())
+        {
+            case TYPEID_UNIT:
+                func(obj->ToCreature());
+                break;
+            case TYPEID_PLAYER:
+                func(obj->ToPlayer());
+                break;
+            case TYPEID_GAMEOBJECT:
+                func(obj->ToGameObject());
+                break;
+            case TYPEID_DYNAMICOBJECT:
+                func(obj->ToDynObject());
+                break;
+            case TYPEID_CORPSE:
+                func(obj->ToCorpse());
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 // WorldObject searchers & workers
 
 template<class Check>
@@ -241,6 +270,17 @@ void Acore::WorldObjectLastSearcher<Check>::Visit(DynamicObjectMapType& m)
     }
 }
 
+template<class Check>
+void Acore::WorldObjectLastSearcher<Check>::VisitObject(WorldObject* obj)
+{
+    VisitByGridType(obj, [this](auto* target)
+    {
+        if constexpr (requires { i_check(target); })
+            if (target->InSamePhase(i_phaseMask) && i_check(target))
+                i_object = target;
+    });
+}
+
 template<class Check>
 void Acore::WorldObjectListSearcher<Check>::Visit(PlayerMapType& m)
 {
@@ -296,6 +336,17 @@ void Acore::WorldObjectListSearcher<Check>::Visit(DynamicObjectMapType& m)
             Insert(itr->GetSource());
 }
 
+template<class Check>
+void Acore::WorldObjectListSearcher<Check>::VisitObject(WorldObject* obj)
+{
+    VisitByGridType(obj, [this](auto* target)
+    {
+        if constexpr (requires { i_check(target); })
+            if (i_check(target))
+                Insert(target);
+    });
+}
+
 // Gameobject searchers
 
 template<class Check>
@@ -331,6 +382,14 @@ void Acore::GameObjectLastSearcher<Check>::Visit(GameObjectMapType& m)
     }
 }
 
+template<class Check>
+void Acore::GameObjectLastSearcher<Check>::VisitObject(WorldObject* obj)
+{
+    GameObject* go = obj->ToGameObject();
+    if (go->InSamePhase(i_phaseMask) && i_check(go))
+        i_object = go;
+}
+
 template<class Check>
 void Acore::GameObjectListSearcher<Check>::Visit(GameObjectMapType& m)
 {
@@ -340,6 +399,14 @@ void Acore::GameObjectListSearcher<Check>::Visit(GameObjectMapType& m)
                 Insert(itr->GetSource());
 }
 
+template<class Check>
+void Acore::GameObjectListSearcher<Check>::VisitObject(WorldObject* obj)
+{
+    GameObject* go = obj->ToGameObject();
+    if (go->InSamePhase(i_phaseMask) && i_check(go))
+        Insert(go);
+}
+
 // Unit searchers
 
 template<class Check>
@@ -408,6 +475,17 @@ void Acore::UnitLastSearcher<Check>::Visit(PlayerMapType& m)
     }
 }
 
+template<class Check>
+void Acore::UnitLastSearcher<Check>::VisitObject(WorldObject* obj)
+{
+    VisitByGridType(obj, [this](auto* target)
+    {
+        if constexpr (std::is_base_of_v<Unit, std::remove_pointer_t<decltype(target)>>)
+            if (target->InSamePhase(i_phaseMask) && i_check(target))
+                i_object = target;
+    });
+}
+
 template<class Check>
 void Acore::UnitListSearcher<Check>::Visit(PlayerMapType& m)
 {
@@ -426,6 +504,17 @@ void Acore::UnitListSearcher<Check>::Visit(CreatureMapType& m)
                 Insert(itr->GetSource());
 }
 
+template<class Check>
+void Acore::UnitListSearcher<Check>::VisitObject(WorldObject* obj)
+{
+    VisitByGridType(obj, [this](auto* target)
+    {
+        if constexpr (std::is_base_of_v<Unit, std::remove_pointer_t<decltype(target)>>)
+            if (target->InSamePhase(i_phaseMask) && i_check(target))
+                Insert(target);
+    });
+}
+
 // Creature searchers
 
 template<class Check>
@@ -461,6 +550,14 @@ void Acore::CreatureLastSearcher<Check>::Visit(CreatureMapType& m)
     }
 }
 
+template<class Check>
+void Acore::CreatureLastSearcher<Check>::VisitObject(WorldObject* obj)
+{
+    Creature* creature = obj->ToCreature();
+    if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+        i_object = creature;
+}
+
 template<class Check>
 void Acore::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
 {
@@ -470,6 +567,14 @@ void Acore::CreatureListSearcher<Check>::Visit(CreatureMapType& m)
                 Insert(itr->GetSource());
 }
 
+template<class Check>
+void Acore::CreatureListSearcher<Check>::VisitObject(WorldObject* obj)
+{
+    Creature* creature = obj->ToCreature();
+    if (creature->InSamePhase(i_phaseMask) && i_check(creature))
+        Insert(creature);
+}
+
 template<class Check>
 void Acore::PlayerListSearcher<Check>::Visit(PlayerMapType& m)
 {
@@ -479,6 +584,14 @@ void Acore::PlayerListSearcher<Check>::Visit(PlayerMapType& m)
                 Insert(itr->GetSource());
 }
 
+template<class Check>
+void Acore::PlayerListSearcher<Check>::VisitObject(WorldObject* obj)
+{
+    Player* player = obj->ToPlayer();
+    if (player->InSamePhase(i_phaseMask) && i_check(player))
+        Insert(player);
+}
+
 template<class Check>
 void Acore::PlayerListSearcherWithSharedVision<Check>::Visit(PlayerMapType& m)
 {
@@ -531,6 +644,14 @@ void Acore::PlayerLastSearcher<Check>::Visit(PlayerMapType& m)
     }
 }
 
+template<class Check>
+void Acore::PlayerLastSearcher<Check>::VisitObject(WorldObject* obj)
+{
+    Player* player = obj->ToPlayer();
+    if (player->InSamePhase(i_phaseMask) && i_check(player))
+        i_object = player;
+}
+
 template<class Builder>
 void Acore::LocalizedPacketDo<Builder>::operator()(Player* p)
 {
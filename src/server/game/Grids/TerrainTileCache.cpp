@@ -0,0 +1,124 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TerrainTileCache.h"
+#include "GridTerrainData.h"
+
+TerrainTileCache::TerrainTileCache() : _residentBytes(0), _hits(0), _loads(0)
+{
+}
+
+TerrainTileCache* TerrainTileCache::instance()
+{
+    // Never destroyed, grids may release their tiles during static destruction
+    static TerrainTileCache* instance = new TerrainTileCache();
+    return instance;
+}
+
+std::shared_ptr<GridTerrainData> TerrainTileCache::Find(uint32 mapId, uint16 x, uint16 y)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto itr = _tiles.find(MakeKey(mapId, x, y));
+    if (itr == _tiles.end())
+        return nullptr;
+
+    std::shared_ptr<GridTerrainData> terrain = itr->second.Terrain.lock();
+    if (terrain)
+        ++_hits;
+
+    return terrain;
+}
+
+std::shared_ptr<GridTerrainData> TerrainTileCache::Insert(uint32 mapId, uint16 x, uint16 y, std::unique_ptr<GridTerrainData> terrain)
+{
+    uint64 const key = MakeKey(mapId, x, y);
+    std::size_t const size = terrain->GetMemoryUsage();
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    Tile& tile = _tiles[key];
+    if (std::shared_ptr<GridTerrainData> existing = tile.Terrain.lock())
+    {
+        ++_hits;
+        return existing;
+    }
+
+    // an expired tile whose deleter did not run yet is replaced, Release only removes its own tile
+    if (tile.Data)
+        _residentBytes -= tile.Size;
+
+    std::shared_ptr<GridTerrainData> shared(terrain.release(), [this, key](GridTerrainData* data) { Release(key, data); });
+    tile.Terrain = shared;
+    tile.Data = shared.get();
+    tile.Size = size;
+
+    _residentBytes += size;
+    ++_loads;
+    return shared;
+}
+
+void TerrainTileCache::Release(uint64 key, GridTerrainData* terrain)
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        auto itr = _tiles.find(key);
+        if (itr != _tiles.end() && itr->second.Data == terrain)
+        {
+            _residentBytes -= itr->second.Size;
+            _tiles.erase(itr);
+        }
+    }
+
+    delete terrain;
+}
+
+std::size_t TerrainTileCache::GetResidentTiles() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _tiles.size();
+}
+
+std::size_t TerrainTileCache::GetResidentBytes() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _residentBytes;
+}
+
+std::size_t TerrainTileCache::GetReferences() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    std::size_t references = 0;
+    for (auto const& [key, tile] : _tiles)
+        references += tile.Terrain.use_count();
+
+    return references;
+}
+
+uint64 TerrainTileCache::GetHits() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _hits;
+}
+
+uint64 TerrainTileCache::GetLoads() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _loads;
+}
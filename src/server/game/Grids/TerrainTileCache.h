@@ -0,0 +1,84 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_TERRAIN_TILE_CACHE_H
+#define ACORE_TERRAIN_TILE_CACHE_H
+
+#include "Define.h"
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+class GridTerrainData;
+
+/*
+ * Keeps one copy of the terrain of every grid of every map.
+ *
+ * Grids of a map and of all its instances hold a reference to the same
+ * read-only GridTerrainData; the tile leaves the cache when the last grid
+ * referencing it is unloaded. Maps update on different threads, so every
+ * access takes the cache lock.
+ */
+class TerrainTileCache
+{
+public:
+    static TerrainTileCache* instance();
+
+    // The terrain of the grid if any map still references it
+    std::shared_ptr<GridTerrainData> Find(uint32 mapId, uint16 x, uint16 y);
+
+    // Shares a freshly loaded tile. If another map inserted the same tile meanwhile that one is returned and terrain is dropped.
+    std::shared_ptr<GridTerrainData> Insert(uint32 mapId, uint16 x, uint16 y, std::unique_ptr<GridTerrainData> terrain);
+
+    [[nodiscard]] std::size_t GetResidentTiles() const;
+    [[nodiscard]] std::size_t GetResidentBytes() const;
+
+    // Number of grids holding a cached tile, the tiles a per map copy would have loaded
+    [[nodiscard]] std::size_t GetReferences() const;
+
+    [[nodiscard]] uint64 GetHits() const;
+    [[nodiscard]] uint64 GetLoads() const;
+
+private:
+    TerrainTileCache();
+    ~TerrainTileCache() = default;
+
+    TerrainTileCache(TerrainTileCache const&) = delete;
+    TerrainTileCache& operator=(TerrainTileCache const&) = delete;
+
+    struct Tile
+    {
+        std::weak_ptr<GridTerrainData> Terrain;
+        GridTerrainData const* Data = nullptr;
+        std::size_t Size = 0;
+    };
+
+    static uint64 MakeKey(uint32 mapId, uint16 x, uint16 y) { return (uint64(mapId) << 32) | (uint32(x) << 16) | y; }
+
+    // Deleter of the shared tiles
+    void Release(uint64 key, GridTerrainData* terrain);
+
+    mutable std::mutex _lock;
+    std::unordered_map<uint64, Tile> _tiles;
+    std::size_t _residentBytes;
+    uint64 _hits;
+    uint64 _loads;
+};
+
+#define sTerrainTileCache TerrainTileCache::instance()
+
+#endif
@@ -128,6 +128,8 @@ void WorldSession::HandleAddIgnoreOpcode(WorldPacket& recv_data)
         // ignore list full
         if (!GetPlayer()->GetSocial()->AddToSocialList(ignoreGuid, SOCIAL_FLAG_IGNORED))
             ignoreResult = FRIEND_IGNORE_FULL;
+        else
+            GetPlayer()->UpdateChannelIgnore(ignoreGuid, true);
     }
 
     sSocialMgr->SendFriendStatus(GetPlayer(), ignoreResult, ignoreGuid, false);
@@ -141,6 +143,7 @@ void WorldSession::HandleDelIgnoreOpcode(WorldPacket& recv_data)
     recv_data >> IgnoreGUID;
 
     _player->GetSocial()->RemoveFromSocialList(IgnoreGUID, SOCIAL_FLAG_IGNORED);
+    _player->UpdateChannelIgnore(IgnoreGUID, false);
     sSocialMgr->SendFriendStatus(GetPlayer(), FRIEND_IGNORE_REMOVED, IgnoreGUID, false);
 }
 
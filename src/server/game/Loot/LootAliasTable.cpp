@@ -0,0 +1,90 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LootAliasTable.h"
+
+namespace
+{
+    // Totals within this distance of 100% are treated as exactly 100%
+    constexpr double LOOT_CHANCE_EPSILON = 0.0001;
+}
+
+bool LootAliasTable::Build(std::vector<float> const& chances)
+{
+    _columns.clear();
+
+    double total = 0.0;
+    for (float chance : chances)
+    {
+        if (chance <= 0.0f)
+            return false;
+
+        total += chance;
+    }
+
+    if (chances.empty() || total > 100.0 + LOOT_CHANCE_EPSILON)
+        return false;
+
+    // outcomes are the entries plus the empty pick taking what is left up to 100%
+    std::vector<double> weights(chances.begin(), chances.end());
+    std::vector<int32> outcomes(chances.size());
+    for (std::size_t i = 0; i < chances.size(); ++i)
+        outcomes[i] = int32(i);
+
+    if (total < 100.0 - LOOT_CHANCE_EPSILON)
+    {
+        weights.push_back(100.0 - total);
+        outcomes.push_back(NO_ENTRY);
+        total = 100.0;
+    }
+
+    std::size_t const count = weights.size();
+    std::vector<double> scaled(count);
+    std::vector<std::size_t> small;
+    std::vector<std::size_t> large;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        scaled[i] = weights[i] * count / total;
+        (scaled[i] < 1.0 ? small : large).push_back(i);
+    }
+
+    _columns.resize(count);
+    while (!small.empty() && !large.empty())
+    {
+        std::size_t const less = small.back();
+        small.pop_back();
+        std::size_t const more = large.back();
+
+        _columns[less] = { scaled[less], outcomes[less], outcomes[more] };
+
+        scaled[more] -= 1.0 - scaled[less];
+        if (scaled[more] < 1.0)
+        {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+
+    // leftovers are full columns, up to rounding errors
+    for (std::size_t i : large)
+        _columns[i] = { 1.0, outcomes[i], outcomes[i] };
+
+    for (std::size_t i : small)
+        _columns[i] = { 1.0, outcomes[i], outcomes[i] };
+
+    return true;
+}
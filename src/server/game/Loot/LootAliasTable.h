@@ -0,0 +1,63 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_LOOT_ALIAS_TABLE_H
+#define ACORE_LOOT_ALIAS_TABLE_H
+
+#include "Define.h"
+#include <vector>
+
+/*
+ * Walker/Vose alias table over the explicitly chanced entries of a loot group.
+ *
+ * Entry i is picked with chances[i] percent and the remaining chance up to 100%
+ * picks no entry, which is what the cumulative group roll produces as long as the
+ * chances add up to 100% or less. A pick costs one column and one coin instead
+ * of walking the entries. Overfull groups cut off their last entries when rolled
+ * cumulatively, they can not be represented and keep the cumulative roll.
+ */
+class LootAliasTable
+{
+public:
+    static constexpr int32 NO_ENTRY = -1;
+
+    // Returns false if the chances can not be represented (total above 100%)
+    bool Build(std::vector<float> const& chances);
+    void Clear() { _columns.clear(); }
+
+    [[nodiscard]] bool IsEmpty() const { return _columns.empty(); }
+    [[nodiscard]] uint32 GetColumnCount() const { return uint32(_columns.size()); }
+
+    // column in [0, GetColumnCount()), coin in [0, 1); returns the entry index or NO_ENTRY
+    [[nodiscard]] int32 Roll(uint32 column, double coin) const
+    {
+        Column const& picked = _columns[column];
+        return coin < picked.Probability ? picked.Primary : picked.Alias;
+    }
+
+private:
+    struct Column
+    {
+        double Probability;
+        int32 Primary;
+        int32 Alias;
+    };
+
+    std::vector<Column> _columns;
+};
+
+#endif
@@ -21,6 +21,7 @@
 #include "Group.h"
 #include "ItemEnchantmentMgr.h"
 #include "Log.h"
+#include "LootAliasTable.h"
 #include "ObjectMgr.h"
 #include "Player.h"
 #include "ScriptMgr.h"
@@ -111,10 +112,16 @@ public:
     LootStoreItemList* GetExplicitlyChancedItemList() { return &ExplicitlyChanced; }
     LootStoreItemList* GetEqualChancedItemList() { return &EqualChanced; }
     void CopyConditions(ConditionList conditions);
+    void ResolveReferences();
+    void BuildRollTable();                              // Flattens the entries and builds the alias table of the explicitly chanced ones
 private:
     LootStoreItemList ExplicitlyChanced;                // Entries with chances defined in DB
     LootStoreItemList EqualChanced;                     // Zero chances - every entry takes the same chance
 
+    std::vector<LootStoreItem*> _explicitEntries;       // ExplicitlyChanced in contiguous storage, indexed by the alias table
+    std::vector<LootStoreItem*> _equalEntries;          // EqualChanced in contiguous storage
+    LootAliasTable _rollTable;                          // Empty if the explicit chances exceed 100%
+
     LootStoreItem const* Roll(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode) const;   // Rolls an item from the group, returns nullptr if all miss their chances
 
     // This class must never be copied - storing pointers
@@ -122,6 +129,12 @@ private:
     LootGroup& operator=(LootGroup const&);
 };
 
+void LootStore::ResolveReferences()
+{
+    for (LootTemplateMap::value_type const& itr : m_LootTemplates)
+        itr.second->ResolveReferences();
+}
+
 //Remove all data and free all memory
 void LootStore::Clear()
 {
@@ -212,6 +225,11 @@ uint32 LootStore::LoadLootTable()
 
     Verify();                                           // Checks validity of the loot store
 
+    for (LootTemplateMap::value_type const& itr : m_LootTemplates)
+        itr.second->BuildRollTables();
+
+    ResolveReferences();
+
     return count;
 }
 
@@ -1283,24 +1301,41 @@ LootTemplate::LootGroup::~LootGroup()
 void LootTemplate::LootGroup::AddEntry(LootStoreItem* item)
 {
     if (item->chance != 0)
+    {
         ExplicitlyChanced.push_back(item);
+        _explicitEntries.push_back(item);
+    }
     else
+    {
         EqualChanced.push_back(item);
+        _equalEntries.push_back(item);
+    }
+
+    // rolled cumulatively until the table is built again
+    _rollTable.Clear();
 }
 
 // Rolls an item from the group, returns nullptr if all miss their chances
 LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, Player const* player, LootStore const& store, uint16 lootMode) const
 {
-    LootStoreItemList possibleLoot = ExplicitlyChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
+    LootGroupInvalidSelector isInvalid(loot, lootMode);
 
-    if (!possibleLoot.empty())                             // First explicitly chanced entries are checked
+    if (!_rollTable.IsEmpty() && !sScriptMgr->HasItemRollHooks())
+    {
+        // An entry that can not drop is a miss, exactly as when it is skipped by the cumulative roll below
+        int32 const index = _rollTable.Roll(urand(0, _rollTable.GetColumnCount() - 1), rand_norm());
+        if (index != LootAliasTable::NO_ENTRY && !isInvalid(_explicitEntries[index]))
+            return _explicitEntries[index];
+    }
+    else if (!_explicitEntries.empty())                     // First explicitly chanced entries are checked
     {
         float roll = (float)rand_chance();
 
-        for (LootStoreItemList::const_iterator itr = possibleLoot.begin(); itr != possibleLoot.end(); ++itr)   // check each explicitly chanced entry in the template and modify its chance based on quality.
+        for (LootStoreItem* item : _explicitEntries)        // check each explicitly chanced entry in the template and modify its chance based on quality.
         {
-            LootStoreItem* item = *itr;
+            if (isInvalid(item))
+                continue;
+
             float chance = item->chance;
 
             if (!sScriptMgr->OnItemRoll(player, item, chance, loot, store))
@@ -1318,12 +1353,37 @@ LootStoreItem const* LootTemplate::LootGroup::Roll(Loot& loot, Player const* pla
     if (!sScriptMgr->OnBeforeLootEqualChanced(player, EqualChanced, loot, store))
         return nullptr;
 
-    possibleLoot = EqualChanced;
-    possibleLoot.remove_if(LootGroupInvalidSelector(loot, lootMode));
-    if (!possibleLoot.empty())                              // If nothing selected yet - an item is taken from equal-chanced part
-        return Acore::Containers::SelectRandomContainerElement(possibleLoot);
+    // If nothing selected yet - an item is taken from equal-chanced part
+    uint32 possibleCount = std::count_if(_equalEntries.begin(), _equalEntries.end(), [&isInvalid](LootStoreItem* item) { return !isInvalid(item); });
+    if (!possibleCount)
+        return nullptr;                                     // Empty drop from the group
+
+    uint32 pick = urand(0, possibleCount - 1);
+    for (LootStoreItem* item : _equalEntries)
+        if (!isInvalid(item) && !pick--)
+            return item;
+
+    return nullptr;
+}
+
+void LootTemplate::LootGroup::ResolveReferences()
+{
+    for (LootStoreItem* item : _explicitEntries)
+        item->referencedTemplate = item->reference ? LootTemplates_Reference.GetLootFor(std::abs(item->reference)) : nullptr;
 
-    return nullptr;                                            // Empty drop from the group
+    for (LootStoreItem* item : _equalEntries)
+        item->referencedTemplate = item->reference ? LootTemplates_Reference.GetLootFor(std::abs(item->reference)) : nullptr;
+}
+
+void LootTemplate::LootGroup::BuildRollTable()
+{
+    std::vector<float> chances;
+    chances.reserve(_explicitEntries.size());
+    for (LootStoreItem const* item : _explicitEntries)
+        chances.push_back(item->chance);
+
+    if (!_rollTable.Build(chances))
+        _rollTable.Clear();
 }
 
 // True if group includes at least 1 quest drop entry
@@ -1444,7 +1504,7 @@ void LootTemplate::LootGroup::Process(Loot& loot, Player const* player, LootStor
 
         if (item->reference) // References processing
         {
-            if (LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(std::abs(item->reference)))
+            if (LootTemplate const* Referenced = item->referencedTemplate)
             {
                 uint32 maxcount = uint32(float(item->maxcount) * sWorld->getRate(RATE_DROP_ITEM_REFERENCED_AMOUNT));
                 sScriptMgr->OnAfterRefCount(player, loot, rate, lootMode, const_cast<LootStoreItem*>(item), maxcount, store);
@@ -1561,6 +1621,9 @@ LootTemplate::~LootTemplate()
 // Adds an entry to the group (at loading stage)
 void LootTemplate::AddEntry(LootStoreItem* item)
 {
+    if (item->reference)
+        item->referencedTemplate = LootTemplates_Reference.GetLootFor(std::abs(item->reference));
+
     // `item->reference` > 0 --> Reference is counted as a normal and non grouped entry
     // `item->reference` < 0 --> Reference is counted as grouped entry within shared groupid
     if (item->groupid > 0 && item->reference <= 0)  // Group and grouped reference
@@ -1581,6 +1644,23 @@ void LootTemplate::AddEntry(LootStoreItem* item)
         Entries.push_back(item);
 }
 
+void LootTemplate::ResolveReferences()
+{
+    for (LootStoreItem* item : Entries)
+        item->referencedTemplate = item->reference ? LootTemplates_Reference.GetLootFor(std::abs(item->reference)) : nullptr;
+
+    for (LootGroup* group : Groups)
+        if (group)
+            group->ResolveReferences();
+}
+
+void LootTemplate::BuildRollTables()
+{
+    for (LootGroup* group : Groups)
+        if (group)
+            group->BuildRollTable();
+}
+
 void LootTemplate::CopyConditions(ConditionList conditions)
 {
     for (LootStoreItemList::iterator i = Entries.begin(); i != Entries.end(); ++i)
@@ -1731,7 +1811,7 @@ void LootTemplate::Process(Loot& loot, LootStore const& store, uint16 lootMode,
 
         if (item->reference)                                    // References processing
         {
-            LootTemplate const* Referenced = LootTemplates_Reference.GetLootFor(std::abs(item->reference));
+            LootTemplate const* Referenced = item->referencedTemplate;
             if (!Referenced)
                 continue;                                       // Error message already printed at loading stage
 
@@ -2368,6 +2448,20 @@ void LoadLootTemplates_Reference()
     // output error for any still listed ids (not referenced from any loot table)
     LootTemplates_Reference.ReportUnusedIds(lootIdSet);
 
+    // reference templates were replaced, repoint every store to them
+    LootTemplates_Creature.ResolveReferences();
+    LootTemplates_Disenchant.ResolveReferences();
+    LootTemplates_Fishing.ResolveReferences();
+    LootTemplates_Gameobject.ResolveReferences();
+    LootTemplates_Item.ResolveReferences();
+    LootTemplates_Mail.ResolveReferences();
+    LootTemplates_Milling.ResolveReferences();
+    LootTemplates_Pickpocketing.ResolveReferences();
+    LootTemplates_Prospecting.ResolveReferences();
+    LootTemplates_Skinning.ResolveReferences();
+    LootTemplates_Spell.ResolveReferences();
+    LootTemplates_Player.ResolveReferences();
+
     LOG_INFO("server.loading", ">> Loaded reference loot templates in {} ms", GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
@@ -120,6 +120,7 @@ enum LootSlotType
 
 class Player;
 class LootStore;
+class LootTemplate;
 class ConditionMgr;
 class GameObject;
 struct Loot;
@@ -135,12 +136,13 @@ struct LootStoreItem
     uint8   mincount;                           // mincount for drop items
     uint8   maxcount;                           // max drop count for the item mincount or Ref multiplicator
     ConditionList conditions;                   // additional loot condition
+    LootTemplate const* referencedTemplate;     // resolved reference template, kept up to date by LootStore::ResolveReferences
 
     // Constructor
     // displayid is filled in IsValid() which must be called after
     LootStoreItem(uint32 _itemid, int32 _reference, float _chance, bool _needs_quest, uint16 _lootmode, uint8 _groupid, int32 _mincount, uint8 _maxcount)
         : itemid(_itemid), reference(_reference), chance(_chance), needs_quest(_needs_quest),
-          lootmode(_lootmode), groupid(_groupid), mincount(_mincount), maxcount(_maxcount)
+          lootmode(_lootmode), groupid(_groupid), mincount(_mincount), maxcount(_maxcount), referencedTemplate(nullptr)
     {}
 
     bool Roll(bool rate, Player const* player, Loot& loot, LootStore const& store) const;   // Checks if the entry takes it's chance (at loot generation)
@@ -210,6 +212,8 @@ public:
 
     uint32 LoadAndCollectLootIds(LootIdSet& ids_set);
     void ResetConditions();
+    // Points reference entries to the current reference templates, needed after any of both stores was (re)loaded
+    void ResolveReferences();
 
     void Verify() const;
     void CheckLootRefs(LootIdSet* ref_set = nullptr) const; // check existence reference and remove it from ref_set
@@ -264,6 +268,10 @@ public:
     bool addConditionItem(Condition* cond);
     [[nodiscard]] bool isReference(uint32 id) const;
 
+    void ResolveReferences();
+    // Builds the roll tables of the groups, called once all entries were added
+    void BuildRollTables();
+
 private:
     LootStoreItemList Entries;                          // not grouped only
     LootGroups        Groups;                           // groups have own (optimised) processing, grouped entries go there
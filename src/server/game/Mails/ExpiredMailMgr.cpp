@@ -0,0 +1,271 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ExpiredMailMgr.h"
+#include "CharacterCache.h"
+#include "DatabaseEnv.h"
+#include "GameTime.h"
+#include "Log.h"
+#include "Mail.h"
+#include "ObjectAccessor.h"
+#include "QueryCallback.h"
+#include "Timer.h"
+#include "World.h"
+#include <unordered_map>
+
+namespace
+{
+    // a page is handled within a few updates, so the mails read change little before they are written
+    constexpr uint32 EXPIRED_MAIL_PAGE_SIZE = 1000;
+}
+
+ExpiredMailMgr* ExpiredMailMgr::instance()
+{
+    static ExpiredMailMgr instance;
+    return &instance;
+}
+
+void ExpiredMailMgr::ReturnOrDeleteAll()
+{
+    if (_running)
+        return;
+
+    BeginPass();
+
+    while (!_lastPage)
+    {
+        if (LoadMails(CharacterDatabase.Query(GetMailsStatement())))
+            LoadItems(CharacterDatabase.Query(GetItemsStatement()));
+
+        ProcessBatch(_mails.size(), false);
+    }
+
+    Finish();
+}
+
+void ExpiredMailMgr::Start()
+{
+    if (_running)
+        return;
+
+    BeginPass();
+
+    QueryNextPage();
+}
+
+void ExpiredMailMgr::BeginPass()
+{
+    _running = true;
+    _expireTime = GameTime::GetGameTime().count();
+    _lastMailId = 0;
+    _lastPage = false;
+    _deletedCount = 0;
+    _returnedCount = 0;
+    _startTime = getMSTime();
+}
+
+void ExpiredMailMgr::Update()
+{
+    _queryProcessor.ProcessReadyCallbacks();
+
+    if (!_running || _queryPending)
+        return;
+
+    ProcessBatch(sWorld->getIntConfig(CONFIG_MAIL_EXPIRATION_BATCH_SIZE), true);
+
+    if (!_mails.empty())
+        return;
+
+    if (_lastPage)
+        Finish();
+    else
+        QueryNextPage();
+}
+
+CharacterDatabasePreparedStatement* ExpiredMailMgr::GetMailsStatement() const
+{
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL);
+    stmt->SetData(0, uint32(_expireTime));
+    stmt->SetData(1, _lastMailId);
+    stmt->SetData(2, EXPIRED_MAIL_PAGE_SIZE);
+    return stmt;
+}
+
+CharacterDatabasePreparedStatement* ExpiredMailMgr::GetItemsStatement() const
+{
+    CharacterDatabasePreparedStatement* stmt = CharacterDatabase.GetPreparedStatement(CHAR_SEL_EXPIRED_MAIL_ITEMS);
+    stmt->SetData(0, uint32(_expireTime));
+    stmt->SetData(1, _pageFirstMailId);
+    stmt->SetData(2, _lastMailId);
+    return stmt;
+}
+
+bool ExpiredMailMgr::LoadMails(PreparedQueryResult result)
+{
+    _pageFirstMailId = _lastMailId;
+    _lastPage = !result || result->GetRowCount() < EXPIRED_MAIL_PAGE_SIZE;
+    if (!result)
+        return false;
+
+    bool hasItems = false;
+    do
+    {
+        Field* fields = result->Fetch();
+        ExpiredMail& mail = _mails.emplace_back();
+        mail.messageID   = fields[0].Get<uint32>();
+        mail.messageType = fields[1].Get<uint8>();
+        mail.sender      = fields[2].Get<uint32>();
+        mail.receiver    = fields[3].Get<uint32>();
+        mail.hasItems    = fields[4].Get<bool>();
+        mail.stationery  = fields[5].Get<uint8>();
+        mail.checked     = fields[6].Get<uint8>();
+
+        _lastMailId = mail.messageID;
+        hasItems = hasItems || mail.hasItems;
+    } while (result->NextRow());
+
+    return hasItems;
+}
+
+void ExpiredMailMgr::LoadItems(PreparedQueryResult result)
+{
+    if (!result)
+        return;
+
+    // the page is at the back of the queue, ordered by id
+    std::unordered_map<uint32, ExpiredMail*> pageMails;
+    for (auto itr = _mails.rbegin(); itr != _mails.rend() && itr->messageID > _pageFirstMailId; ++itr)
+        pageMails[itr->messageID] = &*itr;
+
+    do
+    {
+        Field* fields = result->Fetch();
+        auto itr = pageMails.find(fields[2].Get<uint32>());
+        if (itr != pageMails.end())
+            itr->second->AddItem(fields[0].Get<uint32>(), fields[1].Get<uint32>());
+    } while (result->NextRow());
+}
+
+void ExpiredMailMgr::QueryNextPage()
+{
+    _queryPending = true;
+
+    _queryProcessor.AddCallback(CharacterDatabase.AsyncQuery(GetMailsStatement())
+        .WithChainingPreparedCallback([this](QueryCallback& callback, PreparedQueryResult result)
+        {
+            if (LoadMails(std::move(result)))
+                callback.SetNextQuery(CharacterDatabase.AsyncQuery(GetItemsStatement()));
+            else
+                _queryPending = false;
+        })
+        .WithChainingPreparedCallback([this](QueryCallback& /*callback*/, PreparedQueryResult result)
+        {
+            LoadItems(std::move(result));
+            _queryPending = false;
+        }));
+}
+
+void ExpiredMailMgr::ProcessBatch(uint32 count, bool serverUp)
+{
+    if (_mails.empty())
+        return;
+
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    for (; count && !_mails.empty(); --count)
+    {
+        // don't modify mails of a logged in player
+        if (!serverUp || !ObjectAccessor::FindPlayerByLowGUID(_mails.front().receiver))
+            ReturnOrDelete(_mails.front(), trans);
+
+        _mails.pop_front();
+    }
+
+    if (trans->GetSize())
+        CharacterDatabase.CommitTransaction(trans);
+}
+
+void ExpiredMailMgr::ReturnOrDelete(ExpiredMail const& mail, CharacterDatabaseTransaction trans)
+{
+    CharacterDatabasePreparedStatement* stmt = nullptr;
+
+    if (mail.hasItems)
+    {
+        // If it is mail from non-player, or if it's already return mail, it shouldn't be returned, but deleted
+        if (!mail.IsSentByPlayer() || mail.IsSentByGM() || (mail.IsCODPayment() || mail.IsReturnedMail()))
+        {
+            for (auto const& mailedItem : mail.items)
+            {
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_ITEM_INSTANCE);
+                stmt->SetData(0, mailedItem.item_guid);
+                trans->Append(stmt);
+            }
+
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_ITEM_BY_ID);
+            stmt->SetData(0, mail.messageID);
+            trans->Append(stmt);
+        }
+        else
+        {
+            time_t const curTime = GameTime::GetGameTime().count();
+
+            // Mail will be returned
+            stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_RETURNED);
+            stmt->SetData(0, mail.receiver);
+            stmt->SetData(1, mail.sender);
+            stmt->SetData(2, uint32(curTime + 30 * DAY));
+            stmt->SetData(3, uint32(curTime));
+            stmt->SetData(4, uint8(MAIL_CHECK_MASK_RETURNED));
+            stmt->SetData(5, mail.messageID);
+            trans->Append(stmt);
+
+            for (auto const& mailedItem : mail.items)
+            {
+                // Update receiver in mail items for its proper delivery, and in instance_item for avoid lost item at sender delete
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_MAIL_ITEM_RECEIVER);
+                stmt->SetData(0, mail.sender);
+                stmt->SetData(1, mailedItem.item_guid);
+                trans->Append(stmt);
+
+                stmt = CharacterDatabase.GetPreparedStatement(CHAR_UPD_ITEM_OWNER);
+                stmt->SetData(0, mail.sender);
+                stmt->SetData(1, mailedItem.item_guid);
+                trans->Append(stmt);
+            }
+
+            // xinef: update global data
+            sCharacterCache->IncreaseCharacterMailCount(ObjectGuid(HighGuid::Player, mail.sender));
+            sCharacterCache->DecreaseCharacterMailCount(ObjectGuid(HighGuid::Player, mail.receiver));
+            ++_returnedCount;
+            return;
+        }
+    }
+
+    sCharacterCache->DecreaseCharacterMailCount(ObjectGuid(HighGuid::Player, mail.receiver));
+
+    stmt = CharacterDatabase.GetPreparedStatement(CHAR_DEL_MAIL_BY_ID);
+    stmt->SetData(0, mail.messageID);
+    trans->Append(stmt);
+    ++_deletedCount;
+}
+
+void ExpiredMailMgr::Finish()
+{
+    _running = false;
+
+    if (_deletedCount + _returnedCount)
+        LOG_INFO("server.loading", ">> Processed {} expired mails: {} deleted and {} returned in {} ms", _deletedCount + _returnedCount, _deletedCount, _returnedCount, GetMSTimeDiffToNow(_startTime));
+}
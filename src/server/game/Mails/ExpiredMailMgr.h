@@ -0,0 +1,101 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @file ExpiredMailMgr.h
+ * @brief Returns expired mails to their senders or deletes them.
+ *
+ * Expired mails are read in pages ordered by mail id. While the world is running the pages
+ * are fetched asynchronously and handled in batches of MailExpiration.BatchSize mails per
+ * world update, every batch written in one transaction, so the world thread never waits
+ * for the character database.
+ */
+
+#ifndef _EXPIREDMAILMGR_H
+#define _EXPIREDMAILMGR_H
+
+#include "AsyncCallbackProcessor.h"
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include "Mail.h"
+#include <ctime>
+#include <deque>
+#include <vector>
+
+class ExpiredMailMgr
+{
+private:
+    ExpiredMailMgr() = default;
+    ~ExpiredMailMgr() = default;
+
+public:
+    static ExpiredMailMgr* instance();
+
+    /**
+     * @brief Handles every mail that expired while the server was down.
+     *
+     * Blocks until all pages are read, intended for startup when no player is online.
+     */
+    void ReturnOrDeleteAll();
+
+    /**
+     * @brief Starts a pass over the mails expired by now, a running pass is left alone.
+     */
+    void Start();
+
+    /**
+     * @brief Handles finished page queries and at most one batch of the fetched mails.
+     */
+    void Update();
+
+    [[nodiscard]] bool IsRunning() const { return _running; }
+
+private:
+    struct ExpiredMail : Mail
+    {
+        bool hasItems;                                      // has_items of the mail row, its items can be missing
+    };
+
+    CharacterDatabasePreparedStatement* GetMailsStatement() const;
+    CharacterDatabasePreparedStatement* GetItemsStatement() const;
+
+    // Appends a page to the pending mails, true if some of them have items to read
+    bool LoadMails(PreparedQueryResult result);
+    void LoadItems(PreparedQueryResult result);
+
+    void BeginPass();
+    void QueryNextPage();
+    void ProcessBatch(uint32 count, bool serverUp);
+    void ReturnOrDelete(ExpiredMail const& mail, CharacterDatabaseTransaction trans);
+    void Finish();
+
+    QueryCallbackProcessor _queryProcessor;
+    std::deque<ExpiredMail> _mails;                         // fetched and not handled yet, ordered by id
+    time_t _expireTime{ 0 };                                // mails expired before this time are handled by the pass
+    uint32 _lastMailId{ 0 };                                // highest mail id fetched so far
+    uint32 _pageFirstMailId{ 0 };                           // items of the page have mail ids above this one
+    uint32 _startTime{ 0 };
+    uint32 _deletedCount{ 0 };
+    uint32 _returnedCount{ 0 };
+    bool _running{ false };
+    bool _queryPending{ false };
+    bool _lastPage{ false };
+};
+
+#define sExpiredMailMgr ExpiredMailMgr::instance()
+
+#endif
@@ -0,0 +1,342 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "GridPreloader.h"
+#include "DisableMgr.h"
+#include "Map.h"
+#include "MapMgr.h"
+#include "MapTree.h"
+#include "MotionMaster.h"
+#include "Player.h"
+#include "StringFormat.h"
+#include "WaypointMovementGenerator.h"
+#include "World.h"
+#include <cmath>
+#include <fstream>
+
+namespace
+{
+    // How often the movement of the players is sampled
+    constexpr uint32 GRID_PRELOAD_PREDICT_INTERVAL = 1000;
+
+    // Faster movement is a teleport, slower movement does not leave the loaded grids in time
+    constexpr float GRID_PRELOAD_MAX_SPEED = 100.0f;
+    constexpr float GRID_PRELOAD_MIN_SPEED = 2.0f;
+
+    // Taxi speed, used to measure how far ahead on a flight path grids are preloaded
+    constexpr float GRID_PRELOAD_FLIGHT_SPEED = 32.0f;
+
+    // Preloaded terrain nobody took within this time after the look ahead is dropped
+    constexpr uint32 GRID_PRELOAD_EXPIRE_MARGIN = 30000;
+
+    // Grids queued or read ahead per map, further requests are dropped until some are taken or expire
+    constexpr std::size_t GRID_PRELOAD_MAX_PENDING = 256;
+
+    inline uint32 GetPendingKey(uint16 x, uint16 y)
+    {
+        return uint32(x) * MAX_NUMBER_OF_GRIDS + y;
+    }
+}
+
+GridPreloadTask::GridPreloadTask(uint32 mapId, uint16 x, uint16 y, bool warmNavMesh)
+    : _mapId(mapId), _x(x), _y(y), _warmNavMesh(warmNavMesh), _state(State::Queued), _result(TerrainMapDataReadResult::NotFound)
+{
+}
+
+void GridPreloadTask::Execute()
+{
+    State expected = State::Queued;
+    if (!_state.compare_exchange_strong(expected, State::Running))
+        return;
+
+    std::string const& dataPath = sWorld->GetDataPath();
+
+    std::unique_ptr<GridTerrainData> terrain = std::make_unique<GridTerrainData>();
+    TerrainMapDataReadResult result = terrain->Load(Acore::StringFormat("{}maps/{:03}{:02}{:02}.map", dataPath, _mapId, _x, _y));
+
+    WarmFile(dataPath + "vmaps/" + VMAP::StaticMapTree::getTileFileName(_mapId, _x, _y));
+
+    if (_warmNavMesh)
+        WarmFile(Acore::StringFormat("{}/mmaps/{:03}{:02}{:02}.mmtile", dataPath, _mapId, _x, _y));
+
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (result == TerrainMapDataReadResult::Success)
+            _terrain = std::move(terrain);
+
+        _result = result;
+        _state.store(State::Done, std::memory_order_release);
+    }
+
+    _finished.notify_all();
+}
+
+bool GridPreloadTask::Complete()
+{
+    State expected = State::Queued;
+    if (_state.compare_exchange_strong(expected, State::Cancelled) || expected == State::Cancelled)
+        return false;
+
+    std::unique_lock<std::mutex> guard(_lock);
+    _finished.wait(guard, [this] { return _state.load(std::memory_order_acquire) == State::Done; });
+    return true;
+}
+
+void GridPreloadTask::WarmFile(std::string const& fileName)
+{
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file)
+        return;
+
+    char buffer[64 * 1024];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        ;
+}
+
+void GridPreloadWorker::Activate(std::size_t numThreads)
+{
+    _cancelationToken = false;
+    _workerThreads.reserve(numThreads);
+    for (std::size_t i = 0; i < numThreads; ++i)
+        _workerThreads.push_back(std::thread(&GridPreloadWorker::WorkerThread, this));
+}
+
+void GridPreloadWorker::Deactivate()
+{
+    _cancelationToken = true;
+    _queue.Cancel();
+
+    for (std::thread& thread : _workerThreads)
+        if (thread.joinable())
+            thread.join();
+
+    _workerThreads.clear();
+}
+
+void GridPreloadWorker::Schedule(std::shared_ptr<GridPreloadTask> task)
+{
+    _queue.Push(std::move(task));
+}
+
+void GridPreloadWorker::WorkerThread()
+{
+    while (!_cancelationToken)
+    {
+        std::shared_ptr<GridPreloadTask> task;
+        _queue.WaitAndPop(task);
+
+        if (!_cancelationToken && task)
+            task->Execute();
+    }
+}
+
+GridPreloader::GridPreloader(Map* map) : _map(map), _predictTimer(GRID_PRELOAD_PREDICT_INTERVAL), _hits(0), _misses(0), _expired(0)
+{
+}
+
+GridPreloader::~GridPreloader()
+{
+    // a worker may still be reading, the task owns its data and is released by whoever finishes last
+    for (auto& [key, pending] : _pending)
+        pending.Task->Complete();
+}
+
+bool GridPreloader::IsPredicting() const
+{
+    // Instances use the terrain of their parent map
+    return _map->GetInstanceId() == 0 && sMapMgr->GetGridPreloadWorker()->IsActive();
+}
+
+void GridPreloader::Update(uint32 diff)
+{
+    if (!IsPredicting())
+        return;
+
+    ExpireGrids(diff);
+
+    if (_predictTimer > diff)
+    {
+        _predictTimer -= diff;
+        return;
+    }
+
+    float const elapsed = float(GRID_PRELOAD_PREDICT_INTERVAL + diff - _predictTimer) / IN_MILLISECONDS;
+    _predictTimer = GRID_PRELOAD_PREDICT_INTERVAL;
+
+    for (auto& [guid, sample] : _samples)
+        sample.Seen = false;
+
+    for (MapReference const& ref : _map->GetPlayers())
+    {
+        Player* player = ref.GetSource();
+        if (!player || !player->IsInWorld())
+            continue;
+
+        auto itr = _samples.find(player->GetGUID());
+        if (itr == _samples.end())
+        {
+            _samples.emplace(player->GetGUID(), MovementSample{ player->GetPositionX(), player->GetPositionY(), true });
+            continue;
+        }
+
+        if (player->IsInFlight() && player->GetMotionMaster()->GetCurrentMovementGeneratorType() == FLIGHT_MOTION_TYPE)
+            PredictFlightPath(player);
+        else
+            PredictMovement(player, itr->second, elapsed);
+
+        itr->second = { player->GetPositionX(), player->GetPositionY(), true };
+    }
+
+    for (auto itr = _samples.begin(); itr != _samples.end();)
+    {
+        if (!itr->second.Seen)
+            itr = _samples.erase(itr);
+        else
+            ++itr;
+    }
+}
+
+bool GridPreloader::TakeTerrain(uint16 x, uint16 y, std::unique_ptr<GridTerrainData>& terrain, TerrainMapDataReadResult& result)
+{
+    auto itr = _pending.find(GetPendingKey(x, y));
+    if (itr == _pending.end())
+    {
+        if (IsPredicting())
+            ++_misses;
+
+        return false;
+    }
+
+    std::shared_ptr<GridPreloadTask> task = std::move(itr->second.Task);
+    _pending.erase(itr);
+
+    // still queued: reading the file right away is faster than waiting for the queue
+    if (!task->Complete())
+    {
+        ++_misses;
+        return false;
+    }
+
+    ++_hits;
+    terrain = task->TakeTerrain();
+    result = task->GetResult();
+    return true;
+}
+
+void GridPreloader::PredictFlightPath(Player* player)
+{
+    FlightPathMovementGenerator* flight = static_cast<FlightPathMovementGenerator*>(player->GetMotionMaster()->top());
+    TaxiPathNodeList const& path = flight->GetPath();
+
+    float const lookAheadDistance = GRID_PRELOAD_FLIGHT_SPEED * sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD) / IN_MILLISECONDS;
+    float distance = 0.0f;
+    float lastX = player->GetPositionX();
+    float lastY = player->GetPositionY();
+
+    for (uint32 i = flight->GetCurrentNode(); i < path.size() && distance < lookAheadDistance; ++i)
+    {
+        TaxiPathNodeEntry const* node = path[i];
+        if (node->mapid != _map->GetId())
+            break;
+
+        distance += std::hypot(node->x - lastX, node->y - lastY);
+        lastX = node->x;
+        lastY = node->y;
+
+        RequestGridsAround(node->x, node->y);
+    }
+}
+
+void GridPreloader::PredictMovement(Player* player, MovementSample& sample, float elapsed)
+{
+    if (elapsed <= 0.0f)
+        return;
+
+    float const dx = player->GetPositionX() - sample.X;
+    float const dy = player->GetPositionY() - sample.Y;
+    float const speed = std::hypot(dx, dy) / elapsed;
+    if (speed < GRID_PRELOAD_MIN_SPEED || speed > GRID_PRELOAD_MAX_SPEED)
+        return;
+
+    // walk the predicted movement in half grid steps
+    float const lookAheadDistance = speed * sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD) / IN_MILLISECONDS;
+    float const dirX = dx / (speed * elapsed);
+    float const dirY = dy / (speed * elapsed);
+    for (float step = SIZE_OF_GRIDS / 2; ; step += SIZE_OF_GRIDS / 2)
+    {
+        step = std::min(step, lookAheadDistance);
+        RequestGridsAround(player->GetPositionX() + dirX * step, player->GetPositionY() + dirY * step);
+
+        if (step >= lookAheadDistance)
+            break;
+    }
+}
+
+void GridPreloader::RequestGridsAround(float x, float y)
+{
+    float const radius = _map->GetVisibilityRange();
+
+    // grid coordinates grow in the opposite direction of world coordinates
+    GridCoord const low = Acore::ComputeGridCoord(x + radius, y + radius).normalize();
+    GridCoord const high = Acore::ComputeGridCoord(x - radius, y - radius).normalize();
+
+    for (uint32 gridX = low.x_coord; gridX <= high.x_coord; ++gridX)
+        for (uint32 gridY = low.y_coord; gridY <= high.y_coord; ++gridY)
+            RequestGrid(gridX, gridY);
+}
+
+void GridPreloader::RequestGrid(uint16 x, uint16 y)
+{
+    if (_map->IsGridCreated(GridCoord(x, y)))
+        return;
+
+    uint32 const key = GetPendingKey(x, y);
+    if (_pending.size() >= GRID_PRELOAD_MAX_PENDING && _pending.find(key) == _pending.end())
+        return;
+
+    PendingGrid& pending = _pending[key];
+    if (!pending.Task)
+    {
+        pending.Task = std::make_shared<GridPreloadTask>(_map->GetId(), x, y, DisableMgr::IsPathfindingEnabled(_map));
+        sMapMgr->GetGridPreloadWorker()->Schedule(pending.Task);
+    }
+
+    // requested again, keep it alive
+    pending.Age = 0;
+}
+
+void GridPreloader::ExpireGrids(uint32 diff)
+{
+    uint32 const expireTime = sWorld->getIntConfig(CONFIG_GRID_PRELOAD_LOOKAHEAD) + GRID_PRELOAD_EXPIRE_MARGIN;
+
+    for (auto itr = _pending.begin(); itr != _pending.end();)
+    {
+        PendingGrid& pending = itr->second;
+        pending.Age += diff;
+
+        // do not block the map thread on a read in progress
+        if (pending.Age < expireTime || pending.Task->IsRunning())
+        {
+            ++itr;
+            continue;
+        }
+
+        pending.Task->Complete();
+        ++_expired;
+        itr = _pending.erase(itr);
+    }
+}
@@ -0,0 +1,159 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_GRID_PRELOADER_H
+#define ACORE_GRID_PRELOADER_H
+
+#include "Define.h"
+#include "GridDefines.h"
+#include "GridTerrainData.h"
+#include "ObjectGuid.h"
+#include "PCQueue.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class Map;
+class Player;
+
+// Reads the terrain of one grid on a GridPreloadWorker thread
+class GridPreloadTask
+{
+public:
+    GridPreloadTask(uint32 mapId, uint16 x, uint16 y, bool warmNavMesh);
+
+    // Worker thread
+    void Execute();
+
+    // Map thread: drops the task if no worker started it yet, otherwise waits until it is done.
+    // Returns true if the terrain was read.
+    bool Complete();
+
+    [[nodiscard]] uint16 GetX() const { return _x; }
+    [[nodiscard]] uint16 GetY() const { return _y; }
+    [[nodiscard]] bool IsRunning() const { return _state.load(std::memory_order_acquire) == State::Running; }
+
+    std::unique_ptr<GridTerrainData> TakeTerrain() { return std::move(_terrain); }
+    [[nodiscard]] TerrainMapDataReadResult GetResult() const { return _result; }
+
+private:
+    enum class State : uint8
+    {
+        Queued,
+        Running,
+        Done,
+        Cancelled
+    };
+
+    // Reads a file once so the synchronous load of the vmap and mmap tile finds it in the page cache
+    static void WarmFile(std::string const& fileName);
+
+    uint32 _mapId;
+    uint16 _x;
+    uint16 _y;
+    bool _warmNavMesh;
+
+    std::atomic<State> _state;
+    std::mutex _lock;
+    std::condition_variable _finished;
+
+    std::unique_ptr<GridTerrainData> _terrain;
+    TerrainMapDataReadResult _result;
+};
+
+// Background threads shared by all maps
+class GridPreloadWorker
+{
+public:
+    GridPreloadWorker() = default;
+    ~GridPreloadWorker() { Deactivate(); }
+
+    void Activate(std::size_t numThreads);
+    void Deactivate();
+    [[nodiscard]] bool IsActive() const { return !_workerThreads.empty(); }
+
+    void Schedule(std::shared_ptr<GridPreloadTask> task);
+
+private:
+    void WorkerThread();
+
+    ProducerConsumerQueue<std::shared_ptr<GridPreloadTask>> _queue;
+    std::atomic<bool> _cancelationToken{false};
+    std::vector<std::thread> _workerThreads;
+};
+
+/*
+ * Predicts the grids the players of a map are about to enter and reads their
+ * terrain in the background.
+ *
+ * Players on a flight path request the grids around their remaining nodes,
+ * other players the grids along their current movement. When the map creates
+ * a grid it takes the preloaded terrain instead of reading the map file; the
+ * vmap and mmap tiles and the spawns of the grid are still loaded on the map
+ * thread, their files were only read ahead.
+ */
+class GridPreloader
+{
+public:
+    explicit GridPreloader(Map* map);
+    ~GridPreloader();
+
+    void Update(uint32 diff);
+
+    // Hands over the terrain read in the background, false if the grid was not preloaded
+    bool TakeTerrain(uint16 x, uint16 y, std::unique_ptr<GridTerrainData>& terrain, TerrainMapDataReadResult& result);
+
+    [[nodiscard]] uint64 GetHits() const { return _hits; }
+    [[nodiscard]] uint64 GetMisses() const { return _misses; }
+    [[nodiscard]] uint64 GetExpired() const { return _expired; }
+
+private:
+    struct MovementSample
+    {
+        float X;
+        float Y;
+        bool Seen;
+    };
+
+    struct PendingGrid
+    {
+        std::shared_ptr<GridPreloadTask> Task;
+        uint32 Age;
+    };
+
+    [[nodiscard]] bool IsPredicting() const;
+    void PredictFlightPath(Player* player);
+    void PredictMovement(Player* player, MovementSample& sample, float elapsed);
+    void RequestGridsAround(float x, float y);
+    void RequestGrid(uint16 x, uint16 y);
+    void ExpireGrids(uint32 diff);
+
+    Map* _map;
+    uint32 _predictTimer;
+    std::unordered_map<ObjectGuid, MovementSample> _samples;
+    std::unordered_map<uint32, PendingGrid> _pending;
+
+    uint64 _hits;
+    uint64 _misses;
+    uint64 _expired;
+};
+
+#endif
@@ -37,7 +37,9 @@
 #include "ObjectAccessor.h"
 #include "ObjectMgr.h"
 #include "Pet.h"
+#include "ScratchArena.h"
 #include "ScriptMgr.h"
+#include "SlabPool.h"
 #include "Transport.h"
 #include "VMapFactory.h"
 #include "Vehicle.h"
@@ -74,7 +76,7 @@ Map::~Map()
 
 Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     _mapGridManager(this), i_mapEntry(sMapStore.LookupEntry(id)), i_spawnMode(SpawnMode), i_InstanceId(InstanceId),
-    m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE),
+    m_unloadTimer(0), m_VisibleDistance(DEFAULT_VISIBILITY_DISTANCE), _gridPreloader(this),
     _instanceResetPeriod(0), m_activeNonPlayersIter(m_activeNonPlayers.end()),
     _transportsUpdateIter(_transports.end()), i_scriptLock(false), _defaultLight(GetDefaultMapLight(id))
 {
@@ -87,6 +89,9 @@ Map::Map(uint32 id, uint32 InstanceId, uint8 SpawnMode, Map* _parent) :
     Map::InitVisibilityDistance();
 
     _weatherUpdateTimer.SetInterval(time_t(1 * IN_MILLISECONDS));
+
+    if (sWorld->getBoolConfig(CONFIG_MAP_SPATIAL_INDEX))
+        _spatialIndex = std::make_unique<MapSpatialIndex>();
 }
 
 // Hook called after map is created AND after added to map list
@@ -124,6 +129,8 @@ void Map::AddToGrid(T* obj, Cell const& cell)
         grid->AddWorldObject<T>(cell.CellX(), cell.CellY(), obj);
     else
         grid->AddGridObject<T>(cell.CellX(), cell.CellY(), obj);
+
+    AddToSpatialIndex(obj, obj->IsWorldObject());
 }
 
 template<>
@@ -135,6 +142,7 @@ void Map::AddToGrid(Creature* obj, Cell const& cell)
     else
         grid->AddGridObject(cell.CellX(), cell.CellY(), obj);
 
+    AddToSpatialIndex(obj, obj->IsWorldObject());
     obj->SetCurrentCell(cell);
 }
 
@@ -144,6 +152,7 @@ void Map::AddToGrid(GameObject* obj, Cell const& cell)
     MapGridType* grid = GetMapGrid(cell.GridX(), cell.GridY());
     grid->AddGridObject(cell.CellX(), cell.CellY(), obj);
 
+    AddToSpatialIndex(obj, false);
     obj->SetCurrentCell(cell);
 }
 
@@ -156,6 +165,7 @@ void Map::AddToGrid(DynamicObject* obj, Cell const& cell)
     else
         grid->AddGridObject(cell.CellX(), cell.CellY(), obj);
 
+    AddToSpatialIndex(obj, obj->IsWorldObject());
     obj->SetCurrentCell(cell);
 }
 
@@ -175,6 +185,8 @@ void Map::AddToGrid(Corpse* obj, Cell const& cell)
             grid->AddWorldObject(cell.CellX(), cell.CellY(), obj);
         else
             grid->AddGridObject(cell.CellX(), cell.CellY(), obj);
+
+        AddToSpatialIndex(obj, obj->IsWorldObject());
     }
 }
 
@@ -216,6 +228,8 @@ void Map::SwitchGridContainers(Creature* obj, bool on)
         RemoveWorldObject(obj);
     }
 
+    AddToSpatialIndex(obj, on);
+
     obj->m_isTempWorldObject = on;
 }
 
@@ -251,6 +265,17 @@ void Map::SwitchGridContainers(GameObject* obj, bool on)
         grid->AddGridObject(cell.CellX(), cell.CellY(), obj);
         RemoveWorldObject(obj);
     }
+
+    AddToSpatialIndex(obj, on);
+}
+
+void Map::AddToSpatialIndex(WorldObject* obj, bool worldContainer)
+{
+    if (!_spatialIndex)
+        return;
+
+    uint32 const flags = obj->GetGridMapTypeMask() | (worldContainer ? SPATIAL_INDEX_WORLD_OBJECTS : SPATIAL_INDEX_GRID_OBJECTS);
+    _spatialIndex->Insert(obj, obj->GetSpatialIndexSlot(), obj->GetPositionX(), obj->GetPositionY(), obj->GetSpatialIndexRadius(), flags);
 }
 
 template<class T>
@@ -533,8 +558,15 @@ void Map::UpdatePlayerZoneStats(uint32 oldZone, uint32 newZone)
 
 void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
 {
+    // target lists of searchers, spells and scripts built during the update live in the arena of this thread
+    Acore::ScratchArenaScope scratchScope;
+
     if (t_diff)
+    {
         _dynamicTree.update(t_diff);
+        _collisionCache.Update(t_diff);
+        _gridPreloader.Update(t_diff);
+    }
 
     // Update world sessions and players
     for (m_mapRefIter = m_mapRefMgr.begin(); m_mapRefIter != m_mapRefMgr.end(); ++m_mapRefIter)
@@ -639,49 +671,158 @@ void Map::Update(const uint32 t_diff, const uint32 s_diff, bool  /*thread*/)
     METRIC_VALUE("map_gameobjects", uint64(GetObjectsStore().Size<GameObject>()),
         METRIC_TAG("map_id", std::to_string(GetId())),
         METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_collision_cache_hits", _collisionCache.GetHits(),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_collision_cache_misses", _collisionCache.GetMisses(),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_grid_preload_hits", _gridPreloader.GetHits(),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_grid_preload_misses", _gridPreloader.GetMisses(),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_grid_preload_expired", _gridPreloader.GetExpired(),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    [[maybe_unused]] static constexpr std::array<char const*, AsUnderlyingType(MapUpdateKind::Max)> UpdateKindNames = { "idle", "moving", "combat", "dead", "other" };
+    for (uint8 kind = 0; kind < AsUnderlyingType(MapUpdateKind::Max); ++kind)
+        METRIC_VALUE("map_updatable_objects", uint64(_updatableObjectLists[kind].size()),
+            METRIC_TAG("map_id", std::to_string(GetId())),
+            METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())),
+            METRIC_TAG("kind", UpdateKindNames[kind]));
+
+    METRIC_VALUE("map_skipped_object_updates", uint64(_skippedObjectUpdates),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+
+    METRIC_VALUE("map_sleeping_objects", uint64(_sleepingObjects.size()),
+        METRIC_TAG("map_id", std::to_string(GetId())),
+        METRIC_TAG("map_instanceid", std::to_string(GetInstanceId())));
+}
+
+namespace
+{
+    // objects of the update list without a dynamic_cast
+    UpdatableMapObject* ToUpdatableMapObject(WorldObject* obj)
+    {
+        switch (obj->GetTypeId())
+        {
+            case TYPEID_UNIT:
+                return obj->ToCreature();
+            case TYPEID_GAMEOBJECT:
+                return obj->ToGameObject();
+            case TYPEID_DYNAMICOBJECT:
+                return obj->ToDynObject();
+            default:
+                return nullptr;
+        }
+    }
+
+    // update list entries ahead of the one being updated whose objects are prefetched
+    constexpr std::size_t UPDATE_LIST_PREFETCH_DISTANCE = 4;
 }
 
 void Map::UpdateNonPlayerObjects(uint32 const diff)
 {
+    Milliseconds const nowMS = GameTime::GetGameTimeMS();
+    while (!_sleepingObjects.empty() && _sleepingObjects.begin()->first <= nowMS)
+        _WakeObject(_sleepingObjects.begin()->second);
+
     for (WorldObject* obj : _pendingAddUpdatableObjectList)
         _AddObjectToUpdateList(obj);
     _pendingAddUpdatableObjectList.clear();
 
-    if (_updatableObjectListRecheckTimer.Passed())
+    bool const recheck = _updatableObjectListRecheckTimer.Passed();
+    time_t const now = GameTime::GetGameTime().count();
+    Milliseconds const sleepInterval = Milliseconds(sWorld->getIntConfig(CONFIG_CREATURE_SLEEP_INTERVAL));
+    _skippedObjectUpdates = 0;
+
+    // one group after another, so consecutive updates run through the same code
+    for (uint8 kind = 0; kind < AsUnderlyingType(MapUpdateKind::Max); ++kind)
     {
-        for (uint32 i = 0; i < _updatableObjectList.size();)
+        UpdatableObjectList& list = _updatableObjectLists[kind];
+        bool const creatures = kind != AsUnderlyingType(MapUpdateKind::Other);
+
+        for (std::size_t i = 0; i < list.size();)
         {
-            WorldObject* obj = _updatableObjectList[i];
+            if (i + UPDATE_LIST_PREFETCH_DISTANCE < list.size())
+            {
+                WorldObject* ahead = list[i + UPDATE_LIST_PREFETCH_DISTANCE].Object;
+                if (creatures)
+                    static_cast<Creature*>(ahead)->PrefetchUpdateData();
+                else
+                    ACORE_PREFETCH(ahead);
+            }
+
+            UpdatableObjectEntry const& entry = list[i];
+            WorldObject* obj = entry.Object;
+            bool const sleeping = entry.SleepUntil > now;
+
+            // only the recheck looks at sleeping objects, to drop the ones no longer needing updates
+            if (sleeping && !recheck)
+            {
+                ++_skippedObjectUpdates;
+                ++i;
+                continue;
+            }
+
             if (!obj->IsInWorld())
             {
                 ++i;
                 continue;
             }
 
-            obj->Update(diff);
+            if (sleeping)
+                ++_skippedObjectUpdates;
+            else
+            {
+                obj->Update(creatures ? static_cast<Creature*>(obj)->TakeMapUpdateDiff(diff, nowMS) : diff);
 
-            if (!obj->IsUpdateNeeded())
+                // the update may have removed the object from the list, or moved it within
+                Creature* creature = creatures ? obj->ToCreature() : nullptr;
+                if (creature && creature->GetUpdateState() == UpdatableMapObject::UpdateState::Updating)
+                {
+                    UpdatableObjectEntry& current = _updatableObjectLists[AsUnderlyingType(creature->GetMapUpdateKind())][creature->GetMapUpdateListOffset()];
+                    current.SleepUntil = creature->GetMapUpdateSleepTime();
+                    current.NextKind = creature->ComputeMapUpdateKind();
+
+                    // idle creatures with nothing left to do leave the list until a timer or an event wakes them
+                    if (sleepInterval > 0ms && current.NextKind == MapUpdateKind::Idle && creature->CanSleep())
+                    {
+                        _SleepObject(creature, nowMS + sleepInterval);
+                        continue;
+                    }
+
+                    if (current.NextKind != creature->GetMapUpdateKind())
+                        ++_updatableObjectKindChanges;
+                }
+            }
+
+            if (recheck && !obj->IsUpdateNeeded())
             {
                 _RemoveObjectFromUpdateList(obj);
                 // Intentional no iteration here, obj is swapped with last element in
-                // _updatableObjectList so next loop will update that object at the same index
-            }
-            else
-                ++i;
-        }
-        _updatableObjectListRecheckTimer.Reset();
-    }
-    else
-    {
-        for (uint32 i = 0; i < _updatableObjectList.size(); ++i)
-        {
-            WorldObject* obj = _updatableObjectList[i];
-            if (!obj->IsInWorld())
+                // the list so next loop will update that object at the same index
                 continue;
+            }
 
-            obj->Update(diff);
+            ++i;
         }
     }
+
+    if (recheck)
+        _updatableObjectListRecheckTimer.Reset();
+
+    if (_updatableObjectKindChanges)
+        _RegroupUpdateLists();
 }
 
 void Map::AddObjectToPendingUpdateList(WorldObject* obj)
@@ -689,7 +830,7 @@ void Map::AddObjectToPendingUpdateList(WorldObject* obj)
     if (!obj->CanBeAddedToMapUpdateList())
         return;
 
-    UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
+    UpdatableMapObject* mapUpdatableObject = ToUpdatableMapObject(obj);
     if (mapUpdatableObject->GetUpdateState() != UpdatableMapObject::UpdateState::NotUpdating)
         return;
 
@@ -700,40 +841,115 @@ void Map::AddObjectToPendingUpdateList(WorldObject* obj)
 // Internal use only
 void Map::_AddObjectToUpdateList(WorldObject* obj)
 {
-    UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
+    UpdatableMapObject* mapUpdatableObject = ToUpdatableMapObject(obj);
     ASSERT(mapUpdatableObject && mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::PendingAdd);
 
+    Creature* creature = obj->ToCreature();
+    _InsertIntoUpdateList(mapUpdatableObject, { obj, 0, creature ? creature->ComputeMapUpdateKind() : MapUpdateKind::Other });
+}
+
+// Internal use only
+void Map::_InsertIntoUpdateList(UpdatableMapObject* mapUpdatableObject, UpdatableObjectEntry const& entry)
+{
+    UpdatableObjectList& list = _updatableObjectLists[AsUnderlyingType(entry.NextKind)];
+
     mapUpdatableObject->SetUpdateState(UpdatableMapObject::UpdateState::Updating);
-    mapUpdatableObject->SetMapUpdateListOffset(_updatableObjectList.size());
-    _updatableObjectList.push_back(obj);
+    mapUpdatableObject->SetMapUpdateKind(entry.NextKind);
+    mapUpdatableObject->SetMapUpdateListOffset(list.size());
+    list.push_back(entry);
 }
 
 // Internal use only
 void Map::_RemoveObjectFromUpdateList(WorldObject* obj)
 {
-    UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
+    UpdatableMapObject* mapUpdatableObject = ToUpdatableMapObject(obj);
     ASSERT(mapUpdatableObject && mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::Updating);
 
-    if (obj != _updatableObjectList.back())
+    UpdatableObjectList& list = _updatableObjectLists[AsUnderlyingType(mapUpdatableObject->GetMapUpdateKind())];
+    if (obj != list.back().Object)
     {
-        dynamic_cast<UpdatableMapObject*>(_updatableObjectList.back())->SetMapUpdateListOffset(mapUpdatableObject->GetMapUpdateListOffset());
-        std::swap(_updatableObjectList[mapUpdatableObject->GetMapUpdateListOffset()], _updatableObjectList.back());
+        ToUpdatableMapObject(list.back().Object)->SetMapUpdateListOffset(mapUpdatableObject->GetMapUpdateListOffset());
+        std::swap(list[mapUpdatableObject->GetMapUpdateListOffset()], list.back());
     }
 
-    _updatableObjectList.pop_back();
+    list.pop_back();
     mapUpdatableObject->SetUpdateState(UpdatableMapObject::UpdateState::NotUpdating);
 }
 
+// Internal use only, moves the objects whose last update changed their group
+void Map::_RegroupUpdateLists()
+{
+    for (uint8 kind = 0; kind < AsUnderlyingType(MapUpdateKind::Max); ++kind)
+    {
+        UpdatableObjectList& list = _updatableObjectLists[kind];
+        for (std::size_t i = 0; i < list.size();)
+        {
+            if (AsUnderlyingType(list[i].NextKind) == kind)
+            {
+                ++i;
+                continue;
+            }
+
+            // the last entry takes over the position and is checked next
+            UpdatableObjectEntry const entry = list[i];
+            _RemoveObjectFromUpdateList(entry.Object);
+            _InsertIntoUpdateList(ToUpdatableMapObject(entry.Object), entry);
+        }
+    }
+
+    _updatableObjectKindChanges = 0;
+}
+
+// Internal use only
+void Map::_SleepObject(WorldObject* obj, Milliseconds wakeTime)
+{
+    _RemoveObjectFromUpdateList(obj);
+
+    UpdatableMapObject* mapUpdatableObject = ToUpdatableMapObject(obj);
+    mapUpdatableObject->SetUpdateState(UpdatableMapObject::UpdateState::Sleeping);
+    mapUpdatableObject->SetMapWakeTime(wakeTime);
+    mapUpdatableObject->SetMapSleepStart(GameTime::GetGameTimeMS());
+    _sleepingObjects.emplace(wakeTime, obj);
+}
+
+// Internal use only, the object is added back with the pending objects of the next update
+void Map::_WakeObject(WorldObject* obj)
+{
+    UpdatableMapObject* mapUpdatableObject = ToUpdatableMapObject(obj);
+    _sleepingObjects.erase({ mapUpdatableObject->GetMapWakeTime(), obj });
+
+    _pendingAddUpdatableObjectList.insert(obj);
+    mapUpdatableObject->SetUpdateState(UpdatableMapObject::UpdateState::PendingAdd);
+}
+
 void Map::RemoveObjectFromMapUpdateList(WorldObject* obj)
 {
     if (!obj->CanBeAddedToMapUpdateList())
         return;
 
-    UpdatableMapObject* mapUpdatableObject = dynamic_cast<UpdatableMapObject*>(obj);
+    UpdatableMapObject* mapUpdatableObject = ToUpdatableMapObject(obj);
+    mapUpdatableObject->SetMapSleepStart(0ms);
     if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::PendingAdd)
         _pendingAddUpdatableObjectList.erase(obj);
     else if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::Updating)
         _RemoveObjectFromUpdateList(obj);
+    else if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::Sleeping)
+    {
+        _sleepingObjects.erase({ mapUpdatableObject->GetMapWakeTime(), obj });
+        mapUpdatableObject->SetUpdateState(UpdatableMapObject::UpdateState::NotUpdating);
+    }
+}
+
+void Map::WakeUpdatableObject(WorldObject* obj)
+{
+    UpdatableMapObject* mapUpdatableObject = ToUpdatableMapObject(obj);
+    if (!mapUpdatableObject)
+        return;
+
+    if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::Updating)
+        _updatableObjectLists[AsUnderlyingType(mapUpdatableObject->GetMapUpdateKind())][mapUpdatableObject->GetMapUpdateListOffset()].SleepUntil = 0;
+    else if (mapUpdatableObject->GetUpdateState() == UpdatableMapObject::UpdateState::Sleeping)
+        _WakeObject(obj);
 }
 
 void Map::HandleDelayedVisibility()
@@ -871,6 +1087,7 @@ void Map::PlayerRelocation(Player* player, float x, float y, float z, float o)
     }
 
     player->Relocate(x, y, z, o);
+    player->UpdateSpatialIndex();
     if (player->IsVehicle())
         player->GetVehicleKit()->RelocatePassengers();
     player->UpdatePositionData();
@@ -893,6 +1110,7 @@ void Map::CreatureRelocation(Creature* creature, float x, float y, float z, floa
         RemoveCreatureFromMoveList(creature);
 
     creature->Relocate(x, y, z, o);
+    creature->UpdateSpatialIndex();
     if (creature->IsVehicle())
         creature->GetVehicleKit()->RelocatePassengers();
     creature->UpdatePositionData();
@@ -915,6 +1133,7 @@ void Map::GameObjectRelocation(GameObject* go, float x, float y, float z, float
         RemoveGameObjectFromMoveList(go);
 
     go->Relocate(x, y, z, o);
+    go->UpdateSpatialIndex();
     go->UpdateModelPosition();
     go->SetPositionDataUpdate();
     go->UpdateObjectVisibility(false);
@@ -936,6 +1155,7 @@ void Map::DynamicObjectRelocation(DynamicObject* dynObj, float x, float y, float
         RemoveDynamicObjectFromMoveList(dynObj);
 
     dynObj->Relocate(x, y, z, o);
+    dynObj->UpdateSpatialIndex();
     dynObj->SetPositionDataUpdate();
     dynObj->UpdateObjectVisibility(false);
 }
@@ -1604,7 +1824,7 @@ float Map::GetWaterLevel(float x, float y) const
     return INVALID_HEIGHT;
 }
 
-bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+VMAP::ModelIgnoreFlags Map::GetLineOfSightIgnoreFlags(VMAP::ModelIgnoreFlags ignoreFlags) const
 {
     if (!sWorld->getBoolConfig(CONFIG_VMAP_BLIZZLIKE_PVP_LOS))
     {
@@ -1622,6 +1842,89 @@ bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, floa
         }
     }
 
+    return ignoreFlags;
+}
+
+bool Map::isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    ignoreFlags = GetLineOfSightIgnoreFlags(ignoreFlags);
+
+    std::optional<MapCollisionCache::LineOfSightKey> cacheKey;
+    if (_collisionCache.IsEnabled())
+    {
+        cacheKey = MapCollisionCache::MakeLineOfSightKey(x1, y1, z1, x2, y2, z2, phasemask, checks, uint32(ignoreFlags));
+        if (std::optional<bool> cached = _collisionCache.FindLineOfSight(*cacheKey))
+            return *cached;
+    }
+
+    bool const result = _IsInLineOfSight(x1, y1, z1, x2, y2, z2, phasemask, checks, ignoreFlags);
+
+    if (cacheKey)
+        _collisionCache.StoreLineOfSight(*cacheKey, result);
+
+    return result;
+}
+
+void Map::isInLineOfSight(float x1, float y1, float z1, std::vector<G3D::Vector3> const& targets, std::vector<bool>& results, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
+    ignoreFlags = GetLineOfSightIgnoreFlags(ignoreFlags);
+    results.assign(targets.size(), true);
+
+    // Answer what the cache already knows, everything else is checked in one batch
+    bool const useCache = _collisionCache.IsEnabled();
+    std::vector<MapCollisionCache::LineOfSightKey> cacheKeys;
+    std::vector<G3D::Vector3> pendingTargets;
+    std::vector<uint32> pendingIndices;
+    pendingTargets.reserve(targets.size());
+    pendingIndices.reserve(targets.size());
+
+    for (uint32 i = 0; i < targets.size(); ++i)
+    {
+        G3D::Vector3 const& target = targets[i];
+        if (useCache)
+        {
+            MapCollisionCache::LineOfSightKey key = MapCollisionCache::MakeLineOfSightKey(x1, y1, z1, target.x, target.y, target.z, phasemask, checks, uint32(ignoreFlags));
+            if (std::optional<bool> cached = _collisionCache.FindLineOfSight(key))
+            {
+                results[i] = *cached;
+                continue;
+            }
+
+            cacheKeys.push_back(key);
+        }
+
+        pendingTargets.push_back(target);
+        pendingIndices.push_back(i);
+    }
+
+    if (pendingTargets.empty())
+        return;
+
+    std::vector<bool> pendingResults(pendingTargets.size(), true);
+    if (checks & LINEOFSIGHT_CHECK_VMAP)
+        VMAP::VMapFactory::createOrGetVMapMgr()->isInLineOfSight(GetId(), x1, y1, z1, pendingTargets, pendingResults, ignoreFlags);
+
+    if (sWorld->getBoolConfig(CONFIG_CHECK_GOBJECT_LOS) && (checks & LINEOFSIGHT_CHECK_GOBJECT_ALL))
+    {
+        VMAP::ModelIgnoreFlags dynamicIgnoreFlags = (checks & LINEOFSIGHT_CHECK_GOBJECT_M2) ? VMAP::ModelIgnoreFlags::Nothing : VMAP::ModelIgnoreFlags::M2;
+        for (uint32 i = 0; i < pendingTargets.size(); ++i)
+        {
+            G3D::Vector3 const& target = pendingTargets[i];
+            if (pendingResults[i] && !_dynamicTree.isInLineOfSight(x1, y1, z1, target.x, target.y, target.z, phasemask, dynamicIgnoreFlags))
+                pendingResults[i] = false;
+        }
+    }
+
+    for (uint32 i = 0; i < pendingTargets.size(); ++i)
+    {
+        results[pendingIndices[i]] = pendingResults[i];
+        if (useCache)
+            _collisionCache.StoreLineOfSight(cacheKeys[i], pendingResults[i]);
+    }
+}
+
+bool Map::_IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const
+{
     if ((checks & LINEOFSIGHT_CHECK_VMAP) && !VMAP::VMapFactory::createOrGetVMapMgr()->isInLineOfSight(GetId(), x1, y1, z1, x2, y2, z2, ignoreFlags))
     {
         return false;
@@ -1660,10 +1963,29 @@ bool Map::GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float
 
 float Map::GetHeight(uint32 phasemask, float x, float y, float z, bool vmap/*=true*/, float maxSearchDist /*= DEFAULT_HEIGHT_SEARCH*/) const
 {
+    std::optional<MapCollisionCache::HeightKey> cacheKey;
+    if (_collisionCache.IsEnabled())
+    {
+        cacheKey = MapCollisionCache::MakeHeightKey(x, y, z, phasemask, vmap, maxSearchDist);
+        if (std::optional<float> cached = _collisionCache.FindHeight(*cacheKey))
+            return *cached;
+    }
+
     float h1, h2;
     h1 = GetHeight(x, y, z, vmap, maxSearchDist);
     h2 = _dynamicTree.getHeight(x, y, z, maxSearchDist, phasemask);
-    return std::max<float>(h1, h2);
+    float const height = std::max<float>(h1, h2);
+
+    if (cacheKey)
+        _collisionCache.StoreHeight(*cacheKey, height);
+
+    return height;
+}
+
+void Map::InvalidateCollisionCache(GameObjectModel const& model)
+{
+    G3D::AABox const& bounds = model.GetBounds();
+    _collisionCache.InvalidateArea(bounds.low().x, bounds.low().y, bounds.high().x, bounds.high().y);
 }
 
 bool Map::IsInWater(uint32 phaseMask, float x, float y, float pZ, float collisionHeight) const
@@ -1936,6 +2258,9 @@ void Map::RemoveAllObjectsInRemoveList()
         }
     }
 
+    // the slab blocks of the objects deleted above go back to the shared pools, so grid loads on other map threads can reuse them
+    Acore::SlabPool::ReleaseThreadCaches();
+
     //LOG_DEBUG("maps", "Object remover 2 check.");
 }
 
@@ -25,9 +25,12 @@
 #include "DynamicTree.h"
 #include "GameObjectModel.h"
 #include "GridDefines.h"
+#include "GridPreloader.h"
 #include "GridRefMgr.h"
+#include "MapCollisionCache.h"
 #include "MapGridManager.h"
 #include "MapRefMgr.h"
+#include "MapSpatialIndex.h"
 #include "ObjectDefines.h"
 #include "ObjectGuid.h"
 #include "PathGenerator.h"
@@ -37,9 +40,11 @@
 #include "TaskScheduler.h"
 #include "Timer.h"
 #include "GridTerrainData.h"
+#include <array>
 #include <bitset>
 #include <list>
 #include <memory>
+#include <set>
 #include <shared_mutex>
 
 class Unit;
@@ -50,6 +55,7 @@ class InstanceSave;
 class Object;
 class WorldObject;
 class TempSummon;
+class UpdatableMapObject;
 class Player;
 class CreatureGroup;
 struct ScriptInfo;
@@ -393,13 +399,24 @@ public:
     float GetWaterOrGroundLevel(uint32 phasemask, float x, float y, float z, float* ground = nullptr, bool swim = false, float collisionHeight = DEFAULT_COLLISION_HEIGHT) const;
     [[nodiscard]] float GetHeight(uint32 phasemask, float x, float y, float z, bool vmap = true, float maxSearchDist = DEFAULT_HEIGHT_SEARCH) const;
     [[nodiscard]] bool isInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+    // Line of sight from one position to many targets (e.g. area target selection), results[i] holds the result for targets[i]
+    void isInLineOfSight(float x1, float y1, float z1, std::vector<G3D::Vector3> const& targets, std::vector<bool>& results, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, PathGenerator *path, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CanReachPositionAndGetValidCoords(WorldObject const* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true, bool failOnSlopes = true) const;
     bool CheckCollisionAndGetValidCoords(WorldObject const* source, float startX, float startY, float startZ, float &destX, float &destY, float &destZ, bool failOnCollision = true) const;
     void Balance() { _dynamicTree.balance(); }
-    void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); }
-    void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); }
+    void RemoveGameObjectModel(const GameObjectModel& model) { _dynamicTree.remove(model); InvalidateCollisionCache(model); }
+    void InsertGameObjectModel(const GameObjectModel& model) { _dynamicTree.insert(model); InvalidateCollisionCache(model); }
+    void InvalidateCollisionCache(GameObjectModel const& model);
+    void InvalidateCollisionCache(GridCoord const& gridCoord) { _collisionCache.InvalidateGrid(gridCoord); }
+    [[nodiscard]] MapCollisionCache const& GetCollisionCache() const { return _collisionCache; }
+
+    GridPreloader& GetGridPreloader() { return _gridPreloader; }
+
+    // nullptr unless MapUpdate.SpatialIndex was enabled when the map was created
+    [[nodiscard]] MapSpatialIndex* GetSpatialIndex() const { return _spatialIndex.get(); }
+    void AddToSpatialIndex(WorldObject* obj, bool worldContainer);
     [[nodiscard]] bool ContainsGameObjectModel(const GameObjectModel& model) const { return _dynamicTree.contains(model);}
     [[nodiscard]] DynamicMapTree const& GetDynamicMapTree() const { return _dynamicTree; }
     bool GetObjectHitPos(uint32 phasemask, float x1, float y1, float z1, float x2, float y2, float z2, float& rx, float& ry, float& rz, float modifyDist);
@@ -512,8 +529,21 @@ public:
 
     void AddObjectToPendingUpdateList(WorldObject* obj);
     void RemoveObjectFromMapUpdateList(WorldObject* obj);
+    // Updates the object on the next map update even if it was skipped until later
+    void WakeUpdatableObject(WorldObject* obj);
 
-    typedef std::vector<WorldObject*> UpdatableObjectList;
+    [[nodiscard]] std::size_t GetUpdatableObjectCount(MapUpdateKind kind) const { return _updatableObjectLists[std::size_t(kind)].size(); }
+    [[nodiscard]] uint32 GetSkippedObjectUpdates() const { return _skippedObjectUpdates; }
+    [[nodiscard]] std::size_t GetSleepingObjectCount() const { return _sleepingObjects.size(); }
+
+    struct UpdatableObjectEntry
+    {
+        WorldObject* Object;
+        time_t SleepUntil;          // game time the update is skipped until, without touching the object
+        MapUpdateKind NextKind;     // group the last update classified the object as
+    };
+
+    typedef std::vector<UpdatableObjectEntry> UpdatableObjectList;
     typedef std::unordered_set<WorldObject*> PendingAddUpdatableObjectList;
 
 private:
@@ -552,6 +582,9 @@ protected:
     uint32 m_unloadTimer;
     float m_VisibleDistance;
     DynamicMapTree _dynamicTree;
+    mutable MapCollisionCache _collisionCache;
+    GridPreloader _gridPreloader;
+    std::unique_ptr<MapSpatialIndex> _spatialIndex;
     time_t _instanceResetPeriod; // pussywizard
 
     MapRefMgr m_mapRefMgr;
@@ -566,6 +599,9 @@ protected:
     TransportsContainer::iterator _transportsUpdateIter;
 
 private:
+    [[nodiscard]] VMAP::ModelIgnoreFlags GetLineOfSightIgnoreFlags(VMAP::ModelIgnoreFlags ignoreFlags) const;
+    [[nodiscard]] bool _IsInLineOfSight(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phasemask, LineOfSightChecks checks, VMAP::ModelIgnoreFlags ignoreFlags) const;
+
     Player* _GetScriptPlayerSourceOrTarget(Object* source, Object* target, const ScriptInfo* scriptInfo) const;
     Creature* _GetScriptCreatureSourceOrTarget(Object* source, Object* target, const ScriptInfo* scriptInfo, bool bReverse = false) const;
     Unit* _GetScriptUnit(Object* obj, bool isSource, const ScriptInfo* scriptInfo) const;
@@ -616,7 +652,11 @@ private:
     void UpdateNonPlayerObjects(uint32 const diff);
 
     void _AddObjectToUpdateList(WorldObject* obj);
+    void _InsertIntoUpdateList(UpdatableMapObject* mapUpdatableObject, UpdatableObjectEntry const& entry);
     void _RemoveObjectFromUpdateList(WorldObject* obj);
+    void _RegroupUpdateLists();
+    void _SleepObject(WorldObject* obj, Milliseconds wakeTime);
+    void _WakeObject(WorldObject* obj);
 
     std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t> _creatureRespawnTimes;
     std::unordered_map<ObjectGuid::LowType /*dbGUID*/, time_t> _goRespawnTimes;
@@ -647,9 +687,12 @@ private:
 
     std::unordered_set<Object*> _updateObjects;
 
-    UpdatableObjectList _updatableObjectList;
+    std::array<UpdatableObjectList, std::size_t(MapUpdateKind::Max)> _updatableObjectLists;
     PendingAddUpdatableObjectList _pendingAddUpdatableObjectList;
     IntervalTimer _updatableObjectListRecheckTimer;
+    uint32 _updatableObjectKindChanges = 0;
+    uint32 _skippedObjectUpdates = 0;
+    std::set<std::pair<Milliseconds /*wakeTime*/, WorldObject*>> _sleepingObjects;
 };
 
 enum InstanceResetMethod
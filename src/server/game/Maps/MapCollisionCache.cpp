@@ -0,0 +1,244 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapCollisionCache.h"
+#include "World.h"
+#include <bit>
+
+namespace
+{
+    // Upper bound of entries per query kind, further results are not cached until the next sweep
+    constexpr std::size_t COLLISION_CACHE_MAX_ENTRIES = 16384;
+
+    inline uint32 ToBits(float value)
+    {
+        return std::bit_cast<uint32>(value);
+    }
+
+    inline float FromBits(uint32 value)
+    {
+        return std::bit_cast<float>(value);
+    }
+
+    inline void HashCombine(std::size_t& hash, uint32 value)
+    {
+        hash ^= std::hash<uint32>()(value) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+
+    template<class Store>
+    void EraseExpired(Store& store, uint64 now)
+    {
+        for (auto itr = store.begin(); itr != store.end();)
+        {
+            if (itr->second.ExpireTime <= now)
+                itr = store.erase(itr);
+            else
+                ++itr;
+        }
+    }
+}
+
+MapCollisionCache::MapCollisionCache() : _stamp(0), _now(0), _ttl(0), _sweepTimer(0), _enabled(false), _hits(0), _misses(0)
+{
+    _gridStamps.fill(0);
+}
+
+void MapCollisionCache::Update(uint32 diff)
+{
+    bool const enabled = sWorld->getBoolConfig(CONFIG_VMAP_QUERY_CACHE_ENABLE);
+    uint32 const ttl = sWorld->getIntConfig(CONFIG_VMAP_QUERY_CACHE_TTL);
+
+    _now += diff;
+    _ttl = ttl;
+
+    if (!enabled || !ttl)
+    {
+        if (_enabled)
+        {
+            _lineOfSight.clear();
+            _height.clear();
+            _enabled = false;
+        }
+
+        return;
+    }
+
+    _enabled = true;
+
+    if (_sweepTimer > diff)
+    {
+        _sweepTimer -= diff;
+        return;
+    }
+
+    _sweepTimer = _ttl;
+    EraseExpired(_lineOfSight, _now);
+    EraseExpired(_height, _now);
+}
+
+MapCollisionCache::LineOfSightKey MapCollisionCache::MakeLineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseMask, uint32 checks, uint32 ignoreFlags)
+{
+    LineOfSightKey key;
+    key.Coords = { ToBits(x1), ToBits(y1), ToBits(z1), ToBits(x2), ToBits(y2), ToBits(z2) };
+    key.PhaseMask = phaseMask;
+    key.Flags = (checks << 16) | (ignoreFlags & 0xFFFF);
+    return key;
+}
+
+MapCollisionCache::HeightKey MapCollisionCache::MakeHeightKey(float x, float y, float z, uint32 phaseMask, bool checkVMap, float maxSearchDist)
+{
+    HeightKey key;
+    key.Coords = { ToBits(x), ToBits(y), ToBits(z), ToBits(maxSearchDist) };
+    key.PhaseMask = phaseMask;
+    key.CheckVMap = checkVMap;
+    return key;
+}
+
+std::optional<bool> MapCollisionCache::FindLineOfSight(LineOfSightKey const& key)
+{
+    return Find(_lineOfSight, key);
+}
+
+void MapCollisionCache::StoreLineOfSight(LineOfSightKey const& key, bool result)
+{
+    float const x1 = FromBits(key.Coords[0]);
+    float const y1 = FromBits(key.Coords[1]);
+    float const x2 = FromBits(key.Coords[3]);
+    float const y2 = FromBits(key.Coords[4]);
+
+    Store(_lineOfSight, key, result, GetGridRange(std::min(x1, x2), std::min(y1, y2), std::max(x1, x2), std::max(y1, y2)));
+}
+
+std::optional<float> MapCollisionCache::FindHeight(HeightKey const& key)
+{
+    return Find(_height, key);
+}
+
+void MapCollisionCache::StoreHeight(HeightKey const& key, float height)
+{
+    float const x = FromBits(key.Coords[0]);
+    float const y = FromBits(key.Coords[1]);
+
+    Store(_height, key, height, GetGridRange(x, y, x, y));
+}
+
+void MapCollisionCache::InvalidateArea(float minX, float minY, float maxX, float maxY)
+{
+    GridRange const grids = GetGridRange(minX, minY, maxX, maxY);
+
+    ++_stamp;
+    for (uint32 x = grids.LowX; x <= grids.HighX; ++x)
+        for (uint32 y = grids.LowY; y <= grids.HighY; ++y)
+            _gridStamps[y * MAX_NUMBER_OF_GRIDS + x] = _stamp;
+}
+
+void MapCollisionCache::InvalidateGrid(GridCoord const& gridCoord)
+{
+    if (!gridCoord.IsCoordValid())
+        return;
+
+    _gridStamps[gridCoord.GetId()] = ++_stamp;
+}
+
+void MapCollisionCache::Clear()
+{
+    _lineOfSight.clear();
+    _height.clear();
+}
+
+std::size_t MapCollisionCache::GetSize() const
+{
+    return _lineOfSight.size() + _height.size();
+}
+
+std::size_t MapCollisionCache::KeyHash::operator()(LineOfSightKey const& key) const
+{
+    std::size_t hash = 0;
+    for (uint32 coord : key.Coords)
+        HashCombine(hash, coord);
+
+    HashCombine(hash, key.PhaseMask);
+    HashCombine(hash, key.Flags);
+    return hash;
+}
+
+std::size_t MapCollisionCache::KeyHash::operator()(HeightKey const& key) const
+{
+    std::size_t hash = 0;
+    for (uint32 coord : key.Coords)
+        HashCombine(hash, coord);
+
+    HashCombine(hash, key.PhaseMask);
+    HashCombine(hash, uint32(key.CheckVMap));
+    return hash;
+}
+
+MapCollisionCache::GridRange MapCollisionCache::GetGridRange(float minX, float minY, float maxX, float maxY)
+{
+    // Grid coordinates grow in the opposite direction of world coordinates
+    GridCoord const low = Acore::ComputeGridCoord(maxX, maxY).normalize();
+    GridCoord const high = Acore::ComputeGridCoord(minX, minY).normalize();
+
+    GridRange range;
+    range.LowX = uint8(low.x_coord);
+    range.LowY = uint8(low.y_coord);
+    range.HighX = uint8(high.x_coord);
+    range.HighY = uint8(high.y_coord);
+    return range;
+}
+
+bool MapCollisionCache::IsValid(GridRange const& grids, uint32 stamp) const
+{
+    for (uint32 x = grids.LowX; x <= grids.HighX; ++x)
+        for (uint32 y = grids.LowY; y <= grids.HighY; ++y)
+            if (_gridStamps[y * MAX_NUMBER_OF_GRIDS + x] > stamp)
+                return false;
+
+    return true;
+}
+
+template<class Key, class Value>
+std::optional<Value> MapCollisionCache::Find(std::unordered_map<Key, Entry<Value>, KeyHash>& store, Key const& key)
+{
+    auto itr = store.find(key);
+    if (itr != store.end())
+    {
+        if (itr->second.ExpireTime > _now && IsValid(itr->second.Grids, itr->second.Stamp))
+        {
+            _hits.fetch_add(1, std::memory_order_relaxed);
+            return itr->second.Result;
+        }
+
+        store.erase(itr);
+    }
+
+    _misses.fetch_add(1, std::memory_order_relaxed);
+    return std::nullopt;
+}
+
+template<class Key, class Value>
+void MapCollisionCache::Store(std::unordered_map<Key, Entry<Value>, KeyHash>& store, Key const& key, Value result, GridRange const& grids)
+{
+    if (!_enabled || store.size() >= COLLISION_CACHE_MAX_ENTRIES)
+        return;
+
+    Entry<Value>& entry = store[key];
+    entry.Result = result;
+    entry.Grids = grids;
+    entry.Stamp = _stamp;
+    entry.ExpireTime = _now + _ttl;
+}
@@ -0,0 +1,140 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ACORE_MAP_COLLISION_CACHE_H
+#define ACORE_MAP_COLLISION_CACHE_H
+
+#include "Define.h"
+#include "GridDefines.h"
+#include <array>
+#include <atomic>
+#include <optional>
+#include <unordered_map>
+
+/*
+ * Short lived cache for the line of sight and height queries of a single map.
+ *
+ * Entries are keyed on the exact query, so repeated checks between the same
+ * points within the TTL are answered without walking the static BIH and the
+ * dynamic gameobject tree again. Every entry remembers the grids it touches;
+ * changing a gameobject model or loading terrain in a grid drops all entries
+ * that cover that grid.
+ *
+ * Like the dynamic tree it sits in front of, the cache is only used by the
+ * thread updating its map and takes no locks.
+ */
+class MapCollisionCache
+{
+public:
+    struct LineOfSightKey
+    {
+        std::array<uint32, 6> Coords; // bits of x1, y1, z1, x2, y2, z2
+        uint32 PhaseMask;
+        uint32 Flags;
+
+        bool operator==(LineOfSightKey const& other) const
+        {
+            return Coords == other.Coords && PhaseMask == other.PhaseMask && Flags == other.Flags;
+        }
+    };
+
+    struct HeightKey
+    {
+        std::array<uint32, 4> Coords; // bits of x, y, z, max search distance
+        uint32 PhaseMask;
+        bool CheckVMap;
+
+        bool operator==(HeightKey const& other) const
+        {
+            return Coords == other.Coords && PhaseMask == other.PhaseMask && CheckVMap == other.CheckVMap;
+        }
+    };
+
+    MapCollisionCache();
+
+    void Update(uint32 diff);
+
+    [[nodiscard]] bool IsEnabled() const { return _enabled; }
+
+    static LineOfSightKey MakeLineOfSightKey(float x1, float y1, float z1, float x2, float y2, float z2, uint32 phaseMask, uint32 checks, uint32 ignoreFlags);
+    static HeightKey MakeHeightKey(float x, float y, float z, uint32 phaseMask, bool checkVMap, float maxSearchDist);
+
+    std::optional<bool> FindLineOfSight(LineOfSightKey const& key);
+    void StoreLineOfSight(LineOfSightKey const& key, bool result);
+
+    std::optional<float> FindHeight(HeightKey const& key);
+    void StoreHeight(HeightKey const& key, float height);
+
+    // Drops every entry touching the given world area (e.g. the bounds of a gameobject model)
+    void InvalidateArea(float minX, float minY, float maxX, float maxY);
+    void InvalidateGrid(GridCoord const& gridCoord);
+    void Clear();
+
+    [[nodiscard]] uint64 GetHits() const { return _hits.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint64 GetMisses() const { return _misses.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::size_t GetSize() const;
+
+private:
+    struct GridRange
+    {
+        uint8 LowX;
+        uint8 LowY;
+        uint8 HighX;
+        uint8 HighY;
+    };
+
+    template<class Value>
+    struct Entry
+    {
+        Value Result;
+        GridRange Grids;
+        uint32 Stamp;
+        uint64 ExpireTime;
+    };
+
+    struct KeyHash
+    {
+        std::size_t operator()(LineOfSightKey const& key) const;
+        std::size_t operator()(HeightKey const& key) const;
+    };
+
+    static GridRange GetGridRange(float minX, float minY, float maxX, float maxY);
+    [[nodiscard]] bool IsValid(GridRange const& grids, uint32 stamp) const;
+
+    template<class Key, class Value>
+    std::optional<Value> Find(std::unordered_map<Key, Entry<Value>, KeyHash>& store, Key const& key);
+
+    template<class Key, class Value>
+    void Store(std::unordered_map<Key, Entry<Value>, KeyHash>& store, Key const& key, Value result, GridRange const& grids);
+
+    std::unordered_map<LineOfSightKey, Entry<bool>, KeyHash> _lineOfSight;
+    std::unordered_map<HeightKey, Entry<float>, KeyHash> _height;
+
+    // Stamp of the last invalidation of each grid, entries older than it are stale
+    std::array<uint32, MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS> _gridStamps;
+    uint32 _stamp;
+
+    uint64 _now;
+    uint32 _ttl;
+    uint32 _sweepTimer;
+    std::atomic<bool> _enabled;
+
+    std::atomic<uint64> _hits;
+    std::atomic<uint64> _misses;
+};
+
+#endif
@@ -59,6 +59,9 @@ void MapMgr::Initialize()
     // Start mtmaps if needed
     if (num_threads > 0)
         m_updater.activate(num_threads);
+
+    if (uint32 preloadThreads = sWorld->getIntConfig(CONFIG_GRID_PRELOAD_THREADS))
+        m_gridPreloadWorker.Activate(preloadThreads);
 }
 
 void MapMgr::InitializeVisibilityDistanceInfo()
@@ -335,6 +338,8 @@ void MapMgr::UnloadAll()
 
     if (m_updater.activated())
         m_updater.deactivate();
+
+    m_gridPreloadWorker.Deactivate();
 }
 
 void MapMgr::GetNumInstances(uint32& dungeons, uint32& battlegrounds, uint32& arenas)
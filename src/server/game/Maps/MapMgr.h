@@ -20,6 +20,7 @@
 
 #include "Common.h"
 #include "Define.h"
+#include "GridPreloader.h"
 #include "Map.h"
 #include "MapInstanced.h"
 #include "MapUpdater.h"
@@ -151,6 +152,7 @@ public:
     uint32 GenerateInstanceId();
 
     MapUpdater* GetMapUpdater() { return &m_updater; }
+    GridPreloadWorker* GetGridPreloadWorker() { return &m_gridPreloadWorker; }
 
     template<typename Worker>
     void DoForAllMaps(Worker&& worker);
@@ -175,6 +177,7 @@ private:
     InstanceIds _instanceIds;
     uint32 _nextInstanceId;
     MapUpdater m_updater;
+    GridPreloadWorker m_gridPreloadWorker;
 };
 
 template<typename Worker>
@@ -818,6 +818,8 @@ void MotionMaster::MoveDistract(uint32 timer)
 
 void MotionMaster::Mutate(MovementGenerator* m, MovementSlot slot)
 {
+    _owner->WakeMapUpdate();
+
     while (MovementGenerator* curr = Impl[slot])
     {
         bool delayed = (_top == slot && (_cleanFlag & MMCF_UPDATE));
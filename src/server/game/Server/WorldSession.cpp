@@ -272,6 +272,20 @@ void WorldSession::SendPacket(WorldPacket const* packet)
     m_Socket->SendPacket(*packet);
 }
 
+/// Send a packet whose payload is shared with other recipients, the socket does not copy it
+void WorldSession::SendSharedPacket(std::shared_ptr<WorldPacket const> const& packet)
+{
+    if (!m_Socket)
+        return;
+
+    if (!sScriptMgr->CanPacketSend(this, *packet))
+    {
+        return;
+    }
+
+    m_Socket->SendPacket(packet);
+}
+
 /// Add an incoming packet to the queue
 void WorldSession::QueuePacket(WorldPacket* new_packet)
 {
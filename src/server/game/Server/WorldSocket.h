@@ -37,15 +37,25 @@ public:
         SocketQueueLink.store(nullptr, std::memory_order_relaxed);
     }
 
+    // Broadcast packets keep a reference to the payload shared by all recipients instead of a copy
+    EncryptableAndCompressiblePacket(std::shared_ptr<WorldPacket const> packet, bool encrypt) : WorldPacket(packet->GetOpcode(), 0), _shared(std::move(packet)), _encrypt(encrypt)
+    {
+        SocketQueueLink.store(nullptr, std::memory_order_relaxed);
+    }
+
     bool NeedsEncryption() const { return _encrypt; }
 
-    bool NeedsCompression() const { return GetOpcode() == SMSG_UPDATE_OBJECT && size() > 100; }
+    // shared payloads are read by several sockets and are never compressed in place
+    bool NeedsCompression() const { return !_shared && GetOpcode() == SMSG_UPDATE_OBJECT && size() > 100; }
 
     void CompressIfNeeded();
 
+    WorldPacket const& GetPayload() const { return _shared ? *_shared : *this; }
+
     std::atomic<EncryptableAndCompressiblePacket*> SocketQueueLink;
 
 private:
+    std::shared_ptr<WorldPacket const> _shared;
     bool _encrypt;
 };
 
@@ -81,6 +91,7 @@ public:
     bool Update() override;
 
     void SendPacket(WorldPacket const& packet);
+    void SendPacket(std::shared_ptr<WorldPacket const> const& packet);
 
     void SetSendBufferSize(std::size_t sendBufferSize) { _sendBufferSize = sendBufferSize; }
 
@@ -18,6 +18,7 @@
 #ifndef ACORE_SPELLAURAS_H
 #define ACORE_SPELLAURAS_H
 
+#include "SlabPool.h"
 #include "SpellAuraDefines.h"
 #include "Unit.h"
 
@@ -58,6 +59,8 @@ private:
     void _InitFlags(Unit* caster, uint8 effMask);
     void _HandleEffect(uint8 effIndex, bool apply);
 public:
+    ACORE_SLAB_POOLED_CLASS;
+
     Unit* GetTarget() const { return _target; }
     Aura* GetBase() const { return _base; }
 
@@ -96,6 +99,8 @@ public:
     void _InitEffects(uint8 effMask, Unit* caster, int32* baseAmount);
     virtual ~Aura();
 
+    ACORE_SLAB_POOLED_CLASS;
+
     SpellInfo const* GetSpellInfo() const { return m_spellInfo; }
     uint32 GetId() const;
 
@@ -775,6 +775,43 @@ std::array<SpellEffectInfo::StaticData, TOTAL_SPELL_EFFECTS> SpellEffectInfo::_d
     {EFFECT_IMPLICIT_TARGET_EXPLICIT, TARGET_OBJECT_TYPE_UNIT}, // 164 SPELL_EFFECT_REMOVE_AURA
 } };
 
+void BuildSpellInfoHotData(SpellInfo const& spellInfo, SpellInfoHotData& hotData)
+{
+    hotData.Attributes = { spellInfo.Attributes, spellInfo.AttributesEx, spellInfo.AttributesEx2, spellInfo.AttributesEx3,
+        spellInfo.AttributesEx4, spellInfo.AttributesEx5, spellInfo.AttributesEx6, spellInfo.AttributesEx7 };
+    hotData.AttributesCu = spellInfo.AttributesCu;
+    hotData.Targets = spellInfo.Targets;
+    hotData.TargetCreatureType = spellInfo.TargetCreatureType;
+    hotData.ExplicitTargetMask = spellInfo.ExplicitTargetMask;
+    hotData.Stances = spellInfo.Stances;
+    hotData.StancesNot = spellInfo.StancesNot;
+    hotData.InterruptFlags = spellInfo.InterruptFlags;
+    hotData.FacingCasterFlags = spellInfo.FacingCasterFlags;
+    hotData.CasterAuraState = spellInfo.CasterAuraState;
+    hotData.CasterAuraStateNot = spellInfo.CasterAuraStateNot;
+    hotData.TargetAuraState = spellInfo.TargetAuraState;
+    hotData.TargetAuraStateNot = spellInfo.TargetAuraStateNot;
+    hotData.PowerType = spellInfo.PowerType;
+    hotData.RuneCostID = spellInfo.RuneCostID;
+    hotData.CastTime = spellInfo.CastTimeEntry ? spellInfo.CastTimeEntry->CastTime : 0;
+    hotData.DmgClass = spellInfo.DmgClass;
+
+    if (SpellRangeEntry const* range = spellInfo.RangeEntry)
+    {
+        hotData.RangeId = range->ID;
+        hotData.RangeFlags = range->Flags;
+        hotData.MinRange = { range->RangeMin[0], range->RangeMin[1] };
+        hotData.MaxRange = { range->RangeMax[0], range->RangeMax[1] };
+    }
+    else
+    {
+        hotData.RangeId = 0;
+        hotData.RangeFlags = 0;
+        hotData.MinRange = { };
+        hotData.MaxRange = { };
+    }
+}
+
 SpellInfo::SpellInfo(SpellEntry const* spellEntry)
 {
     Id = spellEntry->Id;
@@ -1758,11 +1795,13 @@ bool SpellInfo::ValidateAttribute6SpellDamageMods(Unit const* caster, const Aura
 
 SpellCastResult SpellInfo::CheckTarget(Unit const* caster, WorldObject const* target, bool implicit) const
 {
-    if (AttributesEx & SPELL_ATTR1_EXCLUDE_CASTER && caster == target)
+    SpellInfoHotData const& hotData = GetHotData();
+
+    if (hotData.HasAttribute(SPELL_ATTR1_EXCLUDE_CASTER) && caster == target)
         return SPELL_FAILED_BAD_TARGETS;
 
     // check visibility - ignore stealth for implicit (area) targets
-    if (!(AttributesEx6 & SPELL_ATTR6_IGNORE_PHASE_SHIFT) && !caster->CanSeeOrDetect(target, implicit))
+    if (!hotData.HasAttribute(SPELL_ATTR6_IGNORE_PHASE_SHIFT) && !caster->CanSeeOrDetect(target, implicit))
         return SPELL_FAILED_BAD_TARGETS;
 
     Unit const* unitTarget = target->ToUnit();
@@ -1771,7 +1810,7 @@ SpellCastResult SpellInfo::CheckTarget(Unit const* caster, WorldObject const* ta
     if (unitTarget)
     {
         // xinef: spells cannot be cast if player is in fake combat also
-        if (AttributesEx & SPELL_ATTR1_ONLY_PEACEFUL_TARGETS && (unitTarget->IsInCombat() || unitTarget->IsPetInCombat()))
+        if (hotData.HasAttribute(SPELL_ATTR1_ONLY_PEACEFUL_TARGETS) && (unitTarget->IsInCombat() || unitTarget->IsPetInCombat()))
             return SPELL_FAILED_TARGET_AFFECTING_COMBAT;
 
         // only spells with SPELL_ATTR3_ONLY_ON_GHOSTS can target ghosts
@@ -1788,12 +1827,12 @@ SpellCastResult SpellInfo::CheckTarget(Unit const* caster, WorldObject const* ta
             if (caster->IsPlayer())
             {
                 // Do not allow these spells to target creatures not tapped by us (Banish, Polymorph, many quest spells)
-                if (AttributesEx2 & SPELL_ATTR2_CANNOT_CAST_ON_TAPPED)
+                if (hotData.HasAttribute(SPELL_ATTR2_CANNOT_CAST_ON_TAPPED))
                     if (Creature const* targetCreature = unitTarget->ToCreature())
                         if (targetCreature->hasLootRecipient() && !targetCreature->isTappedBy(caster->ToPlayer()))
                             return SPELL_FAILED_CANT_CAST_ON_TAPPED;
 
-                if (HasAttribute(SPELL_ATTR0_CU_PICKPOCKET))
+                if (hotData.HasAttribute(SPELL_ATTR0_CU_PICKPOCKET))
                 {
                     Creature const* targetCreature = unitTarget->ToCreature();
                     if (!targetCreature)
@@ -1865,15 +1904,15 @@ SpellCastResult SpellInfo::CheckTarget(Unit const* caster, WorldObject const* ta
     // corpseOwner and unit specific target checks
     if (unitTarget->IsPlayer())
     {
-        if (HasAttribute(SPELL_ATTR5_NOT_ON_PLAYER))
+        if (hotData.HasAttribute(SPELL_ATTR5_NOT_ON_PLAYER))
             return SPELL_FAILED_TARGET_IS_PLAYER;
     }
     else
     {
-        if (HasAttribute(SPELL_ATTR3_ONLY_ON_PLAYER))
+        if (hotData.HasAttribute(SPELL_ATTR3_ONLY_ON_PLAYER))
             return SPELL_FAILED_TARGET_NOT_PLAYER;
 
-        if (HasAttribute(SPELL_ATTR5_NOT_ON_PLAYER_CONTROLLED_NPC) && unitTarget->IsControlledByPlayer())
+        if (hotData.HasAttribute(SPELL_ATTR5_NOT_ON_PLAYER_CONTROLLED_NPC) && unitTarget->IsControlledByPlayer())
             return SPELL_FAILED_TARGET_IS_PLAYER_CONTROLLED;
     }
 
@@ -1881,7 +1920,7 @@ SpellCastResult SpellInfo::CheckTarget(Unit const* caster, WorldObject const* ta
         return SPELL_FAILED_TARGETS_DEAD;
 
     // check this flag only for implicit targets (chain and area), allow to explicitly target units for spells like Shield of Righteousness
-    if (implicit && AttributesEx6 & SPELL_ATTR6_DO_NOT_CHAIN_TO_CROWD_CONTROLLED_TARGETS && unitTarget->HasUnitState(UNIT_STATE_CONTROLLED))
+    if (implicit && hotData.HasAttribute(SPELL_ATTR6_DO_NOT_CHAIN_TO_CROWD_CONTROLLED_TARGETS) && unitTarget->HasUnitState(UNIT_STATE_CONTROLLED))
         return SPELL_FAILED_BAD_TARGETS;
 
     // checked in Unit::IsValidAttack/AssistTarget, shouldn't be checked for ENTRY targets
@@ -1909,7 +1948,7 @@ SpellCastResult SpellInfo::CheckTarget(Unit const* caster, WorldObject const* ta
     }
 
     // not allow casting on flying player
-    if (unitTarget->IsInFlight() && !HasAttribute(SPELL_ATTR0_CU_ALLOW_INFLIGHT_TARGET))
+    if (unitTarget->IsInFlight() && !hotData.HasAttribute(SPELL_ATTR0_CU_ALLOW_INFLIGHT_TARGET))
         return SPELL_FAILED_BAD_TARGETS;
 
     /* TARGET_UNIT_MASTER gets blocked here for passengers, because the whole idea of this check is to
@@ -1921,10 +1960,10 @@ SpellCastResult SpellInfo::CheckTarget(Unit const* caster, WorldObject const* ta
     Spell examples: [ID - 52864 Devour Water, ID - 52862 Devour Wind, ID - 49370 Wyrmrest Defender: Destabilize Azure Dragonshrine Effect] */
     if (!caster->IsVehicle() && caster->GetCharmerOrOwner() != target)
     {
-        if (TargetAuraState && !unitTarget->HasAuraState(AuraStateType(TargetAuraState), this, caster))
+        if (hotData.TargetAuraState && !unitTarget->HasAuraState(AuraStateType(hotData.TargetAuraState), this, caster))
             return SPELL_FAILED_TARGET_AURASTATE;
 
-        if (TargetAuraStateNot && unitTarget->HasAuraState(AuraStateType(TargetAuraStateNot), this, caster))
+        if (hotData.TargetAuraStateNot && unitTarget->HasAuraState(AuraStateType(hotData.TargetAuraStateNot), this, caster))
             return SPELL_FAILED_TARGET_AURASTATE;
     }
 
@@ -1934,7 +1973,7 @@ SpellCastResult SpellInfo::CheckTarget(Unit const* caster, WorldObject const* ta
     if (ExcludeTargetAuraSpell && unitTarget->HasAura(sSpellMgr->GetSpellIdForDifficulty(ExcludeTargetAuraSpell, caster)))
         return SPELL_FAILED_TARGET_AURASTATE;
 
-    if (unitTarget->HasPreventResurectionAura() && !HasAttribute(SPELL_ATTR7_BYPASS_NO_RESURRECTION_AURA))
+    if (unitTarget->HasPreventResurectionAura() && !hotData.HasAttribute(SPELL_ATTR7_BYPASS_NO_RESURRECTION_AURA))
         if (HasEffect(SPELL_EFFECT_SELF_RESURRECT) || HasEffect(SPELL_EFFECT_RESURRECT) || HasEffect(SPELL_EFFECT_RESURRECT_NEW))
             return SPELL_FAILED_TARGET_CANNOT_BE_RESURRECTED;
 
@@ -213,6 +213,63 @@ enum SpellCustomAttributes
 
 uint32 GetTargetFlagMask(SpellTargetObjectTypes objType);
 
+/*
+ * Copy of the SpellInfo fields read by every cast check.
+ *
+ * SpellInfo keeps these spread over a large object and behind the range and
+ * cast time entries, this keeps them in two cache lines. It is built by
+ * SpellMgr after all spell data is loaded, code changing one of the fields
+ * later on must refresh it with SpellMgr::UpdateSpellInfoHotData.
+ */
+struct alignas(64) SpellInfoHotData
+{
+    // first cache line: attributes and target requirements
+    std::array<uint32, 8> Attributes{};     // Attributes .. AttributesEx7
+    uint32 AttributesCu = 0;
+    uint32 Targets = 0;
+    uint32 TargetCreatureType = 0;
+    uint32 ExplicitTargetMask = 0;
+    uint32 Stances = 0;
+    uint32 StancesNot = 0;
+    uint32 InterruptFlags = 0;
+    uint32 FacingCasterFlags = 0;
+
+    // second cache line: aura states, power, cast time and range
+    uint32 CasterAuraState = 0;
+    uint32 CasterAuraStateNot = 0;
+    uint32 TargetAuraState = 0;
+    uint32 TargetAuraStateNot = 0;
+    uint32 PowerType = 0;
+    uint32 RuneCostID = 0;
+    int32 CastTime = 0;                     // CastTimeEntry->CastTime, 0 without entry
+    uint32 RangeId = 0;
+    uint32 RangeFlags = 0;
+    std::array<float, 2> MinRange{};        // hostile, friendly
+    std::array<float, 2> MaxRange{};        // hostile, friendly
+    uint32 DmgClass = 0;
+
+    inline bool HasAttribute(SpellAttr0 attribute) const { return (Attributes[0] & attribute) != 0; }
+    inline bool HasAttribute(SpellAttr1 attribute) const { return (Attributes[1] & attribute) != 0; }
+    inline bool HasAttribute(SpellAttr2 attribute) const { return (Attributes[2] & attribute) != 0; }
+    inline bool HasAttribute(SpellAttr3 attribute) const { return (Attributes[3] & attribute) != 0; }
+    inline bool HasAttribute(SpellAttr4 attribute) const { return (Attributes[4] & attribute) != 0; }
+    inline bool HasAttribute(SpellAttr5 attribute) const { return (Attributes[5] & attribute) != 0; }
+    inline bool HasAttribute(SpellAttr6 attribute) const { return (Attributes[6] & attribute) != 0; }
+    inline bool HasAttribute(SpellAttr7 attribute) const { return (Attributes[7] & attribute) != 0; }
+    inline bool HasAttribute(SpellCustomAttributes customAttribute) const { return (AttributesCu & customAttribute) != 0; }
+
+    // Range selection of Unit::GetSpellMaxRangeForTarget and GetSpellMinRangeForTarget,
+    // isFriendly() is only called when the hostile and friendly ranges differ
+    template<class IS_FRIENDLY>
+    float GetMaxRange(IS_FRIENDLY&& isFriendly) const { return MaxRange[0] == MaxRange[1] ? MaxRange[0] : MaxRange[isFriendly() ? 1 : 0]; }
+    template<class IS_FRIENDLY>
+    float GetMinRange(IS_FRIENDLY&& isFriendly) const { return MinRange[0] == MinRange[1] ? MinRange[0] : MinRange[isFriendly() ? 1 : 0]; }
+};
+
+static_assert(sizeof(SpellInfoHotData) == 128, "SpellInfoHotData must fill exactly two cache lines");
+
+void BuildSpellInfoHotData(SpellInfo const& spellInfo, SpellInfoHotData& hotData);
+
 class SpellImplicitTargetInfo
 {
 private:
@@ -422,6 +479,9 @@ public:
     inline bool HasAttribute(SpellAttr7 attribute) const { return (AttributesEx7 & attribute) != 0; }
     inline bool HasAttribute(SpellCustomAttributes customAttribute) const { return (AttributesCu & customAttribute) != 0; }
 
+    // only valid once SpellMgr::LoadSpellInfoHotData ran
+    SpellInfoHotData const& GetHotData() const { return *_hotData; }
+
     bool IsExplicitDiscovery() const;
     bool IsLootCrafting() const;
     bool IsQuestTame() const;
@@ -542,6 +602,8 @@ public:
     bool CheckElixirStacking(Unit const* caster) const;
 
 private:
+    SpellInfoHotData const* _hotData = nullptr;
+
     std::array<SpellEffectInfo, MAX_SPELL_EFFECTS>& _GetEffects() { return Effects; }
     SpellEffectInfo& _GetEffect(SpellEffIndex index) { ASSERT(index < Effects.size()); return Effects[index]; }
 };
@@ -734,6 +734,20 @@ SpellProcEventEntry const* SpellMgr::GetSpellProcEvent(uint32 spellId) const
     return nullptr;
 }
 
+uint32 SpellMgr::GetSpellProcEventFlags(SpellInfo const* spellProto) const
+{
+    // auras with a spell_proc entry are handled by the new proc system
+    if (GetSpellProcEntry(spellProto->Id))
+        return 0;
+
+    // custom spellProcEvent->procFlags override the spell proto ones
+    SpellProcEventEntry const* spellProcEvent = GetSpellProcEvent(spellProto->Id);
+    if (spellProcEvent && spellProcEvent->procFlags)
+        return spellProcEvent->procFlags;
+
+    return spellProto->ProcFlags;
+}
+
 bool SpellMgr::IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, ProcEventInfo const& eventInfo, bool active) const
 {
     // No extra req need
@@ -1739,6 +1753,7 @@ void SpellMgr::LoadSpellProcEvents()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcEventMap.clear();                             // need for reload case
+    ++_procDataGeneration;
 
     //                                                0      1           2                3                 4                 5                 6          7       8          9             10       11
     QueryResult result = WorldDatabase.Query("SELECT entry, SchoolMask, SpellFamilyName, SpellFamilyMask0, SpellFamilyMask1, SpellFamilyMask2, procFlags, procEx, procPhase, ppmRate, CustomChance, Cooldown FROM spell_proc_event");
@@ -1833,6 +1848,7 @@ void SpellMgr::LoadSpellProcs()
     uint32 oldMSTime = getMSTime();
 
     mSpellProcMap.clear();                             // need for reload case
+    ++_procDataGeneration;
 
     //                                                 0        1           2                3                 4                 5                 6          7              8              9         10              11             12      13        14
     QueryResult result = WorldDatabase.Query("SELECT SpellId, SchoolMask, SpellFamilyName, SpellFamilyMask0, SpellFamilyMask1, SpellFamilyMask2, ProcFlags, SpellTypeMask, SpellPhaseMask, HitMask, AttributesMask, ProcsPerMinute, Chance, Cooldown, Charges FROM spell_proc");
@@ -2516,7 +2532,10 @@ void SpellMgr::LoadSpellAreas()
         if (SpellInfo const* spellInfo = GetSpellInfo(spell))
         {
             if (spellArea.autocast)
+            {
                 const_cast<SpellInfo*>(spellInfo)->Attributes |= SPELL_ATTR0_NO_AURA_CANCEL;
+                UpdateSpellInfoHotData(spellInfo);
+            }
         }
         else
         {
@@ -2764,6 +2783,7 @@ void SpellMgr::UnloadSpellInfoStore()
         delete mSpellInfoMap[i];
 
     mSpellInfoMap.clear();
+    mSpellInfoHotData.clear();
 }
 
 void SpellMgr::UnloadSpellInfoImplicitTargetConditionLists()
@@ -3514,3 +3534,34 @@ void SpellMgr::LoadSpellInfoCustomAttributes()
     LOG_INFO("server.loading", ">> Loaded SpellInfo Custom Attributes in {} ms", GetMSTimeDiffToNow(oldMSTime));
     LOG_INFO("server.loading", " ");
 }
+
+void SpellMgr::LoadSpellInfoHotData()
+{
+    uint32 oldMSTime = getMSTime();
+
+    // spell infos keep pointers into the table, it must not be resized after this
+    mSpellInfoHotData.clear();
+    mSpellInfoHotData.resize(std::count_if(mSpellInfoMap.begin(), mSpellInfoMap.end(), [](SpellInfo const* spellInfo) { return spellInfo != nullptr; }));
+
+    uint32 count = 0;
+    for (SpellInfo* spellInfo : mSpellInfoMap)
+    {
+        if (!spellInfo)
+            continue;
+
+        spellInfo->_hotData = &mSpellInfoHotData[count++];
+        UpdateSpellInfoHotData(spellInfo);
+    }
+
+    LOG_INFO("server.loading", ">> Loaded {} SpellInfo Hot Data Entries in {} ms", count, GetMSTimeDiffToNow(oldMSTime));
+    LOG_INFO("server.loading", " ");
+}
+
+void SpellMgr::UpdateSpellInfoHotData(SpellInfo const* spellInfo)
+{
+    // table not built yet, it will pick up the change
+    if (!spellInfo->_hotData)
+        return;
+
+    BuildSpellInfoHotData(*spellInfo, const_cast<SpellInfoHotData&>(*spellInfo->_hotData));
+}
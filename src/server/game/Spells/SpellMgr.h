@@ -26,6 +26,7 @@
 #include "Unit.h"
 
 class SpellInfo;
+struct SpellInfoHotData;
 class Player;
 class Unit;
 class ProcEventInfo;
@@ -581,6 +582,7 @@ using PetDefaultSpellsMap = std::map<int32, PetDefaultSpellsEntry>;
 using SpellCustomAttribute = std::vector<uint32>;
 using EnchantCustomAttribute = std::vector<bool>;
 using SpellInfoMap = std::vector<SpellInfo*>;
+using SpellInfoHotDataStore = std::vector<SpellInfoHotData>;
 using SpellLinkedMap = std::map<int32, std::vector<int32> >;
 struct SpellCooldownOverride
 {
@@ -666,6 +668,10 @@ public:
     // Spell proc event table
     [[nodiscard]] SpellProcEventEntry const* GetSpellProcEvent(uint32 spellId) const;
     bool IsSpellProcEventCanTriggeredBy(SpellInfo const* spellProto, SpellProcEventEntry const* spellProcEvent, uint32 EventProcFlag, ProcEventInfo const& eventInfo, bool active) const;
+    // Proc flags an aura of this spell reacts to in Unit::ProcDamageAndSpellFor, 0 if it never procs there
+    [[nodiscard]] uint32 GetSpellProcEventFlags(SpellInfo const* spellProto) const;
+    // Changes whenever spell_proc_event or spell_proc is (re)loaded
+    [[nodiscard]] uint32 GetProcDataGeneration() const { return _procDataGeneration; }
 
     // Spell proc table
     [[nodiscard]] SpellProcEntry const* GetSpellProcEntry(uint32 spellId) const;
@@ -727,6 +733,9 @@ public:
     }
     [[nodiscard]] uint32 GetSpellInfoStoreSize() const { return mSpellInfoMap.size(); }
 
+    // Copies changed SpellInfo fields into the hot data read by the cast checks
+    void UpdateSpellInfoHotData(SpellInfo const* spellInfo);
+
     // Talent Additional Set
     [[nodiscard]] bool IsAdditionalTalentSpell(uint32 spellId) const;
 
@@ -767,6 +776,7 @@ public:
     void LoadSpellInfoCustomAttributes();
     void LoadSpellInfoCorrections();
     void LoadSpellSpecificAndAuraState();
+    void LoadSpellInfoHotData();
 
 private:
     SpellDifficultySearcherMap mSpellDifficultySearcherMap;
@@ -779,6 +789,7 @@ private:
     SpellGroupStackMap         mSpellGroupStackMap;
     SpellProcEventMap          mSpellProcEventMap;
     SpellProcMap               mSpellProcMap;
+    uint32                     _procDataGeneration = 0;
     SpellBonusMap              mSpellBonusMap;
     SpellThreatMap             mSpellThreatMap;
     SpellMixologyMap           mSpellMixologyMap;
@@ -795,6 +806,7 @@ private:
     PetLevelupSpellMap         mPetLevelupSpellMap;
     PetDefaultSpellsMap        mPetDefaultSpellsMap;           // only spells not listed in related mPetLevelupSpellMap entry
     SpellInfoMap               mSpellInfoMap;
+    SpellInfoHotDataStore      mSpellInfoHotData;
     SpellCooldownOverrideMap   mSpellCooldownOverrideMap;
     TalentAdditionalSet        mTalentSpellAdditionalSet;
 };
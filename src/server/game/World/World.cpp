@@ -45,6 +45,7 @@
 #include "DatabaseEnv.h"
 #include "DisableMgr.h"
 #include "DynamicVisibility.h"
+#include "ExpiredMailMgr.h"
 #include "GameEventMgr.h"
 #include "GameGraveyard.h"
 #include "GameTime.h"
@@ -79,6 +80,7 @@
 #include "SmartAI.h"
 #include "SpellMgr.h"
 #include "TaskScheduler.h"
+#include "TerrainTileCache.h"
 #include "TicketMgr.h"
 #include "Transport.h"
 #include "TransportMgr.h"
@@ -429,6 +431,9 @@ void World::SetInitialWorldSettings()
     LOG_INFO("server.loading", "Loading SpellInfo Custom Attributes...");
     sSpellMgr->LoadSpellInfoCustomAttributes();
 
+    LOG_INFO("server.loading", "Loading SpellInfo Hot Data...");
+    sSpellMgr->LoadSpellInfoHotData();
+
     LOG_INFO("server.loading", "Loading Player Totem models...");
     sObjectMgr->LoadPlayerTotemModels();
 
@@ -830,7 +835,7 @@ void World::SetInitialWorldSettings()
     ///- Handle outdated emails (delete/return)
     LOG_INFO("server.loading", "Returning Old Mails...");
     LOG_INFO("server.loading", " ");
-    sObjectMgr->ReturnOrDeleteOldMails(false);
+    sExpiredMailMgr->ReturnOrDeleteAll();
 
     ///- Load AutoBroadCast
     LOG_INFO("server.loading", "Loading Autobroadcasts...");
@@ -1170,10 +1175,15 @@ void World::Update(uint32 diff)
 
     if (currentGameTime > _mail_expire_check_timer)
     {
-        sObjectMgr->ReturnOrDeleteOldMails(true);
+        sExpiredMailMgr->Start();
         _mail_expire_check_timer = currentGameTime + 6h;
     }
 
+    {
+        METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update expired mails"));
+        sExpiredMailMgr->Update();
+    }
+
     {
         METRIC_TIMER("world_update_time", METRIC_TAG("type", "Update sessions"));
         sWorldSessionMgr->UpdateSessions(diff);
@@ -1317,6 +1327,8 @@ void World::Update(uint32 diff)
         // Stats logger update
         sMetric->Update();
         METRIC_VALUE("update_time_diff", diff);
+        METRIC_VALUE("terrain_tiles_resident", uint64(sTerrainTileCache->GetResidentTiles()));
+        METRIC_VALUE("terrain_tiles_bytes", uint64(sTerrainTileCache->GetResidentBytes()));
     }
 }
 
@@ -290,6 +290,7 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_OBJECT_QUEST_MARKERS, "Visibility.ObjectQuestMarkers", true);
 
     SetConfigValue<uint32>(CONFIG_MAIL_DELIVERY_DELAY, "MailDeliveryDelay", HOUR);
+    SetConfigValue<uint32>(CONFIG_MAIL_EXPIRATION_BATCH_SIZE, "MailExpiration.BatchSize", 100, ConfigValueCache::Reloadable::Yes, [](uint32 const& value) { return value > 0; }, "> 0");
 
     SetConfigValue<uint32>(CONFIG_UPTIME_UPDATE, "UpdateUptimeInterval", 10, ConfigValueCache::Reloadable::Yes, [](uint32 const& value) { return value > 0; }, "> 0");
 
@@ -437,6 +438,7 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<uint32>(CONFIG_BATTLEGROUND_EYEOFTHESTORM_CAPTUREPOINTS, "Battleground.EyeOfTheStorm.CapturePoints", 1600);
 
     SetConfigValue<uint32>(CONFIG_ARENA_MAX_RATING_DIFFERENCE, "Arena.MaxRatingDifference", 150);
+    SetConfigValue<uint32>(CONFIG_ARENA_MAX_RATING_DIFFERENCE_GROWTH, "Arena.MaxRatingDifferenceGrowth", 0);
     SetConfigValue<uint32>(CONFIG_ARENA_RATING_DISCARD_TIMER, "Arena.RatingDiscardTimer", 600000);
     SetConfigValue<uint32>(CONFIG_ARENA_PREV_OPPONENTS_DISCARD_TIMER, "Arena.PreviousOpponentsDiscardTimer", 120000);
     SetConfigValue<bool>(CONFIG_ARENA_AUTO_DISTRIBUTE_POINTS, "Arena.AutoDistributePoints", false);
@@ -514,6 +516,9 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_VMAP_BLIZZLIKE_PVP_LOS, "vmap.BlizzlikePvPLOS", true);
     SetConfigValue<bool>(CONFIG_VMAP_BLIZZLIKE_LOS_OPEN_WORLD, "vmap.BlizzlikeLOSInOpenWorld", true);
 
+    SetConfigValue<bool>(CONFIG_VMAP_QUERY_CACHE_ENABLE, "vmap.QueryCache.Enable", true);
+    SetConfigValue<uint32>(CONFIG_VMAP_QUERY_CACHE_TTL, "vmap.QueryCache.TTL", 500);
+
     SetConfigValue<bool>(CONFIG_START_CUSTOM_SPELLS, "PlayerStart.CustomSpells", false);
     SetConfigValue<uint32>(CONFIG_HONOR_AFTER_DUEL, "HonorPointsAfterDuel", 0);
     SetConfigValue<bool>(CONFIG_START_ALL_EXPLORED, "PlayerStart.MapsExplored", false);
@@ -530,6 +535,10 @@ void WorldConfig::BuildConfigCache()
     SetConfigValue<bool>(CONFIG_SHOW_MUTE_IN_WORLD, "ShowMuteInWorld", false);
     SetConfigValue<bool>(CONFIG_SHOW_BAN_IN_WORLD, "ShowBanInWorld", false);
     SetConfigValue<uint32>(CONFIG_NUMTHREADS, "MapUpdate.Threads", 1);
+    SetConfigValue<bool>(CONFIG_MAP_SPATIAL_INDEX, "MapUpdate.SpatialIndex", false);
+    SetConfigValue<uint32>(CONFIG_GRID_PRELOAD_THREADS, "MapUpdate.GridPreload.Threads", 1);
+    SetConfigValue<uint32>(CONFIG_GRID_PRELOAD_LOOKAHEAD, "MapUpdate.GridPreload.LookAhead", 10000);
+    SetConfigValue<uint32>(CONFIG_CREATURE_SLEEP_INTERVAL, "MapUpdate.CreatureSleep", 0);
     SetConfigValue<uint32>(CONFIG_MAX_RESULTS_LOOKUP_COMMANDS, "Command.LookupMaxResults", 0);
 
     // Warden
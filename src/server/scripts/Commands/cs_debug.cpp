@@ -29,7 +29,10 @@
 #include "MapMgr.h"
 #include "ObjectMgr.h"
 #include "PoolMgr.h"
+#include "ScratchArena.h"
 #include "ScriptMgr.h"
+#include "SlabPool.h"
+#include "TerrainTileCache.h"
 #include "Transport.h"
 #include "Warden.h"
 #include <fstream>
@@ -97,6 +100,7 @@ public:
             { "moveflags",      HandleDebugMoveflagsCommand,           SEC_ADMINISTRATOR, Console::No },
             { "unitstate",      HandleDebugUnitStateCommand,           SEC_ADMINISTRATOR, Console::No },
             { "objectcount",    HandleDebugObjectCountCommand,         SEC_ADMINISTRATOR, Console::Yes},
+            { "objectpools",    HandleDebugObjectPoolsCommand,         SEC_ADMINISTRATOR, Console::Yes},
             { "dummy",          HandleDebugDummyCommand,               SEC_ADMINISTRATOR, Console::No },
             { "mapdata",        HandleDebugMapDataCommand,             SEC_ADMINISTRATOR, Console::No },
             { "boundary",       HandleDebugBoundaryCommand,            SEC_ADMINISTRATOR, Console::No }
@@ -1363,6 +1367,46 @@ public:
             handler->PSendSysMessage("Entry: {} Count: {}", p.first, p.second);
     }
 
+    static bool HandleDebugObjectPoolsCommand(ChatHandler* handler)
+    {
+        for (Acore::SlabPool const* pool : Acore::SlabPool::GetPools())
+        {
+            std::vector<Acore::SlabPoolStats> const stats = pool->GetStats();
+
+            uint64 reserved = 0, used = 0, requested = 0, live = 0, allocations = 0, deallocations = 0;
+            for (Acore::SlabPoolStats const& sizeStats : stats)
+            {
+                reserved += sizeStats.ReservedBytes;
+                used += sizeStats.LiveBlocks * sizeStats.BlockSize;
+                requested += sizeStats.RequestedBytes;
+                live += sizeStats.LiveBlocks;
+                allocations += sizeStats.Allocations;
+                deallocations += sizeStats.Deallocations;
+            }
+
+            // free blocks inside the slabs are the fragmentation of the pool, rounding up to the block size is lost inside the used blocks
+            handler->PSendSysMessage("Pool {}: {} live objects, {} allocations, {} deallocations, {} oversized allocations",
+                pool->GetName(), live, allocations, deallocations, pool->GetOversizedAllocations());
+            handler->PSendSysMessage("  {} KB reserved, {} KB used, free {:.1f}%, rounding {:.1f}%",
+                reserved / 1024, used / 1024,
+                reserved ? 100.0 * (reserved - std::min(used, reserved)) / reserved : 0.0,
+                used ? 100.0 * (used - std::min(requested, used)) / used : 0.0);
+
+            for (Acore::SlabPoolStats const& sizeStats : stats)
+                handler->PSendSysMessage("  {} byte blocks: {} / {} in use in {} slabs, {} allocations",
+                    sizeStats.BlockSize, sizeStats.LiveBlocks, sizeStats.TotalBlocks, sizeStats.Slabs, sizeStats.Allocations);
+        }
+
+        // every arena allocation used to be a heap allocation, arena blocks and allocations outside of map updates still are
+        Acore::ScratchArenaStats const scratch = Acore::ScratchArena::GetStats();
+        handler->PSendSysMessage("Scratch arenas: {} allocations ({} KB) served by map threads, {} heap allocations for arena blocks, {} heap allocations outside of map updates",
+            scratch.Allocations, scratch.AllocatedBytes / 1024, scratch.BlockAllocations, scratch.HeapAllocations);
+        handler->PSendSysMessage("  {} KB retained, {} rewinds skipped because scratch memory was still in use",
+            scratch.RetainedBytes / 1024, scratch.SkippedRewinds);
+
+        return true;
+    }
+
     static bool HandleDebugDummyCommand(ChatHandler* handler)
     {
         handler->SendSysMessage("This command does nothing right now. Edit your local core (cs_debug.cpp) to make it do whatever you need for testing.");
@@ -1380,6 +1424,8 @@ public:
         handler->PSendSysMessage("Loaded Grids: {} / {}", map->GetLoadedGridsCount(), MAX_NUMBER_OF_GRIDS * MAX_NUMBER_OF_GRIDS);
         handler->PSendSysMessage("Created Cells In Grid: {} / {}", map->GetCreatedCellsInGridCount(cell.GridX(), cell.GridY()), MAX_NUMBER_OF_CELLS * MAX_NUMBER_OF_CELLS);
         handler->PSendSysMessage("Created Cells In Map: {} / {}", map->GetCreatedCellsInMapCount(), TOTAL_NUMBER_OF_CELLS_PER_MAP * TOTAL_NUMBER_OF_CELLS_PER_MAP);
+        handler->PSendSysMessage("Resident Terrain Tiles (all maps): {} ({} KB), referenced by {} grids",
+            sTerrainTileCache->GetResidentTiles(), sTerrainTileCache->GetResidentBytes() / 1024, sTerrainTileCache->GetReferences());
         return true;
     }
 
@@ -33,20 +33,22 @@ bool DBCStorageBase::Load(char const* path, char**& indexTable)
 {
     indexTable = nullptr;
 
-    DBCFileLoader dbc;
+    std::unique_ptr<DBCFileLoader> dbc = std::make_unique<DBCFileLoader>();
 
     // Check if load was sucessful, only then continue
-    if (!dbc.Load(path, _fileFormat))
+    if (!dbc->Load(path, _fileFormat))
         return false;
 
-    _fieldCount = dbc.GetCols();
+    _fieldCount = dbc->GetCols();
 
-    // load raw non-string data
-    _dataTable = dbc.AutoProduceData(_fileFormat, _indexTableSize, indexTable);
+    // load raw non-string data, records matching the structure stay in the mapped file
+    _dataTable = dbc->AutoProduceData(_fileFormat, _indexTableSize, indexTable);
 
     // load strings from dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+    dbc->AutoProduceStrings(_fileFormat, _dataTable);
+
+    if (dbc->IsReferenced())
+        _files.push_back(std::move(dbc));
 
     // error in dbc file at loading if nullptr
     return indexTable != nullptr;
@@ -58,15 +60,15 @@ bool DBCStorageBase::LoadStringsFrom(char const* path, char** indexTable)
     if (!indexTable)
         return false;
 
-    DBCFileLoader dbc;
+    std::unique_ptr<DBCFileLoader> dbc = std::make_unique<DBCFileLoader>();
 
     // Check if load was successful, only then continue
-    if (!dbc.Load(path, _fileFormat))
+    if (!dbc->Load(path, _fileFormat))
         return false;
 
     // load strings from another locale dbc data
-    if (char* stringBlock = dbc.AutoProduceStrings(_fileFormat, _dataTable))
-        _stringPool.push_back(stringBlock);
+    if (dbc->AutoProduceStrings(_fileFormat, _dataTable))
+        _files.push_back(std::move(dbc));
 
     return true;
 }
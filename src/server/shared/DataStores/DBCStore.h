@@ -22,8 +22,11 @@
 #include "DBCStorageIterator.h"
 #include "Errors.h"
 #include <cstring>
+#include <memory>
 #include <vector>
 
+class DBCFileLoader;
+
 /// Interface class for common access
 class DBCStorageBase
 {
@@ -47,6 +50,7 @@ protected:
     char const* _fileFormat;
     char* _dataTable;
     std::vector<char*> _stringPool;
+    std::vector<std::unique_ptr<DBCFileLoader>> _files;   // mapped files referenced by records or strings
     uint32 _indexTableSize;
 };
 
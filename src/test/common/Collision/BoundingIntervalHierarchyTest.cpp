@@ -0,0 +1,210 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "BoundingIntervalHierarchy.h"
+#include "gtest/gtest.h"
+#include <random>
+
+namespace
+{
+    struct BoxBounds
+    {
+        void operator()(G3D::AABox const& box, G3D::AABox& bounds) const { bounds = box; }
+    };
+
+    // distance along the ray to the box, or a negative value on a miss
+    float IntersectBox(G3D::Ray const& ray, G3D::AABox const& box)
+    {
+        float tMin = 0.f;
+        float tMax = std::numeric_limits<float>::max();
+        for (int axis = 0; axis < 3; ++axis)
+        {
+            float const org = ray.origin()[axis];
+            float const dir = ray.direction()[axis];
+            if (dir == 0.f)
+            {
+                if (org < box.low()[axis] || org > box.high()[axis])
+                    return -1.f;
+                continue;
+            }
+
+            float t1 = (box.low()[axis] - org) / dir;
+            float t2 = (box.high()[axis] - org) / dir;
+            if (t1 > t2)
+                std::swap(t1, t2);
+            tMin = std::max(tMin, t1);
+            tMax = std::min(tMax, t2);
+            if (tMin > tMax)
+                return -1.f;
+        }
+
+        return tMin;
+    }
+
+    class BoxRayCallback
+    {
+    public:
+        explicit BoxRayCallback(std::vector<G3D::AABox> const& boxes) : _boxes(boxes) { }
+
+        bool operator()(G3D::Ray const& ray, uint32 entry, float& distance, bool /*stopAtFirstHit*/)
+        {
+            float const t = IntersectBox(ray, _boxes[entry]);
+            if (t < 0.f || t >= distance)
+                return false;
+
+            distance = t;
+            return true;
+        }
+
+        bool operator()(uint32 /*rayIndex*/, G3D::Ray const& ray, uint32 entry, float& distance, bool stopAtFirstHit)
+        {
+            return (*this)(ray, entry, distance, stopAtFirstHit);
+        }
+
+    private:
+        std::vector<G3D::AABox> const& _boxes;
+    };
+
+    class BoundingIntervalHierarchyTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::uniform_real_distribution<float> position(-100.f, 100.f);
+            std::uniform_real_distribution<float> size(0.5f, 8.f);
+            for (uint32 i = 0; i < 400; ++i)
+            {
+                G3D::Vector3 low(position(_rng), position(_rng), position(_rng));
+                _boxes.emplace_back(low, low + G3D::Vector3(size(_rng), size(_rng), size(_rng)));
+            }
+
+            BoxBounds bounds;
+            _tree.build(_boxes, bounds);
+        }
+
+        // random targets, some of them straight along an axis or right at the origin
+        std::vector<G3D::Vector3> MakeTargets(G3D::Vector3 const& origin, uint32 count)
+        {
+            std::uniform_real_distribution<float> position(-120.f, 120.f);
+            std::vector<G3D::Vector3> targets;
+            for (uint32 i = 0; i < count; ++i)
+            {
+                G3D::Vector3 target(position(_rng), position(_rng), position(_rng));
+                switch (i % 10)
+                {
+                    case 7:
+                        target.y = origin.y;
+                        target.z = origin.z;
+                        break;
+                    case 8:
+                        target.x = origin.x;
+                        break;
+                    default:
+                        break;
+                }
+
+                if (target != origin)
+                    targets.push_back(target);
+            }
+
+            return targets;
+        }
+
+        // runs the targets through intersectRay one at a time and through intersectRays as a bundle,
+        // returns the distances to the hits of both
+        void Intersect(G3D::Vector3 const& origin, std::vector<G3D::Vector3> const& targets, bool stopAtFirstHit, std::vector<float>& single, std::vector<float>& bundle)
+        {
+            BoxRayCallback callback(_boxes);
+            std::vector<G3D::Vector3> dirs;
+            for (G3D::Vector3 const& target : targets)
+            {
+                float distance = (target - origin).magnitude();
+                G3D::Vector3 const dir = (target - origin) / distance;
+                _tree.intersectRay(G3D::Ray::fromOriginAndDirection(origin, dir), callback, distance, stopAtFirstHit);
+                single.push_back(distance);
+                dirs.push_back(dir);
+                bundle.push_back((target - origin).magnitude());
+            }
+
+            _tree.intersectRays(origin, dirs.data(), bundle.data(), dirs.size(), callback, stopAtFirstHit);
+        }
+
+        std::mt19937 _rng{ 42 };
+        std::vector<G3D::AABox> _boxes;
+        BIH _tree;
+    };
+}
+
+TEST_F(BoundingIntervalHierarchyTest, RayBundleFindsNearestHitsOfSingleRays)
+{
+    std::uniform_real_distribution<float> position(-110.f, 110.f);
+    uint32 hits = 0;
+    for (uint32 round = 0; round < 200; ++round)
+    {
+        G3D::Vector3 const origin(position(_rng), position(_rng), position(_rng));
+        // odd counts leave part of the last packet unused
+        std::vector<G3D::Vector3> const targets = MakeTargets(origin, 1 + round % 37);
+
+        std::vector<float> single;
+        std::vector<float> bundle;
+        Intersect(origin, targets, false, single, bundle);
+
+        ASSERT_EQ(single.size(), bundle.size());
+        for (uint32 i = 0; i < single.size(); ++i)
+        {
+            EXPECT_EQ(single[i], bundle[i]) << "round " << round << " ray " << i;
+            hits += single[i] < (targets[i] - origin).magnitude();
+        }
+    }
+
+    // the scene has to block a fair share of rays for the comparison to mean anything
+    EXPECT_GT(hits, 500u);
+}
+
+TEST_F(BoundingIntervalHierarchyTest, RayBundleStopsAtFirstHitLikeSingleRays)
+{
+    std::uniform_real_distribution<float> position(-110.f, 110.f);
+    for (uint32 round = 0; round < 200; ++round)
+    {
+        G3D::Vector3 const origin(position(_rng), position(_rng), position(_rng));
+        std::vector<G3D::Vector3> const targets = MakeTargets(origin, 1 + round % 37);
+
+        std::vector<float> single;
+        std::vector<float> bundle;
+        Intersect(origin, targets, true, single, bundle);
+
+        ASSERT_EQ(single.size(), bundle.size());
+        for (uint32 i = 0; i < single.size(); ++i)
+        {
+            float const distance = (targets[i] - origin).magnitude();
+            EXPECT_EQ(single[i] < distance, bundle[i] < distance) << "round " << round << " ray " << i;
+        }
+    }
+}
+
+TEST_F(BoundingIntervalHierarchyTest, RayBundleOutsideTreeBoundsHitsNothing)
+{
+    G3D::Vector3 const origin(500.f, 500.f, 500.f);
+    std::vector<G3D::Vector3> const dirs = { G3D::Vector3(1.f, 0.f, 0.f), G3D::Vector3(0.f, 1.f, 0.f), G3D::Vector3(0.f, 0.f, 1.f) };
+    std::vector<float> distances(dirs.size(), 50.f);
+
+    BoxRayCallback callback(_boxes);
+    _tree.intersectRays(origin, dirs.data(), distances.data(), dirs.size(), callback, true);
+
+    for (float distance : distances)
+        EXPECT_EQ(distance, 50.f);
+}
@@ -0,0 +1,210 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DBCFileLoader.h"
+#include "gtest/gtest.h"
+#include <boost/filesystem.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // id, name, unused, count, scale
+    constexpr char ENTRY_FORMAT[] = "nsxif";
+    // id, count, flags, scale
+    constexpr char IN_PLACE_FORMAT[] = "niif";
+
+    // produced records are packed like the structures of DBCStructure.h
+#pragma pack(push, 1)
+    struct Entry
+    {
+        uint32 Id;
+        char const* Name;
+        uint32 Count;
+        float Scale;
+    };
+
+    struct InPlaceEntry
+    {
+        uint32 Id;
+        uint32 Count;
+        uint32 Flags;
+        float Scale;
+    };
+#pragma pack(pop)
+
+    static_assert(DBCFileLoader::IsInPlaceFormat(IN_PLACE_FORMAT));
+    static_assert(!DBCFileLoader::IsInPlaceFormat(ENTRY_FORMAT));
+    static_assert(DBCFileLoader::GetFormatRecordSize(IN_PLACE_FORMAT) == sizeof(InPlaceEntry));
+    static_assert(DBCFileLoader::GetFormatRecordSize(ENTRY_FORMAT) == sizeof(Entry));
+
+    std::vector<std::string> const NAMES = { "Stormwind", "", "Orgrimmar", "Dalaran" };
+
+    // Five 4 byte fields per record: the ids are sparse, the third field is a string offset in the entry format
+    class DBCFileLoaderTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            _path = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("deleteme-%%%%-%%%%.dbc")).string();
+
+            std::string strings(1, '\0');
+            std::vector<uint32> values;
+            for (uint32 i = 0; i < NAMES.size(); ++i)
+            {
+                uint32 nameOffset = 0;
+                if (!NAMES[i].empty())
+                {
+                    nameOffset = strings.size();
+                    strings += NAMES[i];
+                    strings += '\0';
+                }
+
+                float const scale = 0.5f * i;
+                uint32 scaleBits;
+                std::memcpy(&scaleBits, &scale, sizeof(scale));
+
+                values.insert(values.end(), { 3 * i + 1, nameOffset, 0xDEADBEEF, 100 + i, scaleBits });
+            }
+
+            WriteFile(values, strings);
+        }
+
+        void TearDown() override
+        {
+            std::remove(_path.c_str());
+        }
+
+        void WriteFile(std::vector<uint32> const& values, std::string const& strings, uint32 signature = 0x43424457)
+        {
+            uint32 const header[5] = { signature, uint32(NAMES.size()), 5, 5 * sizeof(uint32), uint32(strings.size()) };
+            std::ofstream file(_path, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<char const*>(header), sizeof(header));
+            file.write(reinterpret_cast<char const*>(values.data()), values.size() * sizeof(uint32));
+            file.write(strings.data(), strings.size());
+        }
+
+        std::string _path;
+    };
+}
+
+TEST_F(DBCFileLoaderTest, ProducesCopiedRecordsAndMappedStrings)
+{
+    DBCFileLoader loader;
+    ASSERT_TRUE(loader.Load(_path.c_str(), ENTRY_FORMAT));
+    EXPECT_EQ(loader.GetNumRows(), NAMES.size());
+    EXPECT_EQ(loader.GetCols(), 5u);
+
+    uint32 count = 0;
+    char** indexTable = nullptr;
+    char* dataTable = loader.AutoProduceData(ENTRY_FORMAT, count, indexTable);
+    ASSERT_NE(dataTable, nullptr);
+    EXPECT_FALSE(loader.IsReferenced());
+    ASSERT_TRUE(loader.AutoProduceStrings(ENTRY_FORMAT, dataTable));
+    EXPECT_TRUE(loader.IsReferenced());
+
+    ASSERT_EQ(count, 3 * (NAMES.size() - 1) + 2);
+    for (uint32 id = 0; id < count; ++id)
+    {
+        Entry const* entry = reinterpret_cast<Entry const*>(indexTable[id]);
+        if (id % 3 != 1)
+        {
+            EXPECT_EQ(entry, nullptr);
+            continue;
+        }
+
+        uint32 const i = id / 3;
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->Id, id);
+        ASSERT_NE(entry->Name, nullptr);
+        EXPECT_EQ(std::string(entry->Name), NAMES[i]);
+        EXPECT_EQ(entry->Count, 100 + i);
+        EXPECT_EQ(entry->Scale, 0.5f * i);
+    }
+
+    delete[] dataTable;
+    delete[] indexTable;
+}
+
+TEST_F(DBCFileLoaderTest, InPlaceRecordsMatchTheFileLayout)
+{
+    // rewrite the file with four fields per record so it matches the in place format
+    std::vector<uint32> values;
+    for (uint32 i = 0; i < NAMES.size(); ++i)
+    {
+        float const scale = 0.25f * i;
+        uint32 scaleBits;
+        std::memcpy(&scaleBits, &scale, sizeof(scale));
+        values.insert(values.end(), { 2 * i, 10 * i, 0x80000000 | i, scaleBits });
+    }
+
+    uint32 const header[5] = { 0x43424457, uint32(NAMES.size()), 4, 4 * sizeof(uint32), 1 };
+    {
+        std::ofstream file(_path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<char const*>(header), sizeof(header));
+        file.write(reinterpret_cast<char const*>(values.data()), values.size() * sizeof(uint32));
+        file.put('\0');
+    }
+
+    DBCFileLoader loader;
+    ASSERT_TRUE(loader.Load(_path.c_str(), IN_PLACE_FORMAT));
+
+    uint32 count = 0;
+    char** indexTable = nullptr;
+    EXPECT_EQ(loader.AutoProduceData(IN_PLACE_FORMAT, count, indexTable), nullptr);
+    EXPECT_TRUE(loader.IsReferenced());
+    ASSERT_EQ(count, 2 * (NAMES.size() - 1) + 1);
+
+    for (uint32 i = 0; i < NAMES.size(); ++i)
+    {
+        InPlaceEntry* entry = reinterpret_cast<InPlaceEntry*>(indexTable[2 * i]);
+        ASSERT_NE(entry, nullptr);
+        EXPECT_EQ(entry->Id, 2 * i);
+        EXPECT_EQ(entry->Count, 10 * i);
+        EXPECT_EQ(entry->Flags, 0x80000000 | i);
+        EXPECT_EQ(entry->Scale, 0.25f * i);
+
+        if (i)
+            EXPECT_EQ(indexTable[2 * i - 1], nullptr);
+
+        // the mapping is private, records patched by the core do not change the file
+        entry->Count = 0;
+    }
+
+    delete[] indexTable;
+
+    DBCFileLoader reloaded;
+    ASSERT_TRUE(reloaded.Load(_path.c_str(), IN_PLACE_FORMAT));
+    for (uint32 i = 0; i < NAMES.size(); ++i)
+        EXPECT_EQ(reloaded.getRecord(i).getUInt(1), 10 * i);
+}
+
+TEST_F(DBCFileLoaderTest, RejectsInvalidFiles)
+{
+    DBCFileLoader loader;
+    EXPECT_FALSE(loader.Load((_path + ".missing").c_str(), ENTRY_FORMAT));
+    EXPECT_FALSE(loader.IsLoaded());
+
+    WriteFile({ }, std::string(1, '\0'), 0x43424457);
+    EXPECT_FALSE(loader.Load(_path.c_str(), ENTRY_FORMAT));
+
+    WriteFile(std::vector<uint32>(5 * NAMES.size()), std::string(1, '\0'), 0x12345678);
+    EXPECT_FALSE(loader.Load(_path.c_str(), ENTRY_FORMAT));
+}
@@ -0,0 +1,49 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "EventProcessor.h"
+#include "gtest/gtest.h"
+
+TEST(EventProcessorTest, EventAddedHandlerRunsForEveryEvent)
+{
+    EventProcessor events;
+    uint32 added = 0;
+    events.SetEventAddedHandler([&added]() { ++added; });
+
+    EXPECT_TRUE(events.Empty());
+
+    uint32 executed = 0;
+    events.AddEventAtOffset([&executed]() { ++executed; }, 100ms);
+    events.AddEventAtOffset([&executed]() { ++executed; }, 200ms);
+    EXPECT_EQ(added, 2u);
+    EXPECT_FALSE(events.Empty());
+
+    events.Update(150);
+    EXPECT_EQ(executed, 1u);
+    EXPECT_FALSE(events.Empty());
+
+    // events added while executing others are reported as well
+    events.AddEventAtOffset([&events]() { events.AddEventAtOffset([]() { }, 50ms); }, 10ms);
+    EXPECT_EQ(added, 3u);
+
+    events.Update(100);
+    EXPECT_EQ(executed, 2u);
+    EXPECT_EQ(added, 4u);
+
+    events.Update(100);
+    EXPECT_TRUE(events.Empty());
+}
@@ -0,0 +1,164 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ScratchArena.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+namespace
+{
+    constexpr uint32 SEARCHES_PER_UPDATE = 2000;
+
+    // One map update worth of searches: a target list per search, filtered and consumed before the next one
+    uint64 RunUpdate(std::mt19937& rng)
+    {
+        uint64 checksum = 0;
+        for (uint32 i = 0; i < SEARCHES_PER_UPDATE; ++i)
+        {
+            Acore::ScratchVector<uint64> targets;
+            uint32 const found = rng() % 64;
+            for (uint32 j = 0; j < found; ++j)
+                targets.push_back(rng());
+
+            Acore::ScratchList<uint64> chain(targets.begin(), targets.end());
+            chain.remove_if([](uint64 target) { return target % 3 == 0; });
+
+            checksum += std::accumulate(chain.begin(), chain.end(), uint64(0));
+        }
+
+        return checksum;
+    }
+}
+
+TEST(ScratchArenaTest, ContainersKeepTheirContents)
+{
+    Acore::ScratchArenaScope scope;
+
+    Acore::ScratchVector<uint32> numbers;
+    Acore::ScratchList<uint32> odd;
+    for (uint32 i = 0; i < 10000; ++i)
+    {
+        numbers.push_back(i);
+        if (i % 2)
+            odd.push_back(i);
+    }
+
+    // a container destroyed in between leaves the others intact
+    {
+        Acore::ScratchVector<uint64> temporary(5000, 7);
+        EXPECT_EQ(std::accumulate(temporary.begin(), temporary.end(), uint64(0)), 35000u);
+    }
+
+    Acore::ScratchVector<uint32> copy = numbers;
+    ASSERT_EQ(copy.size(), 10000u);
+    for (uint32 i = 0; i < 10000; ++i)
+        EXPECT_EQ(copy[i], i);
+
+    EXPECT_EQ(odd.size(), 5000u);
+    EXPECT_TRUE(std::all_of(odd.begin(), odd.end(), [](uint32 i) { return i % 2 == 1; }));
+}
+
+TEST(ScratchArenaTest, OverAlignedTypes)
+{
+    struct alignas(64) CacheLine
+    {
+        uint32 Value;
+    };
+
+    Acore::ScratchArenaScope scope;
+    Acore::ScratchVector<uint8> unaligned(3);
+    Acore::ScratchVector<CacheLine> lines(100);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(lines.data()) % 64, 0u);
+}
+
+TEST(ScratchArenaTest, HeapOutsideOfScope)
+{
+    uint64 const before = Acore::ScratchArena::GetStats().HeapAllocations;
+
+    Acore::ScratchVector<uint32> numbers;
+    numbers.reserve(16);
+    EXPECT_EQ(Acore::ScratchArena::GetStats().HeapAllocations, before + 1);
+
+    // a container created outside of the scope keeps its heap memory inside of it
+    {
+        Acore::ScratchArenaScope scope;
+        numbers.resize(1000);
+        EXPECT_EQ(Acore::ScratchArena::GetStats().HeapAllocations, before + 2);
+    }
+}
+
+TEST(ScratchArenaTest, LiveContainerSkipsRewind)
+{
+    uint64 const before = Acore::ScratchArena::GetStats().SkippedRewinds;
+
+    Acore::ScratchVector<uint32>* leftover = nullptr;
+    {
+        Acore::ScratchArenaScope scope;
+        leftover = new Acore::ScratchVector<uint32>(100, 5);
+    }
+
+    EXPECT_EQ(Acore::ScratchArena::GetStats().SkippedRewinds, before + 1);
+
+    {
+        Acore::ScratchArenaScope scope;
+        Acore::ScratchVector<uint32> other(100, 9);
+        EXPECT_EQ(std::accumulate(leftover->begin(), leftover->end(), 0u), 500u);
+    }
+
+    delete leftover;
+}
+
+TEST(ScratchArenaTest, SteadyStateAllocations)
+{
+    std::mt19937 rng(4711);
+    constexpr uint32 updates = 50;
+
+    // the same searches outside of a map update go to the heap
+    Acore::ScratchArenaStats const start = Acore::ScratchArena::GetStats();
+    uint64 heapChecksum = 0;
+    for (uint32 i = 0; i < updates; ++i)
+        heapChecksum += RunUpdate(rng);
+
+    Acore::ScratchArenaStats const afterHeap = Acore::ScratchArena::GetStats();
+    uint64 const heapAllocations = afterHeap.HeapAllocations - start.HeapAllocations;
+
+    // the first updates grow and merge the arena blocks
+    rng.seed(4711);
+    uint64 arenaChecksum = 0;
+    for (uint32 i = 0; i < 3; ++i)
+    {
+        Acore::ScratchArenaScope scope;
+        arenaChecksum += RunUpdate(rng);
+    }
+
+    // every following update is served without touching the heap
+    Acore::ScratchArenaStats const warm = Acore::ScratchArena::GetStats();
+    for (uint32 i = 3; i < updates; ++i)
+    {
+        Acore::ScratchArenaScope scope;
+        arenaChecksum += RunUpdate(rng);
+    }
+
+    Acore::ScratchArenaStats const end = Acore::ScratchArena::GetStats();
+    EXPECT_EQ(arenaChecksum, heapChecksum);
+    EXPECT_EQ(end.HeapAllocations, warm.HeapAllocations);
+    EXPECT_EQ(end.BlockAllocations, warm.BlockAllocations);
+    EXPECT_EQ(end.Allocations - afterHeap.Allocations, heapAllocations);
+    EXPECT_LE(end.RetainedBytes, Acore::ScratchArena::MAX_RETAINED_SIZE);
+}
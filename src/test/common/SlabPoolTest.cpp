@@ -0,0 +1,199 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SlabPool.h"
+#include "gtest/gtest.h"
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace
+{
+    constexpr std::size_t BLOCK_SIZE = 64;
+    constexpr std::size_t BLOCKS_PER_SLAB = Acore::SlabPool::MIN_SLAB_SIZE / BLOCK_SIZE;
+
+    // Every test uses its own pool, pools are never destroyed
+    class SlabPoolTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            _pool = &Acore::SlabPool::Create(::testing::UnitTest::GetInstance()->current_test_info()->name());
+
+            // address sanitizer builds send every request to the general heap
+            _pool->Deallocate(_pool->Allocate(Acore::SlabPool::BLOCK_GRANULARITY), Acore::SlabPool::BLOCK_GRANULARITY);
+            if (_pool->GetOversizedAllocations())
+                GTEST_SKIP() << "slab pools pass through to the heap in this build";
+        }
+
+        Acore::SlabPoolStats GetStats(std::size_t blockSize) const
+        {
+            for (Acore::SlabPoolStats const& stats : _pool->GetStats())
+                if (stats.BlockSize == blockSize)
+                    return stats;
+
+            return { };
+        }
+
+        std::vector<void*> Allocate(std::size_t count)
+        {
+            std::vector<void*> blocks;
+            for (std::size_t i = 0; i < count; ++i)
+                blocks.push_back(_pool->Allocate(BLOCK_SIZE));
+
+            return blocks;
+        }
+
+        void Deallocate(std::vector<void*> const& blocks)
+        {
+            for (void* block : blocks)
+                _pool->Deallocate(block, BLOCK_SIZE);
+        }
+
+        Acore::SlabPool* _pool = nullptr;
+    };
+}
+
+TEST_F(SlabPoolTest, SizeClasses)
+{
+    for (std::size_t size = 1; size <= Acore::SlabPool::MAX_BLOCK_SIZE; size = size < 256 ? size + 5 : size * 3 / 2)
+    {
+        std::size_t const blockSize = (size + Acore::SlabPool::BLOCK_GRANULARITY - 1) / Acore::SlabPool::BLOCK_GRANULARITY * Acore::SlabPool::BLOCK_GRANULARITY;
+
+        // two blocks of a class never overlap and keep what was written to them
+        char* first = static_cast<char*>(_pool->Allocate(size));
+        char* second = static_cast<char*>(_pool->Allocate(size));
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % Acore::SlabPool::BLOCK_GRANULARITY, 0u);
+        EXPECT_GE(std::size_t(std::abs(first - second)), blockSize) << "size " << size;
+        std::memset(first, 0x11, size);
+        std::memset(second, 0x22, size);
+        EXPECT_EQ(first[0], 0x11);
+        EXPECT_EQ(first[size - 1], 0x11);
+
+        Acore::SlabPoolStats const stats = GetStats(blockSize);
+        EXPECT_EQ(stats.BlockSize, blockSize) << "size " << size;
+        EXPECT_EQ(stats.LiveBlocks, 2u) << "size " << size;
+        EXPECT_EQ(stats.RequestedBytes, 2 * size) << "size " << size;
+        EXPECT_GE(stats.ReservedBytes, Acore::SlabPool::MIN_SLAB_SIZE);
+        EXPECT_GE(stats.TotalBlocks, Acore::SlabPool::MIN_BLOCKS_PER_SLAB);
+
+        // freed blocks are reused by the next objects of their class
+        _pool->Deallocate(second, size);
+        second = static_cast<char*>(_pool->Allocate(size));
+        EXPECT_EQ(GetStats(blockSize).Slabs, stats.Slabs);
+
+        _pool->Deallocate(first, size);
+        _pool->Deallocate(second, size);
+        EXPECT_EQ(GetStats(blockSize).LiveBlocks, 0u);
+        EXPECT_EQ(GetStats(blockSize).RequestedBytes, 0u);
+    }
+
+    EXPECT_EQ(_pool->GetOversizedAllocations(), 0u);
+
+    void* oversized = _pool->Allocate(Acore::SlabPool::MAX_BLOCK_SIZE + 1);
+    EXPECT_EQ(_pool->GetOversizedAllocations(), 1u);
+    _pool->Deallocate(oversized, Acore::SlabPool::MAX_BLOCK_SIZE + 1);
+    EXPECT_EQ(GetStats(Acore::SlabPool::MAX_BLOCK_SIZE + Acore::SlabPool::BLOCK_GRANULARITY).BlockSize, 0u);
+}
+
+TEST_F(SlabPoolTest, DeallocateOnAnotherThread)
+{
+    std::vector<void*> blocks;
+    std::thread allocator([&]()
+    {
+        blocks = Allocate(3 * Acore::SlabPool::THREAD_CACHE_BATCH);
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+            std::memset(blocks[i], int(i), BLOCK_SIZE);
+    });
+    allocator.join();
+
+    std::thread deallocator([&]()
+    {
+        for (std::size_t i = 0; i < blocks.size(); ++i)
+            EXPECT_EQ(static_cast<unsigned char*>(blocks[i])[BLOCK_SIZE - 1], i);
+
+        Deallocate(blocks);
+    });
+    deallocator.join();
+
+    Acore::SlabPoolStats const stats = GetStats(BLOCK_SIZE);
+    EXPECT_EQ(stats.LiveBlocks, 0u);
+    EXPECT_EQ(stats.Allocations, stats.Deallocations);
+
+    // both threads handed their blocks back when they exited, a whole slab is served without carving another
+    Deallocate(Allocate(BLOCKS_PER_SLAB));
+    EXPECT_EQ(GetStats(BLOCK_SIZE).Slabs, 1u);
+}
+
+TEST_F(SlabPoolTest, ThreadExitFlushesCache)
+{
+    // the first allocation carves a slab and the thread caches all of its other blocks
+    std::thread worker([&]() { Deallocate(Allocate(1)); });
+    worker.join();
+    ASSERT_EQ(GetStats(BLOCK_SIZE).Slabs, 1u);
+
+    std::vector<void*> blocks = Allocate(BLOCKS_PER_SLAB);
+    EXPECT_EQ(GetStats(BLOCK_SIZE).Slabs, 1u);
+
+    blocks.push_back(_pool->Allocate(BLOCK_SIZE));
+    EXPECT_EQ(GetStats(BLOCK_SIZE).Slabs, 2u);
+    Deallocate(blocks);
+}
+
+TEST_F(SlabPoolTest, ReleaseThreadCaches)
+{
+    std::mutex lock;
+    std::condition_variable condition;
+    bool released = false;
+    bool done = false;
+
+    std::thread worker([&]()
+    {
+        void* block = _pool->Allocate(BLOCK_SIZE);
+        Acore::SlabPool::ReleaseThreadCaches();
+
+        std::unique_lock<std::mutex> guard(lock);
+        released = true;
+        condition.notify_all();
+        condition.wait(guard, [&]() { return done; });
+
+        _pool->Deallocate(block, BLOCK_SIZE);
+    });
+
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        condition.wait(guard, [&]() { return released; });
+    }
+
+    // while the worker is alive, all but one batch of its free blocks are shared
+    std::size_t const shared = BLOCKS_PER_SLAB - 1 - Acore::SlabPool::THREAD_CACHE_BATCH;
+    std::vector<void*> blocks = Allocate(shared);
+    EXPECT_EQ(GetStats(BLOCK_SIZE).Slabs, 1u);
+
+    blocks.push_back(_pool->Allocate(BLOCK_SIZE));
+    EXPECT_EQ(GetStats(BLOCK_SIZE).Slabs, 2u);
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        done = true;
+        condition.notify_all();
+    }
+
+    worker.join();
+    Deallocate(blocks);
+}
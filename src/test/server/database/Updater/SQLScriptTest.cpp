@@ -0,0 +1,65 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SQLScript.h"
+#include "gtest/gtest.h"
+
+using Acore::SQLScript::Split;
+using Statements = std::vector<std::string>;
+
+TEST(SQLScriptTest, SplitsAtDelimiter)
+{
+    EXPECT_EQ(Split("DELETE FROM `a`;\nINSERT INTO `a` VALUES (1);\n"), Statements({ "DELETE FROM `a`", "INSERT INTO `a` VALUES (1)" }));
+    EXPECT_EQ(Split("SELECT 1"), Statements({ "SELECT 1" }));
+    EXPECT_EQ(Split(" ;\n;; \n"), Statements());
+}
+
+TEST(SQLScriptTest, IgnoresDelimiterInQuotes)
+{
+    EXPECT_EQ(Split("INSERT INTO `a;b` VALUES ('x;y', \"z;\");"), Statements({ "INSERT INTO `a;b` VALUES ('x;y', \"z;\")" }));
+    EXPECT_EQ(Split("SELECT 'it''s;'; SELECT 'a\\';b';"), Statements({ "SELECT 'it''s;'", "SELECT 'a\\';b'" }));
+}
+
+TEST(SQLScriptTest, DropsComments)
+{
+    EXPECT_EQ(Split("-- comment; with delimiter\nSELECT 1; # another;\n/* block; */SELECT 2;"), Statements({ "SELECT 1", "SELECT 2" }));
+    EXPECT_EQ(Split("SELECT 3--1;"), Statements({ "SELECT 3--1" }));
+    EXPECT_EQ(Split("SELECT '-- not a comment';"), Statements({ "SELECT '-- not a comment'" }));
+}
+
+TEST(SQLScriptTest, KeepsVersionComments)
+{
+    EXPECT_EQ(Split("/*!40101 SET NAMES utf8mb4 */;"), Statements({ "/*!40101 SET NAMES utf8mb4 */" }));
+}
+
+TEST(SQLScriptTest, HandlesDelimiterCommand)
+{
+    std::string const script =
+        "DROP PROCEDURE IF EXISTS `p`;\n"
+        "DELIMITER //\n"
+        "CREATE PROCEDURE `p`()\n"
+        "BEGIN\n"
+        "    SELECT 1;\n"
+        "END //\n"
+        "delimiter ;\n"
+        "CALL `p`();\n";
+
+    EXPECT_EQ(Split(script), Statements({
+        "DROP PROCEDURE IF EXISTS `p`",
+        "CREATE PROCEDURE `p`()\nBEGIN\n    SELECT 1;\nEND",
+        "CALL `p`()" }));
+}
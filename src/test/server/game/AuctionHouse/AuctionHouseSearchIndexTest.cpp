@@ -0,0 +1,219 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AuctionHouseSearcher.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <deque>
+#include <random>
+
+namespace
+{
+    constexpr uint32 AUCTIONS = 5000;
+    constexpr uint32 ITEM_TEMPLATES = 400;
+
+    std::wstring const NAME_WORDS[] =
+    {
+        L"bronze", L"iron", L"mithril", L"thorium", L"saronite", L"titanium", L"silk", L"runecloth", L"frostweave",
+        L"sword", L"mace", L"helm", L"boots", L"robe", L"potion", L"elixir", L"flask", L"gem", L"ring",
+        L"of the monkey", L"of the eagle", L"of the bear", L"of healing", L"of agility"
+    };
+
+    class AuctionHouseSearchIndexTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::mt19937 rng(4242);
+
+            // std::deque keeps the templates in place while growing
+            for (uint32 i = 0; i < ITEM_TEMPLATES; ++i)
+            {
+                ItemTemplate& proto = _templates.emplace_back();
+                proto.ItemId = i + 1;
+                proto.Class = ITEM_CLASS_CONSUMABLE + rng() % 16;
+                proto.SubClass = rng() % 12;
+                proto.InventoryType = rng() % 29;
+                proto.Quality = rng() % MAX_ITEM_QUALITY;
+                proto.RequiredLevel = rng() % 81;
+                proto.AllowableClass = rng() % 4 ? uint32(-1) : 1u << (rng() % 11);
+                proto.AllowableRace = rng() % 4 ? uint32(-1) : 1u << (rng() % 11);
+                proto.RequiredSkill = 0;
+                proto.RequiredSpell = 0;
+                proto.Spells[0].SpellId = 0;
+
+                // templates with the same name, like random suffix items
+                std::wstring name = NAME_WORDS[rng() % 9] + L" " + NAME_WORDS[9 + rng() % 10];
+                if (rng() % 3 == 0)
+                    name += L" " + NAME_WORDS[19 + rng() % 5];
+
+                _names.push_back(name);
+            }
+
+            for (uint32 id = 1; id <= AUCTIONS; ++id)
+                _index.AddAuction(MakeAuction(id, rng() % ITEM_TEMPLATES));
+        }
+
+        std::shared_ptr<SearchableAuctionEntry> MakeAuction(uint32 id, uint32 templateIndex)
+        {
+            std::shared_ptr<SearchableAuctionEntry> auctionEntry = std::make_shared<SearchableAuctionEntry>();
+            auctionEntry->Id = id;
+            auctionEntry->item.itemTemplate = &_templates[templateIndex];
+            auctionEntry->item.itemName[LOCALE_enUS] = _names[templateIndex];
+            return auctionEntry;
+        }
+
+        static AuctionHouseSearchInfo MakeSearch()
+        {
+            AuctionHouseSearchInfo searchInfo;
+            searchInfo.listfrom = 0;
+            searchInfo.levelmin = 0;
+            searchInfo.levelmax = 0;
+            searchInfo.usable = false;
+            searchInfo.inventoryType = 0xffffffff;
+            searchInfo.itemClass = 0xffffffff;
+            searchInfo.itemSubClass = 0xffffffff;
+            searchInfo.quality = 0xffffffff;
+            searchInfo.getAll = false;
+            return searchInfo;
+        }
+
+        static AuctionHousePlayerInfo MakePlayer()
+        {
+            AuctionHousePlayerInfo playerInfo;
+            playerInfo.loc_idx = LOCALE_enUS;
+            playerInfo.locdbc_idx = LOCALE_enUS;
+            return playerInfo;
+        }
+
+        std::vector<uint32> Search(AuctionHouseSearchInfo const& searchInfo, AuctionHousePlayerInfo const& playerInfo)
+        {
+            SortableAuctionEntriesList auctionEntries;
+            _index.Search(searchInfo, playerInfo, auctionEntries);
+            return GetIds(auctionEntries);
+        }
+
+        // The full scan the index replaces
+        std::vector<uint32> Scan(AuctionHouseSearchInfo const& searchInfo, AuctionHousePlayerInfo const& playerInfo) const
+        {
+            SortableAuctionEntriesList auctionEntries;
+            for (auto const& pair : _index.GetAuctions())
+                if (AuctionHouseSearchIndex::MatchesSearch(*pair.second, searchInfo, playerInfo))
+                    auctionEntries.push_back(pair.second.get());
+
+            return GetIds(auctionEntries);
+        }
+
+        static std::vector<uint32> GetIds(SortableAuctionEntriesList const& auctionEntries)
+        {
+            std::vector<uint32> ids;
+            for (SearchableAuctionEntry const* auctionEntry : auctionEntries)
+                ids.push_back(auctionEntry->Id);
+
+            std::sort(ids.begin(), ids.end());
+            return ids;
+        }
+
+        std::vector<AuctionHouseSearchInfo> MakeSearches() const
+        {
+            std::vector<AuctionHouseSearchInfo> searches;
+
+            AuctionHouseSearchInfo byName = MakeSearch();
+            byName.wsearchedname = L"mithril";
+            searches.push_back(byName);
+
+            AuctionHouseSearchInfo bySuffix = MakeSearch();
+            bySuffix.wsearchedname = L"of the eagle";
+            searches.push_back(bySuffix);
+
+            AuctionHouseSearchInfo byShortName = MakeSearch();
+            byShortName.wsearchedname = L"ro";
+            searches.push_back(byShortName);
+
+            AuctionHouseSearchInfo byClass = MakeSearch();
+            byClass.itemClass = ITEM_CLASS_WEAPON;
+            byClass.itemSubClass = 7;
+            byClass.quality = ITEM_QUALITY_RARE;
+            searches.push_back(byClass);
+
+            AuctionHouseSearchInfo byChest = MakeSearch();
+            byChest.inventoryType = INVTYPE_CHEST;
+            byChest.levelmin = 70;
+            byChest.levelmax = 80;
+            searches.push_back(byChest);
+
+            AuctionHouseSearchInfo byEverything = MakeSearch();
+            byEverything.wsearchedname = L"saronite";
+            byEverything.itemClass = ITEM_CLASS_ARMOR;
+            byEverything.quality = ITEM_QUALITY_UNCOMMON;
+            byEverything.levelmin = 20;
+            searches.push_back(byEverything);
+
+            AuctionHouseSearchInfo noMatch = MakeSearch();
+            noMatch.wsearchedname = L"frostmourne";
+            searches.push_back(noMatch);
+
+            return searches;
+        }
+
+        std::deque<ItemTemplate> _templates;
+        std::vector<std::wstring> _names;
+        AuctionHouseSearchIndex _index;
+    };
+}
+
+TEST_F(AuctionHouseSearchIndexTest, MatchesFullScan)
+{
+    for (AuctionHouseSearchInfo const& searchInfo : MakeSearches())
+        EXPECT_EQ(Search(searchInfo, MakePlayer()), Scan(searchInfo, MakePlayer()));
+}
+
+TEST_F(AuctionHouseSearchIndexTest, UsableByMatchesFullScan)
+{
+    AuctionHousePlayerInfo playerInfo = MakePlayer();
+    playerInfo.usablePlayerInfo.emplace();
+    playerInfo.usablePlayerInfo->classMask = 1 << (CLASS_MAGE - 1);
+    playerInfo.usablePlayerInfo->raceMask = 1 << (RACE_GNOME - 1);
+    playerInfo.usablePlayerInfo->level = 80;
+
+    AuctionHouseSearchInfo searchInfo = MakeSearch();
+    searchInfo.usable = true;
+    searchInfo.itemClass = ITEM_CLASS_CONSUMABLE;
+    EXPECT_EQ(Search(searchInfo, playerInfo), Scan(searchInfo, playerInfo));
+}
+
+TEST_F(AuctionHouseSearchIndexTest, RemovedAuctionsAreNotFound)
+{
+    AuctionHouseSearchInfo searchInfo = MakeSearch();
+    searchInfo.wsearchedname = L"thorium";
+
+    // index the names before removing, so the trigram lists are compacted too
+    std::vector<uint32> before = Search(searchInfo, MakePlayer());
+    ASSERT_FALSE(before.empty());
+
+    // expire the oldest two thirds, compacting most lists on the way
+    for (uint32 id = 1; id <= AUCTIONS * 2 / 3; ++id)
+        _index.RemoveAuction(id);
+
+    // re-add an auction removed in a list that was not compacted yet
+    _index.AddAuction(MakeAuction(before.front(), _templates.size() - 1));
+
+    for (AuctionHouseSearchInfo const& search : MakeSearches())
+        EXPECT_EQ(Search(search, MakePlayer()), Scan(search, MakePlayer()));
+
+    EXPECT_EQ(Search(searchInfo, MakePlayer()), Scan(searchInfo, MakePlayer()));
+}
@@ -0,0 +1,247 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ArenaMatchmakingIndex.h"
+#include "BattlegroundQueue.h"
+#include "gtest/gtest.h"
+#include <memory>
+#include <random>
+#include <unordered_set>
+
+namespace
+{
+    constexpr uint32 TEAMS = 600;
+    constexpr uint32 JOIN_PERIOD = 30 * MINUTE * IN_MILLISECONDS;
+    constexpr uint32 UPDATE_INTERVAL = IN_MILLISECONDS;
+
+    ArenaMatchmakingRules MakeRules(uint32 now)
+    {
+        ArenaMatchmakingRules rules;
+        rules.Now = now;
+        rules.MaxRatingDifference = 150;
+        rules.RatingDifferenceGrowth = 25;
+        rules.RatingDiscardTimer = 10 * MINUTE * IN_MILLISECONDS;
+        rules.PreviousOpponentsDiscardTimer = 2 * MINUTE * IN_MILLISECONDS;
+        return rules;
+    }
+
+    struct SimulationResult
+    {
+        std::vector<ArenaMatchmakingIndex::Match> Matches;
+        std::vector<uint32> MatchTimes;
+        uint32 Unmatched = 0;
+    };
+
+    // Oldest waiting team first, paired with the longest waiting team in its window like the queue list walk
+    std::vector<ArenaMatchmakingIndex::Match> FindFirstFitMatches(std::vector<GroupQueueInfo*> const& queued, ArenaMatchmakingRules const& rules)
+    {
+        std::vector<ArenaMatchmakingIndex::Match> matches;
+        std::unordered_set<GroupQueueInfo const*> matched;
+
+        for (std::size_t i = 0; i < queued.size(); ++i)
+        {
+            GroupQueueInfo* team = queued[i];
+            if (matched.contains(team))
+                continue;
+
+            uint32 const window = ArenaMatchmakingIndex::GetRatingWindow(team, rules);
+            bool const anyRating = ArenaMatchmakingIndex::IsRatingDiscarded(team, rules);
+
+            for (std::size_t j = i + 1; j < queued.size(); ++j)
+            {
+                GroupQueueInfo* opponent = queued[j];
+                uint32 const difference = std::max(team->ArenaMatchmakerRating, opponent->ArenaMatchmakerRating) - std::min(team->ArenaMatchmakerRating, opponent->ArenaMatchmakerRating);
+                if (matched.contains(opponent) || (difference > window && !anyRating) || !ArenaMatchmakingIndex::CanPlayAgainst(team, opponent, rules))
+                    continue;
+
+                matches.emplace_back(team, opponent);
+                matched.insert(team);
+                matched.insert(opponent);
+                break;
+            }
+        }
+
+        return matches;
+    }
+
+    class ArenaMatchmakingIndexTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::mt19937 rng(1337);
+            std::normal_distribution<float> rating(1800.0f, 350.0f);
+            std::uniform_int_distribution<uint32> joinTime(0, JOIN_PERIOD);
+
+            for (uint32 i = 0; i < TEAMS; ++i)
+            {
+                std::unique_ptr<GroupQueueInfo> team = std::make_unique<GroupQueueInfo>();
+                team->ArenaTeamId = i + 1;
+                team->ArenaMatchmakerRating = uint32(std::clamp(rating(rng), 0.0f, 3500.0f));
+                team->JoinTime = joinTime(rng);
+                team->IsInvitedToBGInstanceGUID = 0;
+                team->PreviousOpponentsTeamId = i > 0 && rng() % 4 == 0 ? i : 0;
+                _teams.push_back(std::move(team));
+            }
+
+            std::sort(_teams.begin(), _teams.end(), [](auto const& left, auto const& right) { return left->JoinTime < right->JoinTime; });
+        }
+
+        // Replays the joins and runs a queue update every interval until every rating window expired
+        SimulationResult Simulate(bool useIndex)
+        {
+            for (std::unique_ptr<GroupQueueInfo> const& team : _teams)
+                team->IsInvitedToBGInstanceGUID = 0;
+
+            SimulationResult result;
+            ArenaMatchmakingIndex index;
+            std::vector<GroupQueueInfo*> queued;
+            std::size_t nextJoin = 0;
+
+            uint32 const end = JOIN_PERIOD + MakeRules(0).RatingDiscardTimer + MINUTE * IN_MILLISECONDS;
+            for (uint32 now = 0; now <= end; now += UPDATE_INTERVAL)
+            {
+                for (; nextJoin < _teams.size() && _teams[nextJoin]->JoinTime <= now; ++nextJoin)
+                {
+                    index.AddTeam(_teams[nextJoin].get());
+                    queued.push_back(_teams[nextJoin].get());
+                }
+
+                std::vector<ArenaMatchmakingIndex::Match> matches = useIndex ? index.FindMatches(MakeRules(now)) : FindFirstFitMatches(queued, MakeRules(now));
+
+                for (ArenaMatchmakingIndex::Match const& match : matches)
+                {
+                    EXPECT_TRUE(ArenaMatchmakingIndex::CanPlayAgainst(match.first, match.second, MakeRules(now)));
+
+                    // the team that waited longer decides the rating window
+                    EXPECT_LE(match.first->JoinTime, match.second->JoinTime);
+                    if (!ArenaMatchmakingIndex::IsRatingDiscarded(match.first, MakeRules(now)))
+                        EXPECT_LE(GetDifference(match), ArenaMatchmakingIndex::GetRatingWindow(match.first, MakeRules(now)));
+
+                    for (GroupQueueInfo* team : { match.first, match.second })
+                    {
+                        team->IsInvitedToBGInstanceGUID = 1;
+                        index.RemoveTeam(team);
+                        queued.erase(std::find(queued.begin(), queued.end(), team));
+                    }
+
+                    result.Matches.push_back(match);
+                    result.MatchTimes.push_back(now);
+                }
+            }
+
+            result.Unmatched = queued.size();
+            return result;
+        }
+
+        static uint32 GetDifference(ArenaMatchmakingIndex::Match const& match)
+        {
+            return std::max(match.first->ArenaMatchmakerRating, match.second->ArenaMatchmakerRating) - std::min(match.first->ArenaMatchmakerRating, match.second->ArenaMatchmakerRating);
+        }
+
+        static double GetAverageDifference(SimulationResult const& result)
+        {
+            double sum = 0.0;
+            for (ArenaMatchmakingIndex::Match const& match : result.Matches)
+                sum += GetDifference(match);
+
+            return result.Matches.empty() ? 0.0 : sum / result.Matches.size();
+        }
+
+        std::vector<std::unique_ptr<GroupQueueInfo>> _teams;
+    };
+}
+
+TEST_F(ArenaMatchmakingIndexTest, AddAndRemove)
+{
+    ArenaMatchmakingIndex index;
+    index.AddTeam(_teams[0].get());
+    index.AddTeam(_teams[0].get());
+    index.AddTeam(_teams[1].get());
+    EXPECT_EQ(index.GetSize(), 2u);
+
+    index.RemoveTeam(_teams[0].get());
+    index.RemoveTeam(_teams[0].get());
+    EXPECT_EQ(index.GetSize(), 1u);
+
+    index.RemoveTeam(_teams[1].get());
+    EXPECT_TRUE(index.IsEmpty());
+}
+
+TEST_F(ArenaMatchmakingIndexTest, PairsClosestRating)
+{
+    GroupQueueInfo& oldest = *_teams[0];
+    GroupQueueInfo& close = *_teams[1];
+    GroupQueueInfo& far = *_teams[2];
+    oldest.ArenaMatchmakerRating = 2000;
+    far.ArenaMatchmakerRating = 2100;
+    close.ArenaMatchmakerRating = 1990;
+    oldest.PreviousOpponentsTeamId = close.PreviousOpponentsTeamId = far.PreviousOpponentsTeamId = 0;
+
+    ArenaMatchmakingIndex index;
+    index.AddTeam(&oldest);
+    index.AddTeam(&far);
+    index.AddTeam(&close);
+
+    std::vector<ArenaMatchmakingIndex::Match> matches = index.FindMatches(MakeRules(far.JoinTime));
+    ASSERT_EQ(matches.size(), 1u);
+    EXPECT_EQ(matches[0].first, &oldest);
+    EXPECT_EQ(matches[0].second, &close);
+}
+
+TEST_F(ArenaMatchmakingIndexTest, WindowGrowsWithWaitTime)
+{
+    GroupQueueInfo team = *_teams[0];
+    team.JoinTime = 0;
+
+    ArenaMatchmakingRules rules = MakeRules(0);
+    EXPECT_EQ(ArenaMatchmakingIndex::GetRatingWindow(&team, rules), rules.MaxRatingDifference);
+
+    rules.Now = 4 * MINUTE * IN_MILLISECONDS;
+    EXPECT_EQ(ArenaMatchmakingIndex::GetRatingWindow(&team, rules), rules.MaxRatingDifference + 4 * rules.RatingDifferenceGrowth);
+    EXPECT_FALSE(ArenaMatchmakingIndex::IsRatingDiscarded(&team, rules));
+
+    rules.Now = rules.RatingDiscardTimer + 1;
+    EXPECT_TRUE(ArenaMatchmakingIndex::IsRatingDiscarded(&team, rules));
+}
+
+TEST_F(ArenaMatchmakingIndexTest, SimulatedQueue)
+{
+    SimulationResult const indexed = Simulate(true);
+    SimulationResult const firstFit = Simulate(false);
+
+    // every team plays once, an odd one out may stay queued
+    std::unordered_set<GroupQueueInfo const*> played;
+    for (ArenaMatchmakingIndex::Match const& match : indexed.Matches)
+    {
+        EXPECT_TRUE(played.insert(match.first).second);
+        EXPECT_TRUE(played.insert(match.second).second);
+    }
+
+    EXPECT_LE(indexed.Unmatched, 1u);
+    EXPECT_EQ(played.size() + indexed.Unmatched, TEAMS);
+
+    // nobody waits much longer than the rating discard time while others are queued
+    uint32 longestWait = 0;
+    for (std::size_t i = 0; i < indexed.Matches.size(); ++i)
+        longestWait = std::max(longestWait, indexed.MatchTimes[i] - indexed.Matches[i].first->JoinTime);
+
+    EXPECT_LE(longestWait, MakeRules(0).RatingDiscardTimer + 2 * UPDATE_INTERVAL);
+
+    // pairing with the closest rating gives fairer games than the longest waiting team in the window
+    EXPECT_LE(GetAverageDifference(indexed), GetAverageDifference(firstFit));
+}
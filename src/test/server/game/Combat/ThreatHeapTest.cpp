@@ -0,0 +1,207 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreatHeap.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <list>
+#include <memory>
+#include <random>
+
+namespace
+{
+    // Stand in for HostileReference, with the target checks of SelectNextVictim as flags
+    struct TestReference
+    {
+        float Threat = 0.0f;
+        bool SecondChoice = false;
+        bool CanAttack = true;
+        bool InMeleeRange = true;
+
+        uint32 iHeapIndex = 0;
+        uint32 iSequence = 0;
+
+        [[nodiscard]] float GetThreat() const { return Threat; }
+    };
+
+    // ThreatContainer::SelectNextVictim before the threat heap: the list is stable sorted by threat
+    // from insertion order, then walked from the highest threat and again if all targets were second choice
+    TestReference* SelectFromSortedList(std::list<TestReference*> threatList, TestReference* currentVictim)
+    {
+        threatList.sort([](TestReference const* a, TestReference const* b) { return a->GetThreat() > b->GetThreat(); });
+
+        TestReference* currentRef = nullptr;
+        bool found = false;
+        bool noPriorityTargetFound = false;
+
+        std::list<TestReference*>::const_iterator lastRef = threatList.end();
+        --lastRef;
+
+        for (std::list<TestReference*>::const_iterator iter = threatList.begin(); iter != threatList.end() && !found;)
+        {
+            currentRef = (*iter);
+
+            if (!noPriorityTargetFound && currentRef->SecondChoice)
+            {
+                if (iter != lastRef)
+                {
+                    ++iter;
+                    continue;
+                }
+                else
+                {
+                    noPriorityTargetFound = true;
+                    iter = threatList.begin();
+                    continue;
+                }
+            }
+
+            if (currentRef->CanAttack)
+            {
+                if (currentVictim)
+                {
+                    if (currentVictim == currentRef)
+                    {
+                        found = true;
+                        break;
+                    }
+
+                    if (currentRef->GetThreat() > 1.3f * currentVictim->GetThreat())
+                    {
+                        found = true;
+                        break;
+                    }
+                    else if (currentRef->GetThreat() > 1.1f * currentVictim->GetThreat())
+                    {
+                        if (currentRef->InMeleeRange)
+                        {
+                            found = true;
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        currentRef = currentVictim;
+                        found = true;
+                        break;
+                    }
+                }
+                else
+                {
+                    found = true;
+                    break;
+                }
+            }
+            ++iter;
+        }
+
+        return found ? currentRef : nullptr;
+    }
+
+    class ThreatHeapTest : public ::testing::Test
+    {
+    protected:
+        void AddReferences(uint32 count)
+        {
+            for (uint32 i = 0; i < count; ++i)
+            {
+                _references.push_back(std::make_unique<TestReference>());
+                TestReference* ref = _references.back().get();
+                ref->Threat = RandomThreat();
+                _heap.insert(ref);
+                _insertionOrder.push_back(ref);
+            }
+        }
+
+        // few distinct values, so equal threat is common
+        float RandomThreat() { return float(std::uniform_int_distribution<uint32>(0, 12)(_rng)) * 50.0f; }
+
+        std::vector<TestReference*> GetHeapOrder() const
+        {
+            std::vector<TestReference*> order;
+            _heap.visitInThreatOrder([&order](TestReference* ref, bool /*isLast*/) { order.push_back(ref); return false; });
+            return order;
+        }
+
+        std::mt19937 _rng{ 42 };
+        std::vector<std::unique_ptr<TestReference>> _references;
+        std::list<TestReference*> _insertionOrder;
+        ThreatHeap<TestReference> _heap;
+    };
+}
+
+TEST_F(ThreatHeapTest, VisitsInStableThreatOrder)
+{
+    AddReferences(40);
+
+    for (uint32 step = 0; step < 500; ++step)
+    {
+        TestReference* ref = _references[std::uniform_int_distribution<std::size_t>(0, _references.size() - 1)(_rng)].get();
+        if (step % 7 == 0 && _heap.contains(ref))
+        {
+            _heap.remove(ref);
+            _insertionOrder.remove(ref);
+        }
+        else if (!_heap.contains(ref))
+        {
+            // added again at the end, like a reference coming back online
+            ref->Threat = RandomThreat();
+            _heap.insert(ref);
+            _insertionOrder.push_back(ref);
+        }
+        else
+        {
+            ref->Threat = RandomThreat();
+            _heap.update(ref);
+        }
+
+        std::vector<TestReference*> expected(_insertionOrder.begin(), _insertionOrder.end());
+        std::stable_sort(expected.begin(), expected.end(), [](TestReference const* a, TestReference const* b) { return a->GetThreat() > b->GetThreat(); });
+
+        ASSERT_EQ(GetHeapOrder(), expected) << "step " << step;
+        ASSERT_EQ(_heap.front(), expected.empty() ? nullptr : expected.front());
+    }
+}
+
+TEST_F(ThreatHeapTest, SelectsSameVictimAsSortedList)
+{
+    for (uint32 round = 0; round < 2000; ++round)
+    {
+        _references.clear();
+        _insertionOrder.clear();
+        _heap.clear();
+        AddReferences(std::uniform_int_distribution<uint32>(1, 12)(_rng));
+
+        for (auto const& ref : _references)
+        {
+            ref->SecondChoice = std::bernoulli_distribution(0.3)(_rng);
+            ref->CanAttack = std::bernoulli_distribution(0.8)(_rng);
+            ref->InMeleeRange = std::bernoulli_distribution(0.5)(_rng);
+        }
+
+        TestReference* currentVictim = nullptr;
+        if (std::bernoulli_distribution(0.7)(_rng))
+            currentVictim = _references[std::uniform_int_distribution<std::size_t>(0, _references.size() - 1)(_rng)].get();
+
+        TestReference* selected = _heap.selectVictim(currentVictim,
+            [](TestReference* ref) { return ref->SecondChoice; },
+            [](TestReference* ref) { return ref->CanAttack; },
+            [](TestReference* ref) { return ref->InMeleeRange; });
+
+        EXPECT_EQ(selected, SelectFromSortedList(_insertionOrder, currentVictim)) << "round " << round;
+    }
+}
@@ -0,0 +1,166 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ConditionMgr.h"
+#include "ConditionProgram.h"
+#include "Object.h"
+#include "gtest/gtest.h"
+#include <map>
+#include <memory>
+#include <random>
+
+namespace
+{
+    constexpr uint32 REFERENCE_TEMPLATES = 3;
+    constexpr uint32 MISSING_REFERENCE_ID = 0xFFFFFF;
+
+    // Source of the checks, a zone condition passes when its zone is the (unset) zone of the object
+    class ConditionTarget : public WorldObject
+    {
+    public:
+        ConditionTarget() : WorldObject(false) { }
+    };
+
+    class ConditionProgramTest : public ::testing::Test
+    {
+    protected:
+        // Conditions of reference templates belong to the condition manager, the others to the test
+        Condition* MakeCondition(uint32 elseGroup, uint32 referenceId = 0, bool loaded = true, bool owned = true)
+        {
+            Condition* condition = new Condition();
+            if (owned)
+                _storage.emplace_back(condition);
+
+            condition->ElseGroup = elseGroup;
+            condition->ReferenceId = referenceId;
+            condition->ConditionType = loaded && !referenceId ? CONDITION_ZONEID : CONDITION_NONE;
+            _conditions.push_back(condition);
+            return condition;
+        }
+
+        ConditionList MakeList(std::mt19937& rng, uint32 firstReferenceId, uint32 lastReferenceId, bool owned = true)
+        {
+            ConditionList conditions;
+            uint32 const size = std::uniform_int_distribution<uint32>(1, 8)(rng);
+            for (uint32 i = 0; i < size; ++i)
+            {
+                uint32 const elseGroup = std::uniform_int_distribution<uint32>(0, 3)(rng);
+                uint32 const kind = std::uniform_int_distribution<uint32>(0, 9)(rng);
+                if (kind == 0)
+                    conditions.push_back(MakeCondition(elseGroup, 0, false, owned));
+                else if (kind == 1 && firstReferenceId < lastReferenceId)
+                    conditions.push_back(MakeCondition(elseGroup, std::uniform_int_distribution<uint32>(firstReferenceId, lastReferenceId - 1)(rng), true, owned));
+                else if (kind == 2)
+                    conditions.push_back(MakeCondition(elseGroup, MISSING_REFERENCE_ID, true, owned));
+                else
+                    conditions.push_back(MakeCondition(elseGroup, 0, true, owned));
+            }
+
+            return conditions;
+        }
+
+        bool Resolve(uint32 referenceId, ConditionProgram const*& program)
+        {
+            program = nullptr;
+            auto itr = _referencePrograms.find(referenceId);
+            if (itr != _referencePrograms.end())
+                program = &itr->second;
+
+            return true;
+        }
+
+        ConditionTarget _target;
+        std::vector<Condition*> _conditions;
+        std::vector<std::unique_ptr<Condition>> _storage;
+        std::map<uint32, ConditionProgram> _referencePrograms;
+    };
+}
+
+TEST_F(ConditionProgramTest, MatchesConditionMgr)
+{
+    std::mt19937 rng(1234);
+    ConditionSourceInfo sourceInfo(&_target);
+
+    for (uint32 iteration = 0; iteration < 500; ++iteration)
+    {
+        _referencePrograms.clear();
+        _conditions.clear();
+        _storage.clear();
+
+        // every iteration adds new reference templates to the condition manager,
+        // they only point at lower ids of the same iteration, like a cycle free database
+        uint32 const firstReferenceId = 1 + iteration * REFERENCE_TEMPLATES;
+        for (uint32 referenceId = firstReferenceId; referenceId < firstReferenceId + REFERENCE_TEMPLATES; ++referenceId)
+        {
+            ConditionList const conditions = MakeList(rng, firstReferenceId, referenceId, false);
+            for (Condition* condition : conditions)
+                sConditionMgr->AddToReferenceTemplate(referenceId, condition);
+
+            ASSERT_TRUE(_referencePrograms[referenceId].Compile(conditions, [this](uint32 id, ConditionProgram const*& program) { return Resolve(id, program); }));
+        }
+
+        // not compiled by the condition manager, so it interprets the list
+        ConditionList conditions = MakeList(rng, firstReferenceId, firstReferenceId + REFERENCE_TEMPLATES);
+        ConditionProgram program;
+        ASSERT_TRUE(program.Compile(conditions, [this](uint32 id, ConditionProgram const*& program) { return Resolve(id, program); }));
+        EXPECT_TRUE(program.IsCompiledFrom(conditions));
+
+        for (uint32 round = 0; round < 8; ++round)
+        {
+            for (Condition* condition : _conditions)
+                condition->ConditionValue1 = std::bernoulli_distribution(0.6)(rng) ? 0 : 1;
+
+            bool const compiled = program.Evaluate([&sourceInfo](Condition* condition) { return condition->Meets(sourceInfo); });
+            EXPECT_EQ(compiled, sConditionMgr->IsObjectMeetToConditions(sourceInfo, conditions)) << "iteration " << iteration << " round " << round;
+        }
+    }
+}
+
+TEST_F(ConditionProgramTest, RejectsOtherLists)
+{
+    std::mt19937 rng(42);
+    ConditionList conditions = MakeList(rng, 0, 0);
+
+    ConditionProgram program;
+    ASSERT_TRUE(program.Compile(conditions, [this](uint32 id, ConditionProgram const*& program) { return Resolve(id, program); }));
+
+    ConditionList longer = conditions;
+    longer.push_back(MakeCondition(0));
+    EXPECT_FALSE(program.IsCompiledFrom(longer));
+
+    ConditionList reordered = conditions;
+    reordered.push_front(MakeCondition(0));
+    reordered.pop_back();
+    EXPECT_FALSE(program.IsCompiledFrom(reordered));
+}
+
+TEST_F(ConditionProgramTest, UnloadedConditionsFail)
+{
+    ConditionList conditions = { MakeCondition(0, 0, false), MakeCondition(1, 0, false) };
+
+    ConditionProgram program;
+    ASSERT_TRUE(program.Compile(conditions, [this](uint32 id, ConditionProgram const*& program) { return Resolve(id, program); }));
+    EXPECT_FALSE(program.Evaluate([](Condition*) { return true; }));
+}
+
+TEST_F(ConditionProgramTest, UnresolvableReferenceIsNotCompiled)
+{
+    ConditionList conditions = { MakeCondition(0), MakeCondition(0, 7) };
+
+    ConditionProgram program;
+    EXPECT_FALSE(program.Compile(conditions, [](uint32, ConditionProgram const*& program) { program = nullptr; return false; }));
+}
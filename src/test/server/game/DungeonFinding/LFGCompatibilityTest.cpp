@@ -0,0 +1,279 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Group.h"
+#include "LFGCompatibility.h"
+#include "LFGMgr.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+
+using namespace lfg;
+
+namespace
+{
+    constexpr uint32 PLAYERS = 600;
+    constexpr uint32 JOIN_TICKS = 120;
+    constexpr uint32 DUNGEONS = 40;
+    constexpr uint32 DUNGEONS_PER_BAND = 10;
+    constexpr uint32 MAX_NEW_COMPATIBLES = 16;                 // like the role combination limit of LFGQueue::FindNewGroups
+
+    struct QueuedPlayer
+    {
+        LfgDungeonSet dungeons;
+        LfgRolesMap roles;
+        LfgCompatibilityData compatibility;
+        uint32 joinTick = 0;
+        bool grouped = false;
+    };
+
+    struct SimulationResult
+    {
+        std::vector<std::vector<uint32>> groups;
+        double averageWait = 0.0;
+        uint64 checks = 0;
+    };
+
+    class LFGCompatibilityTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            std::mt19937 rng(2024);
+            std::uniform_int_distribution<uint32> joinTick(0, JOIN_TICKS - 1);
+
+            for (uint32 i = 0; i < PLAYERS; ++i)
+            {
+                QueuedPlayer& player = _players.emplace_back();
+
+                // mostly damage dealers, some hybrids
+                uint8 roles;
+                switch (rng() % 20)
+                {
+                    case 0: case 1: roles = PLAYER_ROLE_TANK; break;
+                    case 2: case 3: case 4: roles = PLAYER_ROLE_HEALER; break;
+                    case 5: roles = PLAYER_ROLE_TANK | PLAYER_ROLE_DAMAGE; break;
+                    case 6: roles = PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE; break;
+                    case 7: roles = PLAYER_ROLE_TANK | PLAYER_ROLE_HEALER | PLAYER_ROLE_DAMAGE; break;
+                    default: roles = PLAYER_ROLE_DAMAGE; break;
+                }
+
+                player.roles[ObjectGuid::Create<HighGuid::Player>(i + 1)] = roles | (rng() % 2 ? PLAYER_ROLE_LEADER : 0);
+
+                // a random dungeon expands to the dungeons of a level band, others pick a few of them
+                uint32 const band = rng() % (DUNGEONS / DUNGEONS_PER_BAND) * DUNGEONS_PER_BAND;
+                if (rng() % 4)
+                {
+                    for (uint32 dungeonId = band; dungeonId < band + DUNGEONS_PER_BAND; ++dungeonId)
+                        player.dungeons.insert(dungeonId + 1);
+                }
+                else
+                    for (uint32 count = 1 + rng() % 3; count; --count)
+                        player.dungeons.insert(band + 1 + rng() % DUNGEONS_PER_BAND);
+
+                player.compatibility = LfgCompatibilityData(player.dungeons, player.roles);
+                player.joinTick = joinTick(rng);
+            }
+        }
+
+        // Role and dungeon checks of LFGQueue::CheckCompatibility before the packed pre-check
+        bool CheckContainers(std::vector<uint32> const& members) const
+        {
+            LfgRolesMap roles;
+            LfgDungeonSet dungeons = _players[members.front()].dungeons;
+            for (uint32 member : members)
+            {
+                roles.insert(_players[member].roles.begin(), _players[member].roles.end());
+
+                LfgDungeonSet common;
+                std::set_intersection(dungeons.begin(), dungeons.end(), _players[member].dungeons.begin(), _players[member].dungeons.end(), std::inserter(common, common.begin()));
+                dungeons = common;
+            }
+
+            return LFGMgr::CheckGroupRoles(roles) && !dungeons.empty();
+        }
+
+        bool CheckPacked(std::vector<uint32> const& members) const
+        {
+            LfgCompatibilityData compatibility;
+            for (uint32 member : members)
+                compatibility.Add(_players[member].compatibility);
+
+            if (!compatibility.CanFillRoles() || !compatibility.MayHaveCommonDungeon())
+                return false;
+
+            return CheckContainers(members);
+        }
+
+        // Replays the joins; each tick checks up to newPerTick newcomers against the compatibles like LFGQueue::FindNewGroups
+        SimulationResult Simulate(bool packed, uint32 newPerTick)
+        {
+            for (QueuedPlayer& player : _players)
+                player.grouped = false;
+
+            std::vector<uint32> order(PLAYERS);
+            for (uint32 i = 0; i < PLAYERS; ++i)
+                order[i] = i;
+
+            std::stable_sort(order.begin(), order.end(), [&](uint32 left, uint32 right) { return _players[left].joinTick < _players[right].joinTick; });
+
+            SimulationResult result;
+            std::vector<std::vector<uint32>> compatibles;
+            std::vector<uint32> newcomers;
+            std::size_t nextJoin = 0;
+            uint64 totalWait = 0;
+
+            for (uint32 tick = 0; nextJoin < order.size() || !newcomers.empty(); ++tick)
+            {
+                for (; nextJoin < order.size() && _players[order[nextJoin]].joinTick <= tick; ++nextJoin)
+                    newcomers.push_back(order[nextJoin]);
+
+                uint32 handled = 0;
+                for (; handled < newcomers.size() && handled < newPerTick; ++handled)
+                {
+                    uint32 const newcomer = newcomers[handled];
+                    if (_players[newcomer].grouped)
+                        continue;
+
+                    std::vector<std::vector<uint32>> found;
+                    bool matched = false;
+
+                    for (std::vector<uint32> const& compatible : compatibles)
+                    {
+                        if (std::any_of(compatible.begin(), compatible.end(), [&](uint32 member) { return _players[member].grouped; }))
+                            continue;
+
+                        std::vector<uint32> members = compatible;
+                        members.push_back(newcomer);
+                        ++result.checks;
+                        if (!(packed ? CheckPacked(members) : CheckContainers(members)))
+                            continue;
+
+                        if (members.size() == MAXGROUPSIZE)
+                        {
+                            for (uint32 member : members)
+                            {
+                                _players[member].grouped = true;
+                                totalWait += tick - _players[member].joinTick;
+                            }
+
+                            result.groups.push_back(members);
+                            matched = true;
+                            break;
+                        }
+
+                        found.push_back(members);
+                    }
+
+                    if (!matched)
+                    {
+                        // keep the combinations closest to a full group
+                        std::stable_sort(found.begin(), found.end(), [](auto const& left, auto const& right) { return left.size() > right.size(); });
+                        found.resize(std::min<std::size_t>(found.size(), MAX_NEW_COMPATIBLES));
+                        compatibles.push_back({ newcomer });
+                        compatibles.insert(compatibles.end(), found.begin(), found.end());
+                    }
+                }
+
+                newcomers.erase(newcomers.begin(), newcomers.begin() + handled);
+                std::erase_if(compatibles, [&](std::vector<uint32> const& compatible)
+                {
+                    return std::any_of(compatible.begin(), compatible.end(), [&](uint32 member) { return _players[member].grouped; });
+                });
+            }
+
+            result.averageWait = result.groups.empty() ? 0.0 : double(totalWait) / (result.groups.size() * MAXGROUPSIZE);
+            return result;
+        }
+
+        std::vector<QueuedPlayer> _players;
+    };
+}
+
+TEST_F(LFGCompatibilityTest, RolesMatchCheckGroupRoles)
+{
+    // every group of up to 5 players with any role combination, the first one leads
+    for (uint32 size = 1; size <= MAXGROUPSIZE; ++size)
+    {
+        uint32 combinations = 1;
+        for (uint32 i = 0; i < size; ++i)
+            combinations *= 8;
+
+        for (uint32 combination = 0; combination < combinations; ++combination)
+        {
+            LfgRolesMap roles;
+            for (uint32 i = 0, value = combination; i < size; ++i, value /= 8)
+                roles[ObjectGuid::Create<HighGuid::Player>(i + 1)] = uint8((value % 8) << 1) | (i ? 0 : PLAYER_ROLE_LEADER);
+
+            LfgCompatibilityData compatibility(LfgDungeonSet{ 1 }, roles);
+            EXPECT_EQ(compatibility.GetPlayers(), size);
+            EXPECT_EQ(compatibility.CanFillRoles(), LFGMgr::CheckGroupRoles(roles) != 0);
+        }
+    }
+}
+
+TEST_F(LFGCompatibilityTest, CombinedGroups)
+{
+    LfgRolesMap tanks = { { ObjectGuid::Create<HighGuid::Player>(1), PLAYER_ROLE_TANK } };
+    LfgRolesMap healers = { { ObjectGuid::Create<HighGuid::Player>(2), PLAYER_ROLE_HEALER | PLAYER_ROLE_LEADER } };
+    LfgRolesMap party =
+    {
+        { ObjectGuid::Create<HighGuid::Player>(3), PLAYER_ROLE_DAMAGE },
+        { ObjectGuid::Create<HighGuid::Player>(4), PLAYER_ROLE_DAMAGE | PLAYER_ROLE_TANK },
+        { ObjectGuid::Create<HighGuid::Player>(5), PLAYER_ROLE_DAMAGE }
+    };
+
+    LfgCompatibilityData compatibility;
+    compatibility.Add(LfgCompatibilityData(LfgDungeonSet{ 1, 2 }, tanks));
+    compatibility.Add(LfgCompatibilityData(LfgDungeonSet{ 2, 3 }, healers));
+    compatibility.Add(LfgCompatibilityData(LfgDungeonSet{ 2 }, party));
+    EXPECT_EQ(compatibility.GetPlayers(), MAXGROUPSIZE);
+    EXPECT_TRUE(compatibility.CanFillRoles());
+    EXPECT_TRUE(compatibility.MayHaveCommonDungeon());
+
+    // a second tank only fits if the hybrid plays damage
+    LfgCompatibilityData twoTanks;
+    twoTanks.Add(LfgCompatibilityData(LfgDungeonSet{ 2 }, tanks));
+    twoTanks.Add(LfgCompatibilityData(LfgDungeonSet{ 2 }, party));
+    EXPECT_TRUE(twoTanks.CanFillRoles());
+    twoTanks.Add(LfgCompatibilityData(LfgDungeonSet{ 2 }, { { ObjectGuid::Create<HighGuid::Player>(6), PLAYER_ROLE_DAMAGE } }));
+    EXPECT_FALSE(twoTanks.CanFillRoles());
+
+    LfgCompatibilityData disjoint;
+    disjoint.Add(LfgCompatibilityData(LfgDungeonSet{ 1, 2 }, tanks));
+    disjoint.Add(LfgCompatibilityData(LfgDungeonSet{ 3 }, healers));
+    EXPECT_FALSE(disjoint.MayHaveCommonDungeon());
+
+    // ids past the mask cannot be ruled out
+    disjoint.Add(LfgCompatibilityData(LfgDungeonSet{ LFG_DUNGEON_MASK_SIZE + 1 }, party));
+    EXPECT_TRUE(disjoint.MayHaveCommonDungeon());
+}
+
+TEST_F(LFGCompatibilityTest, SimulatedQueue)
+{
+    SimulationResult const packed = Simulate(true, PLAYERS);
+    SimulationResult const containers = Simulate(false, PLAYERS);
+    SimulationResult const onePerTick = Simulate(true, 1);
+
+    // the pre-check only skips work, the same groups form
+    EXPECT_EQ(packed.groups, containers.groups);
+    EXPECT_EQ(packed.checks, containers.checks);
+    EXPECT_GT(packed.groups.size(), PLAYERS / MAXGROUPSIZE / 2);
+
+    // newcomers no longer wait for the ones queued before them
+    EXPECT_LT(packed.averageWait, onePerTick.averageWait);
+}
@@ -0,0 +1,263 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MapSpatialIndex.h"
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <random>
+
+namespace
+{
+    constexpr uint32 OBJECTS = 20000;
+    constexpr float AREA_SIZE = 1500.0f;
+    constexpr uint32 QUERIES = 2000;
+
+    // The index never dereferences objects, so they are represented by their number
+    struct FakeObject
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Radius = 0.0f;
+        uint32 Flags = 0;
+        bool Indexed = false;
+        SpatialIndexSlot Slot;
+    };
+
+    bool Matches(FakeObject const& object, uint32 typeMask, uint32 containers)
+    {
+        return object.Indexed && (object.Flags & typeMask) && (object.Flags & containers);
+    }
+
+    bool InCircle(FakeObject const& object, float x, float y, float radius)
+    {
+        float const dx = object.X - x;
+        float const dy = object.Y - y;
+        return dx * dx + dy * dy <= (radius + object.Radius) * (radius + object.Radius);
+    }
+
+    // an object is in the cone if it is in range and the arc touches its circle
+    bool InCone(FakeObject const& object, float x, float y, float radius, float orientation, float arc, float tolerance)
+    {
+        if (!InCircle(object, x, y, radius))
+            return false;
+
+        float const dist = std::hypot(object.X - x, object.Y - y);
+        if (dist <= object.Radius)
+            return true;
+
+        float difference = std::fmod(std::fabs(std::atan2(object.Y - y, object.X - x) - orientation), 2.0f * float(M_PI));
+        if (difference > float(M_PI))
+            difference = 2.0f * float(M_PI) - difference;
+
+        return difference <= arc / 2.0f + std::asin(object.Radius / dist) + tolerance;
+    }
+
+    class MapSpatialIndexTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            _rng.seed(2024);
+            _objects.resize(OBJECTS);
+
+            for (uint32 i = 0; i < OBJECTS; ++i)
+            {
+                FakeObject& object = _objects[i];
+                RandomPosition(object);
+
+                // a few objects are as large as buildings
+                object.Radius = i % 500 ? std::uniform_real_distribution<float>(0.3f, 5.0f)(_rng) : 40.0f;
+
+                // mostly creatures, like a populated continent
+                uint32 const type = _rng() % 20;
+                object.Flags = type < 14 ? GRID_MAP_TYPE_MASK_CREATURE : type < 17 ? GRID_MAP_TYPE_MASK_GAMEOBJECT : type < 19 ? GRID_MAP_TYPE_MASK_PLAYER : GRID_MAP_TYPE_MASK_DYNAMICOBJECT;
+                object.Flags |= (object.Flags == GRID_MAP_TYPE_MASK_PLAYER || _rng() % 10 == 0) ? SPATIAL_INDEX_WORLD_OBJECTS : SPATIAL_INDEX_GRID_OBJECTS;
+
+                _index.Insert(ToWorldObject(i), object.Slot, object.X, object.Y, object.Radius, object.Flags);
+                object.Indexed = true;
+            }
+        }
+
+        void RandomPosition(FakeObject& object)
+        {
+            std::uniform_real_distribution<float> position(-AREA_SIZE / 2.0f, AREA_SIZE / 2.0f);
+            object.X = position(_rng);
+            object.Y = position(_rng);
+        }
+
+        static WorldObject* ToWorldObject(uint32 i) { return reinterpret_cast<WorldObject*>(uintptr_t(i + 1) * 8); }
+        static uint32 ToIndex(WorldObject* object) { return uint32(reinterpret_cast<uintptr_t>(object) / 8 - 1); }
+
+        // Walks, teleports and despawns some objects
+        void Shuffle()
+        {
+            std::normal_distribution<float> step(0.0f, 4.0f);
+            for (uint32 i = 0; i < OBJECTS; ++i)
+            {
+                FakeObject& object = _objects[i];
+                uint32 const action = _rng() % 100;
+                if (!object.Indexed)
+                {
+                    if (action < 20)
+                    {
+                        RandomPosition(object);
+                        _index.Insert(ToWorldObject(i), object.Slot, object.X, object.Y, object.Radius, object.Flags);
+                        object.Indexed = true;
+                    }
+
+                    continue;
+                }
+
+                if (action < 50)
+                {
+                    object.X += step(_rng);
+                    object.Y += step(_rng);
+                    _index.Move(object.Slot, object.X, object.Y, object.Radius);
+                }
+                else if (action < 52)
+                {
+                    RandomPosition(object);
+                    _index.Move(object.Slot, object.X, object.Y, object.Radius);
+                }
+                else if (action < 55)
+                {
+                    MapSpatialIndex::Remove(object.Slot);
+                    object.Indexed = false;
+                }
+            }
+        }
+
+        template<class Predicate>
+        std::vector<uint32> BruteForce(uint32 typeMask, uint32 containers, Predicate&& predicate) const
+        {
+            std::vector<uint32> result;
+            for (uint32 i = 0; i < OBJECTS; ++i)
+                if (Matches(_objects[i], typeMask, containers) && predicate(_objects[i]))
+                    result.push_back(i);
+
+            return result;
+        }
+
+        std::vector<uint32> Collect(auto&& query) const
+        {
+            std::vector<uint32> result;
+            query([&](WorldObject* object) { result.push_back(ToIndex(object)); });
+            std::sort(result.begin(), result.end());
+            return result;
+        }
+
+        std::mt19937 _rng;
+        std::vector<FakeObject> _objects;
+        MapSpatialIndex _index;
+    };
+}
+
+TEST(MapSpatialIndexBasicTest, InsertMoveRemove)
+{
+    MapSpatialIndex index;
+    SpatialIndexSlot first;
+    SpatialIndexSlot second;
+    WorldObject* firstObject = reinterpret_cast<WorldObject*>(uintptr_t(8));
+    WorldObject* secondObject = reinterpret_cast<WorldObject*>(uintptr_t(16));
+
+    index.Insert(firstObject, first, 100.0f, 100.0f, 1.0f, GRID_MAP_TYPE_MASK_CREATURE | SPATIAL_INDEX_GRID_OBJECTS);
+    index.Insert(secondObject, second, 101.0f, 100.0f, 1.0f, GRID_MAP_TYPE_MASK_PLAYER | SPATIAL_INDEX_WORLD_OBJECTS);
+    EXPECT_EQ(index.GetSize(), 2u);
+    EXPECT_EQ(first.Index, &index);
+
+    std::vector<WorldObject*> found;
+    index.VisitCircle(100.0f, 100.0f, 5.0f, GRID_MAP_TYPE_MASK_PLAYER, SPATIAL_INDEX_ALL_OBJECTS, [&](WorldObject* object) { found.push_back(object); });
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0], secondObject);
+
+    // grid objects only
+    found.clear();
+    index.VisitCircle(100.0f, 100.0f, 5.0f, GRID_MAP_TYPE_MASK_ALL, SPATIAL_INDEX_GRID_OBJECTS, [&](WorldObject* object) { found.push_back(object); });
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0], firstObject);
+
+    // into another node and out of range
+    index.Move(first, 500.0f, -300.0f, 1.0f);
+    found.clear();
+    index.VisitCircle(100.0f, 100.0f, 5.0f, GRID_MAP_TYPE_MASK_ALL, SPATIAL_INDEX_ALL_OBJECTS, [&](WorldObject* object) { found.push_back(object); });
+    EXPECT_EQ(found.size(), 1u);
+    EXPECT_EQ(index.GetNodeCount(), 2u);
+
+    MapSpatialIndex::Remove(first);
+    MapSpatialIndex::Remove(first);
+    EXPECT_EQ(first.Index, nullptr);
+    EXPECT_EQ(index.GetSize(), 1u);
+    EXPECT_EQ(index.GetNodeCount(), 1u);
+
+    MapSpatialIndex::Remove(second);
+    EXPECT_EQ(index.GetSize(), 0u);
+    EXPECT_EQ(index.GetNodeCount(), 0u);
+}
+
+TEST(MapSpatialIndexBasicTest, DestroyedIndexReleasesSlots)
+{
+    SpatialIndexSlot slot;
+    {
+        MapSpatialIndex index;
+        index.Insert(reinterpret_cast<WorldObject*>(uintptr_t(8)), slot, 0.0f, 0.0f, 1.0f, GRID_MAP_TYPE_MASK_CREATURE | SPATIAL_INDEX_GRID_OBJECTS);
+    }
+
+    EXPECT_EQ(slot.Index, nullptr);
+    MapSpatialIndex::Remove(slot);
+}
+
+TEST_F(MapSpatialIndexTest, QueriesMatchBruteForce)
+{
+    std::uniform_real_distribution<float> position(-AREA_SIZE / 2.0f, AREA_SIZE / 2.0f);
+    std::uniform_real_distribution<float> range(0.0f, 100.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 2.0f * float(M_PI));
+    uint32 const typeMasks[] = { GRID_MAP_TYPE_MASK_ALL, GRID_MAP_TYPE_MASK_PLAYER, GRID_MAP_TYPE_MASK_CREATURE | GRID_MAP_TYPE_MASK_PLAYER, GRID_MAP_TYPE_MASK_GAMEOBJECT };
+    uint32 const containers[] = { SPATIAL_INDEX_ALL_OBJECTS, SPATIAL_INDEX_GRID_OBJECTS, SPATIAL_INDEX_WORLD_OBJECTS };
+
+    for (uint32 round = 0; round < 5; ++round)
+    {
+        for (uint32 i = 0; i < QUERIES / 5; ++i)
+        {
+            float const x = position(_rng);
+            float const y = position(_rng);
+            float const radius = range(_rng);
+            uint32 const typeMask = typeMasks[_rng() % std::size(typeMasks)];
+            uint32 const container = containers[_rng() % std::size(containers)];
+
+            std::vector<uint32> circle = Collect([&](auto&& worker) { _index.VisitCircle(x, y, radius, typeMask, container, worker); });
+            EXPECT_EQ(circle, BruteForce(typeMask, container, [&](FakeObject const& object) { return InCircle(object, x, y, radius); }));
+
+            float const width = range(_rng);
+            std::vector<uint32> box = Collect([&](auto&& worker) { _index.VisitBox(x, y, x + width, y + radius, typeMask, container, worker); });
+            EXPECT_EQ(box, BruteForce(typeMask, container, [&](FakeObject const& object)
+            {
+                return object.X + object.Radius >= x && object.X - object.Radius <= x + width && object.Y + object.Radius >= y && object.Y - object.Radius <= y + radius;
+            }));
+
+            // the angle is computed differently, so objects right on the edge of the arc may go either way
+            float const orientation = angle(_rng);
+            float const arc = angle(_rng) / 2.0f;
+            std::vector<uint32> cone = Collect([&](auto&& worker) { _index.VisitCone(x, y, radius, orientation, arc, typeMask, container, worker); });
+            std::vector<uint32> const inside = BruteForce(typeMask, container, [&](FakeObject const& object) { return InCone(object, x, y, radius, orientation, arc, -0.0001f); });
+            std::vector<uint32> const touching = BruteForce(typeMask, container, [&](FakeObject const& object) { return InCone(object, x, y, radius, orientation, arc, 0.0001f); });
+            EXPECT_TRUE(std::includes(cone.begin(), cone.end(), inside.begin(), inside.end()));
+            EXPECT_TRUE(std::includes(touching.begin(), touching.end(), cone.begin(), cone.end()));
+        }
+
+        Shuffle();
+    }
+}
@@ -0,0 +1,141 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "LootAliasTable.h"
+#include "gtest/gtest.h"
+#include <random>
+#include <vector>
+
+namespace
+{
+    constexpr uint32 SAMPLES = 400000;
+
+    // Cumulative roll of LootTemplate::LootGroup::Roll over the entries that can drop
+    int32 CumulativeRoll(std::vector<float> const& chances, std::vector<bool> const& canDrop, float roll)
+    {
+        for (std::size_t i = 0; i < chances.size(); ++i)
+        {
+            if (!canDrop[i])
+                continue;
+
+            if (chances[i] >= 100.0f)
+                return int32(i);
+
+            roll -= chances[i];
+            if (roll < 0)
+                return int32(i);
+        }
+
+        return LootAliasTable::NO_ENTRY;
+    }
+
+    // Counts of every outcome, the last slot counts empty picks
+    std::vector<uint32> SampleCumulative(std::vector<float> const& chances, std::vector<bool> const& canDrop, std::mt19937& rng)
+    {
+        std::uniform_real_distribution<double> chance(0.0, 100.0);
+        std::vector<uint32> counts(chances.size() + 1, 0);
+        for (uint32 i = 0; i < SAMPLES; ++i)
+        {
+            int32 const index = CumulativeRoll(chances, canDrop, float(chance(rng)));
+            ++counts[index == LootAliasTable::NO_ENTRY ? chances.size() : std::size_t(index)];
+        }
+
+        return counts;
+    }
+
+    std::vector<uint32> SampleAlias(LootAliasTable const& table, std::size_t entries, std::vector<bool> const& canDrop, std::mt19937& rng)
+    {
+        std::uniform_int_distribution<uint32> column(0, table.GetColumnCount() - 1);
+        std::uniform_real_distribution<double> coin(0.0, 1.0);
+        std::vector<uint32> counts(entries + 1, 0);
+        for (uint32 i = 0; i < SAMPLES; ++i)
+        {
+            int32 const index = table.Roll(column(rng), coin(rng));
+            bool const dropped = index != LootAliasTable::NO_ENTRY && canDrop[index];
+            ++counts[dropped ? std::size_t(index) : entries];
+        }
+
+        return counts;
+    }
+
+    // Pearson statistic of two samples of the same size against each other
+    double ChiSquare(std::vector<uint32> const& lhs, std::vector<uint32> const& rhs)
+    {
+        double statistic = 0.0;
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+        {
+            double const total = double(lhs[i]) + double(rhs[i]);
+            if (total > 0.0)
+                statistic += (double(lhs[i]) - double(rhs[i])) * (double(lhs[i]) - double(rhs[i])) / total;
+        }
+
+        return statistic;
+    }
+
+    void ExpectSameDistribution(std::vector<float> const& chances, std::vector<bool> const& canDrop)
+    {
+        LootAliasTable table;
+        ASSERT_TRUE(table.Build(chances));
+
+        std::mt19937 rng(20240901);
+        std::vector<uint32> const cumulative = SampleCumulative(chances, canDrop, rng);
+        std::vector<uint32> const alias = SampleAlias(table, chances.size(), canDrop, rng);
+
+        // 99.9999% quantile of chi-square with up to 12 degrees of freedom is below 55
+        EXPECT_LT(ChiSquare(cumulative, alias), 55.0);
+
+        // and every outcome matches its nominal chance
+        for (std::size_t i = 0; i < chances.size(); ++i)
+        {
+            double const expected = canDrop[i] ? chances[i] / 100.0 : 0.0;
+            EXPECT_NEAR(double(alias[i]) / SAMPLES, expected, 0.004) << "entry " << i;
+        }
+    }
+}
+
+TEST(LootAliasTableTest, MatchesCumulativeRoll)
+{
+    ExpectSameDistribution({ 50.0f, 25.0f, 12.5f, 12.5f }, { true, true, true, true });
+    ExpectSameDistribution({ 1.0f, 2.0f, 3.0f, 4.0f, 5.0f }, { true, true, true, true, true });
+    ExpectSameDistribution({ 0.5f, 33.3f, 0.1f, 60.0f }, { true, true, true, true });
+    ExpectSameDistribution({ 100.0f }, { true });
+}
+
+TEST(LootAliasTableTest, MatchesCumulativeRollWithFilteredEntries)
+{
+    ExpectSameDistribution({ 20.0f, 30.0f, 10.0f, 40.0f }, { true, false, true, true });
+    ExpectSameDistribution({ 5.0f, 5.0f, 5.0f, 5.0f, 5.0f, 5.0f, 5.0f, 5.0f, 5.0f, 5.0f }, { false, true, false, true, true, false, true, true, false, true });
+    ExpectSameDistribution({ 100.0f }, { false });
+}
+
+TEST(LootAliasTableTest, RejectsOverfullGroups)
+{
+    LootAliasTable table;
+    EXPECT_FALSE(table.Build({ 60.0f, 50.0f }));
+    EXPECT_FALSE(table.Build({}));
+    EXPECT_TRUE(table.IsEmpty());
+}
+
+TEST(LootAliasTableTest, ColumnsCoverEntriesAndMiss)
+{
+    LootAliasTable table;
+    ASSERT_TRUE(table.Build({ 10.0f, 20.0f }));
+    EXPECT_EQ(table.GetColumnCount(), 3u);
+
+    ASSERT_TRUE(table.Build({ 40.0f, 60.0f }));
+    EXPECT_EQ(table.GetColumnCount(), 2u);
+}
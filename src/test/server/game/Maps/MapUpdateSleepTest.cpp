@@ -0,0 +1,124 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Object.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+    constexpr uint32 MAP_DIFF = 100;
+
+    // Stand in for a TEMPSUMMON_TIMED_DESPAWN summon: counts its lifetime down by the diff of its updates,
+    // like TempSummon::Update
+    class TimedSummon : public UpdatableMapObject
+    {
+    public:
+        explicit TimedSummon(uint32 lifetime) : _timer(lifetime) { }
+
+        void Update(uint32 diff)
+        {
+            if (_timer <= diff)
+                _despawned = true;
+            else
+                _timer -= diff;
+        }
+
+        // what Map::UpdateNonPlayerObjects does for a creature
+        void MapUpdate(Milliseconds now) { Update(TakeMapUpdateDiff(MAP_DIFF, now)); }
+        void Sleep(Milliseconds now) { SetMapSleepStart(now); }
+        void RemoveFromMap() { SetMapSleepStart(0ms); }
+
+        bool IsDespawned() const { return _despawned; }
+
+    private:
+        uint32 _timer;
+        bool _despawned = false;
+    };
+}
+
+TEST(MapUpdateSleepTest, TimedSummonDespawnsOnTimeWithoutSleeping)
+{
+    TimedSummon summon(1000);
+    Milliseconds now = 1000ms;
+    for (uint32 i = 0; i < 9; ++i, now += Milliseconds(MAP_DIFF))
+        summon.MapUpdate(now);
+
+    EXPECT_FALSE(summon.IsDespawned());
+    summon.MapUpdate(now);
+    EXPECT_TRUE(summon.IsDespawned());
+}
+
+TEST(MapUpdateSleepTest, TimedSummonDespawnsOnTimeAfterSleeping)
+{
+    TimedSummon summon(1000);
+    Milliseconds now = 1000ms;
+    summon.MapUpdate(now);
+
+    // sleeps 800ms, then the first update after waking gets the whole slept time instead of a single map diff
+    summon.Sleep(now);
+    now += 800ms;
+    summon.MapUpdate(now);
+    EXPECT_FALSE(summon.IsDespawned());
+
+    now += Milliseconds(MAP_DIFF);
+    summon.MapUpdate(now);
+    EXPECT_TRUE(summon.IsDespawned());
+}
+
+TEST(MapUpdateSleepTest, SleepTimeIsCountedOnce)
+{
+    TimedSummon summon(1000);
+    Milliseconds now = 1000ms;
+    summon.Sleep(now);
+    now += 500ms;
+    summon.MapUpdate(now);
+
+    // later updates are back to the map diff
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        now += Milliseconds(MAP_DIFF);
+        summon.MapUpdate(now);
+    }
+
+    EXPECT_FALSE(summon.IsDespawned());
+    now += Milliseconds(MAP_DIFF);
+    summon.MapUpdate(now);
+    EXPECT_TRUE(summon.IsDespawned());
+}
+
+TEST(MapUpdateSleepTest, RemovalForgetsSleepTime)
+{
+    TimedSummon summon(1000);
+    summon.Sleep(1000ms);
+    summon.RemoveFromMap();
+
+    // added back to a map much later, it does not get the time it spent off the map
+    summon.MapUpdate(60000ms);
+    EXPECT_FALSE(summon.IsDespawned());
+}
+
+TEST(MapUpdateSleepTest, ShortSleepKeepsMapDiff)
+{
+    TimedSummon summon(150);
+    summon.Sleep(1000ms);
+
+    // woken before a full map diff passed, the update still gets the map diff
+    summon.MapUpdate(1050ms);
+    EXPECT_FALSE(summon.IsDespawned());
+    summon.MapUpdate(1150ms);
+    EXPECT_TRUE(summon.IsDespawned());
+}
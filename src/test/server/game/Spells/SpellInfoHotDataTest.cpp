@@ -0,0 +1,219 @@
+/*
+ * This file is part of the AzerothCore Project. See AUTHORS file for Copyright information
+ *
+ * This program is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Affero General Public License as published by the
+ * Free Software Foundation; either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Affero General Public License for
+ * more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DBCStructure.h"
+#include "SharedDefines.h"
+#include "Spell.h"
+#include "SpellDefines.h"
+#include "SpellInfo.h"
+#include "gtest/gtest.h"
+#include <memory>
+
+namespace
+{
+    // Unit::GetSpellMaxRangeForTarget and GetSpellMinRangeForTarget on the full spell info
+    float GetSpellMaxRange(SpellInfo const& spellInfo, bool friendly)
+    {
+        if (!spellInfo.RangeEntry)
+            return 0.0f;
+        if (spellInfo.RangeEntry->RangeMax[0] == spellInfo.RangeEntry->RangeMax[1])
+            return spellInfo.GetMaxRange();
+        return spellInfo.GetMaxRange(friendly);
+    }
+
+    float GetSpellMinRange(SpellInfo const& spellInfo, bool friendly)
+    {
+        if (!spellInfo.RangeEntry)
+            return 0.0f;
+        if (spellInfo.RangeEntry->RangeMin[0] == spellInfo.RangeEntry->RangeMin[1])
+            return spellInfo.GetMinRange();
+        return spellInfo.GetMinRange(friendly);
+    }
+
+    class SpellInfoHotDataTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            _spellEntry = {};
+            _spellEntry.Id = 133;
+            _spellEntry.Attributes = SPELL_ATTR0_PASSIVE;
+            _spellEntry.AttributesEx = 0x11;
+            _spellEntry.AttributesEx2 = SPELL_ATTR2_IGNORE_LINE_OF_SIGHT;
+            _spellEntry.AttributesEx3 = 0x33;
+            _spellEntry.AttributesEx4 = 0x44;
+            _spellEntry.AttributesEx5 = 0x55;
+            _spellEntry.AttributesEx6 = 0x66;
+            _spellEntry.AttributesEx7 = SPELL_ATTR7_DEBUG_SPELL;
+            _spellEntry.Stances = 0x100;
+            _spellEntry.StancesNot = 0x200;
+            _spellEntry.Targets = 0x2;
+            _spellEntry.TargetCreatureType = 0x20;
+            _spellEntry.FacingCasterFlags = 1;
+            _spellEntry.CasterAuraState = 2;
+            _spellEntry.TargetAuraState = 3;
+            _spellEntry.CasterAuraStateNot = 4;
+            _spellEntry.TargetAuraStateNot = 5;
+            _spellEntry.InterruptFlags = SPELL_INTERRUPT_FLAG_MOVEMENT;
+            _spellEntry.PowerType = POWER_RAGE;
+            _spellEntry.RuneCostID = 7;
+            _spellEntry.DmgClass = SPELL_DAMAGE_CLASS_MAGIC;
+
+            // different values everywhere, so reading the wrong side or bound shows up
+            _range.ID = 5;
+            _range.RangeMin[0] = 5.0f;
+            _range.RangeMin[1] = 8.0f;
+            _range.RangeMax[0] = 30.0f;
+            _range.RangeMax[1] = 40.0f;
+            _range.Flags = SPELL_RANGE_RANGED;
+
+            _castTime.ID = 4;
+            _castTime.CastTime = 2500;
+        }
+
+        // the entry stores are not loaded here, the spell info gets its entries set directly
+        std::unique_ptr<SpellInfo> MakeSpellInfo(SpellRangeEntry const* range, SpellCastTimesEntry const* castTime) const
+        {
+            auto spellInfo = std::make_unique<SpellInfo>(&_spellEntry);
+            spellInfo->RangeEntry = range;
+            spellInfo->CastTimeEntry = castTime;
+            spellInfo->AttributesCu = SPELL_ATTR0_CU_PICKPOCKET;
+            spellInfo->ExplicitTargetMask = TARGET_FLAG_UNIT_ENEMY;
+            return spellInfo;
+        }
+
+        SpellEntry _spellEntry;
+        SpellRangeEntry _range;
+        SpellCastTimesEntry _castTime;
+    };
+}
+
+TEST(SpellInfoHotDataLayoutTest, FillsTwoCacheLines)
+{
+    EXPECT_EQ(sizeof(SpellInfoHotData), 128u);
+    EXPECT_EQ(alignof(SpellInfoHotData), 64u);
+
+    std::vector<SpellInfoHotData> table(3);
+    for (SpellInfoHotData const& hotData : table)
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&hotData) % 64, 0u);
+}
+
+TEST(SpellInfoHotDataLayoutTest, AttributesMatchSpellInfo)
+{
+    SpellInfoHotData hotData;
+    EXPECT_FALSE(hotData.HasAttribute(SPELL_ATTR0_PASSIVE));
+
+    hotData.Attributes[0] = SPELL_ATTR0_PASSIVE;
+    hotData.Attributes[2] = SPELL_ATTR2_IGNORE_LINE_OF_SIGHT;
+    hotData.Attributes[7] = SPELL_ATTR7_DEBUG_SPELL;
+    hotData.AttributesCu = SPELL_ATTR0_CU_PICKPOCKET;
+
+    EXPECT_TRUE(hotData.HasAttribute(SPELL_ATTR0_PASSIVE));
+    EXPECT_TRUE(hotData.HasAttribute(SPELL_ATTR2_IGNORE_LINE_OF_SIGHT));
+    EXPECT_TRUE(hotData.HasAttribute(SPELL_ATTR7_DEBUG_SPELL));
+    EXPECT_TRUE(hotData.HasAttribute(SPELL_ATTR0_CU_PICKPOCKET));
+    EXPECT_FALSE(hotData.HasAttribute(SPELL_ATTR1_DISMISS_PET_FIRST));
+    EXPECT_FALSE(hotData.HasAttribute(SPELL_ATTR0_CU_ENCOUNTER_REWARD));
+}
+
+TEST_F(SpellInfoHotDataTest, BuildCopiesSpellInfo)
+{
+    std::unique_ptr<SpellInfo> spellInfo = MakeSpellInfo(&_range, &_castTime);
+
+    SpellInfoHotData hotData;
+    BuildSpellInfoHotData(*spellInfo, hotData);
+
+    std::array<uint32, 8> const attributes = { spellInfo->Attributes, spellInfo->AttributesEx, spellInfo->AttributesEx2, spellInfo->AttributesEx3,
+        spellInfo->AttributesEx4, spellInfo->AttributesEx5, spellInfo->AttributesEx6, spellInfo->AttributesEx7 };
+    EXPECT_EQ(hotData.Attributes, attributes);
+    EXPECT_EQ(hotData.AttributesCu, spellInfo->AttributesCu);
+    EXPECT_EQ(hotData.Targets, spellInfo->Targets);
+    EXPECT_EQ(hotData.TargetCreatureType, spellInfo->TargetCreatureType);
+    EXPECT_EQ(hotData.ExplicitTargetMask, spellInfo->ExplicitTargetMask);
+    EXPECT_EQ(hotData.Stances, spellInfo->Stances);
+    EXPECT_EQ(hotData.StancesNot, spellInfo->StancesNot);
+    EXPECT_EQ(hotData.InterruptFlags, spellInfo->InterruptFlags);
+    EXPECT_EQ(hotData.FacingCasterFlags, spellInfo->FacingCasterFlags);
+    EXPECT_EQ(hotData.CasterAuraState, spellInfo->CasterAuraState);
+    EXPECT_EQ(hotData.CasterAuraStateNot, spellInfo->CasterAuraStateNot);
+    EXPECT_EQ(hotData.TargetAuraState, spellInfo->TargetAuraState);
+    EXPECT_EQ(hotData.TargetAuraStateNot, spellInfo->TargetAuraStateNot);
+    EXPECT_EQ(hotData.PowerType, spellInfo->PowerType);
+    EXPECT_EQ(hotData.RuneCostID, spellInfo->RuneCostID);
+    EXPECT_EQ(hotData.DmgClass, spellInfo->DmgClass);
+    EXPECT_EQ(hotData.CastTime, _castTime.CastTime);
+    EXPECT_EQ(hotData.RangeId, _range.ID);
+    EXPECT_EQ(hotData.RangeFlags, _range.Flags);
+
+    EXPECT_TRUE(hotData.HasAttribute(SPELL_ATTR0_PASSIVE));
+    EXPECT_TRUE(hotData.HasAttribute(SPELL_ATTR7_DEBUG_SPELL));
+    EXPECT_TRUE(hotData.HasAttribute(SPELL_ATTR0_CU_PICKPOCKET));
+}
+
+TEST_F(SpellInfoHotDataTest, BuildWithoutEntries)
+{
+    std::unique_ptr<SpellInfo> spellInfo = MakeSpellInfo(&_range, &_castTime);
+
+    SpellInfoHotData hotData;
+    BuildSpellInfoHotData(*spellInfo, hotData);
+
+    // a rebuild after the entries are gone must not keep the old values
+    spellInfo->RangeEntry = nullptr;
+    spellInfo->CastTimeEntry = nullptr;
+    BuildSpellInfoHotData(*spellInfo, hotData);
+
+    EXPECT_EQ(hotData.CastTime, 0);
+    EXPECT_EQ(hotData.RangeId, 0u);
+    EXPECT_EQ(hotData.RangeFlags, 0u);
+    for (bool friendly : { false, true })
+    {
+        EXPECT_EQ(hotData.GetMaxRange([friendly]() { return friendly; }), GetSpellMaxRange(*spellInfo, friendly));
+        EXPECT_EQ(hotData.GetMinRange([friendly]() { return friendly; }), GetSpellMinRange(*spellInfo, friendly));
+    }
+}
+
+TEST_F(SpellInfoHotDataTest, RangesMatchSpellInfo)
+{
+    SpellRangeEntry sameMax = _range;
+    sameMax.RangeMax[1] = sameMax.RangeMax[0];
+    SpellRangeEntry sameMin = _range;
+    sameMin.RangeMin[1] = sameMin.RangeMin[0];
+    SpellRangeEntry same = sameMax;
+    same.RangeMin[1] = same.RangeMin[0];
+
+    for (SpellRangeEntry const* range : { &_range, &sameMax, &sameMin, &same })
+    {
+        std::unique_ptr<SpellInfo> spellInfo = MakeSpellInfo(range, nullptr);
+
+        SpellInfoHotData hotData;
+        BuildSpellInfoHotData(*spellInfo, hotData);
+
+        for (bool friendly : { false, true })
+        {
+            EXPECT_EQ(hotData.GetMaxRange([friendly]() { return friendly; }), GetSpellMaxRange(*spellInfo, friendly));
+            EXPECT_EQ(hotData.GetMinRange([friendly]() { return friendly; }), GetSpellMinRange(*spellInfo, friendly));
+        }
+
+        // the hostility check of Spell::CheckRange is skipped when both sides have the same range
+        bool checkedMax = false;
+        bool checkedMin = false;
+        hotData.GetMaxRange([&checkedMax]() { checkedMax = true; return true; });
+        hotData.GetMinRange([&checkedMin]() { checkedMin = true; return true; });
+        EXPECT_EQ(checkedMax, range->RangeMax[0] != range->RangeMax[1]);
+        EXPECT_EQ(checkedMin, range->RangeMin[0] != range->RangeMin[1]);
+    }
+}